@@ -0,0 +1,904 @@
+#include "textwolf.hpp"
+#include "textwolf/istreamiterator.hpp"
+#include "textwolf/mmapfileiterator.hpp"
+#include "textwolf/readaheadstream.hpp"
+#include "textwolf/gzipinputstream.hpp"
+#include "corpus.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <map>
+#include <new>
+#include <ctime>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+//build gcc
+//compile: g++ -c -o benchmark.o -g -I../include/ -pedantic -Wall -O4 benchmark.cpp
+//link: g++ -lc -o benchmark benchmark.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"benchmark.obj" benchmark.cpp
+//link: link.exe /out:.\benchmark benchmark.obj
+
+// Measures the throughput of the XMLScanner for different charset pairs, of the
+// XMLPathSelect with 1, 100 and 10000 expressions and of the XMLPrinter on
+// synthetic documents generated deterministically (see corpus.hpp).
+//
+// usage: benchmark [-s <size>] [-t <seconds>] [-f <filter>] [-b <baseline>] [-r <percent>]
+//	-s	size of the documents generated in bytes (default 4000000)
+//	-t	minimum time of each measurement in seconds (default 0.5)
+//	-f	run only the benchmarks with a name containing the filter
+//	-b	compare with the results of a previous run stored in a file
+//	-r	tolerated slowdown compared with the baseline in percent (default 10)
+//
+// Every result is printed as one line with tab separated columns:
+//	<name> <MB/s> <events/s> <allocations/MB>
+// lines starting with '#' are comments. The output can be stored as baseline for
+// later runs. With a baseline the ratio to the baseline MB/s is printed as fifth
+// column and the program exits with 1, if a benchmark is slower than tolerated.
+
+using namespace textwolf;
+
+static std::size_t g_nofAllocations = 0;
+
+#if __cplusplus >= 201103L
+#define BENCH_THROW_BAD_ALLOC
+#define BENCH_NOTHROW noexcept
+#else
+#define BENCH_THROW_BAD_ALLOC throw(std::bad_alloc)
+#define BENCH_NOTHROW throw()
+#endif
+#if defined(__GNUC__)
+// ... not inlined, so that gcc does not mistake the malloc/free pairs for mismatched new/free
+#define BENCH_NOINLINE __attribute__((noinline))
+#else
+#define BENCH_NOINLINE
+#endif
+
+BENCH_NOINLINE void* operator new( std::size_t size) BENCH_THROW_BAD_ALLOC
+{
+	++g_nofAllocations;
+	void* rt = std::malloc( size?size:1);
+	if (!rt) throw std::bad_alloc();
+	return rt;
+}
+
+BENCH_NOINLINE void operator delete( void* ptr) BENCH_NOTHROW
+{
+	std::free( ptr);
+}
+
+/// \class Result
+/// \brief Result of one benchmark
+struct Result
+{
+	double mbPerSec;		///< throughput in MB/s of the input document
+	double eventsPerSec;		///< XML elements processed per second
+	double allocsPerMB;		///< heap allocations per MB of the input document
+
+	Result() :mbPerSec(0),eventsPerSec(0),allocsPerMB(0){}
+};
+
+/// \class Benchmark
+/// \brief Interface of one benchmark
+struct Benchmark
+{
+	virtual ~Benchmark(){}
+	/// \brief Run the measured operation once
+	/// \return the number of XML elements processed
+	virtual std::size_t run()=0;
+	/// \brief Get the size of the input processed by one run in bytes
+	virtual std::size_t size() const=0;
+};
+
+static Result measure( Benchmark& bm, double minTime)
+{
+	Result rt;
+	std::size_t allocs0 = g_nofAllocations;
+	std::clock_t start = std::clock();
+	std::size_t nofEvents = bm.run();
+	std::size_t nofRuns = 1;
+	double elapsed = (double)(std::clock() - start) / CLOCKS_PER_SEC;
+	if (elapsed < minTime)
+	{
+		// ... the first run was a warm up, measure again
+		allocs0 = g_nofAllocations;
+		start = std::clock();
+		nofEvents = 0;
+		nofRuns = 0;
+		do
+		{
+			nofEvents += bm.run();
+			++nofRuns;
+			elapsed = (double)(std::clock() - start) / CLOCKS_PER_SEC;
+		}
+		while (elapsed < minTime);
+	}
+	double mb = (double)bm.size() * nofRuns / 1e6;
+	if (elapsed <= 0.0) elapsed = 1e-9;
+	rt.mbPerSec = mb / elapsed;
+	rt.eventsPerSec = nofEvents / elapsed;
+	rt.allocsPerMB = (g_nofAllocations - allocs0) / mb;
+	return rt;
+}
+
+/// \class ScanBenchmark
+/// \brief Scanning a document with XMLScanner
+template <class InputCharSet, class OutputCharSet, class InputReader=TextScanner<CStringIterator,InputCharSet> >
+class ScanBenchmark :public Benchmark
+{
+public:
+	ScanBenchmark( const std::string& doc_, bool zeroCopy_, bool strictUTF8_=false)
+		:m_doc(doc_),m_zeroCopy(zeroCopy_),m_strictUTF8(strictUTF8_){}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<CStringIterator,InputCharSet,OutputCharSet,std::string,XMLScannerNoInstrumentation,InputReader> Scanner;
+		Scanner scanner( CStringIterator( m_doc.c_str(), m_doc.size()));
+		scanner.setZeroCopy( m_zeroCopy);
+		if (m_strictUTF8) scanner.setStrictUTF8();
+		std::size_t rt = 0;
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size();
+	}
+
+private:
+	const std::string& m_doc;
+	bool m_zeroCopy;
+	bool m_strictUTF8;
+};
+
+/// \class IteratorScanBenchmark
+/// \brief Scanning a document with the iterator of XMLScanner in zero copy mode
+class IteratorScanBenchmark :public Benchmark
+{
+public:
+	explicit IteratorScanBenchmark( const std::string& doc_)
+		:m_doc(doc_){}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<CStringIterator,charset::UTF8,charset::UTF8,std::string> Scanner;
+		Scanner scanner( CStringIterator( m_doc.c_str(), m_doc.size()));
+		scanner.setZeroCopy();
+		std::size_t rt = 0;
+		Scanner::iterator itr = scanner.begin(), end = scanner.end();
+		for (; itr != end; ++itr)
+		{
+			++rt;
+			if (itr->type() == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + itr->content());
+		}
+		return rt + 1;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size();
+	}
+
+private:
+	const std::string& m_doc;
+};
+
+/// \class BatchScanBenchmark
+/// \brief Scanning a document in batches with XMLScanner::nextItems in zero copy mode
+class BatchScanBenchmark :public Benchmark
+{
+public:
+	BatchScanBenchmark( const std::string& doc_, std::size_t batchSize_)
+		:m_doc(doc_),m_batchSize(batchSize_){}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<CStringIterator,charset::UTF8,charset::UTF8,std::string> Scanner;
+		Scanner scanner( CStringIterator( m_doc.c_str(), m_doc.size()));
+		scanner.setZeroCopy();
+		std::size_t rt = 0;
+		do
+		{
+			rt += scanner.nextItems( m_events, m_batchSize);
+			if (m_events.lastType() == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + std::string( m_events.content( m_events.size()-1), m_events.contentSize( m_events.size()-1)));
+		}
+		while (m_events.lastType() != XMLScannerBase::Exit);
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size();
+	}
+
+private:
+	const std::string& m_doc;
+	std::size_t m_batchSize;
+	EventBuffer m_events;
+};
+
+/// \class StructuralScanBenchmark
+/// \brief Scanning a document with XMLStructuralScanner
+class StructuralScanBenchmark :public Benchmark
+{
+public:
+	explicit StructuralScanBenchmark( const std::string& doc_)
+		:m_doc(doc_){}
+
+	virtual std::size_t run()
+	{
+		XMLStructuralScanner<std::string> scanner( m_doc.c_str(), m_doc.size());
+		std::size_t rt = 0;
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size();
+	}
+
+private:
+	const std::string& m_doc;
+};
+
+/// \class PaddedScanBenchmark
+/// \brief Scanning a document followed by a padding of null bytes with XMLScanner on a PaddedBufferIterator
+template <class InputCharSet, class OutputCharSet>
+class PaddedScanBenchmark :public Benchmark
+{
+public:
+	PaddedScanBenchmark( const std::string& doc_, bool zeroCopy_)
+		:m_doc(doc_),m_zeroCopy(zeroCopy_)
+	{
+		PaddedBufferIterator::appendPadding( m_doc);
+	}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<PaddedBufferIterator,InputCharSet,OutputCharSet,std::string> Scanner;
+		Scanner scanner( PaddedBufferIterator( m_doc.c_str(), size()));
+		scanner.setZeroCopy( m_zeroCopy);
+		std::size_t rt = 0;
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size() - PaddedBufferIterator::PaddingSize;
+	}
+
+private:
+	std::string m_doc;
+	bool m_zeroCopy;
+};
+
+/// \class PushScanBenchmark
+/// \brief Scanning a document fed chunk by chunk in push mode with XMLScanner on a SrcIterator or a PaddedSrcIterator
+template <class Iterator, class InputCharSet, class OutputCharSet>
+class PushScanBenchmark :public Benchmark
+{
+public:
+	PushScanBenchmark( const std::string& doc_, std::size_t chunksize_)
+		:m_size(doc_.size())
+	{
+		enum {PaddingSize=traits::ChunkSource<Iterator>::PaddingSize};
+		for (std::size_t pos=0; pos < doc_.size(); pos += chunksize_)
+		{
+			std::string chunk( doc_, pos, chunksize_);
+			chunk.append( (std::size_t)PaddingSize, '\0');
+			m_chunks.push_back( chunk);
+		}
+	}
+
+	virtual std::size_t run()
+	{
+		enum {PaddingSize=traits::ChunkSource<Iterator>::PaddingSize};
+		typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+		Scanner scanner;
+		std::size_t ci = 0;
+		std::size_t rt = 0;
+		scanner.putInput( m_chunks[ ci].c_str(), m_chunks[ ci].size() - PaddingSize, ci+1 == m_chunks.size());
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			if (type == XMLScannerBase::NeedMoreInput)
+			{
+				++ci;
+				scanner.putInput( m_chunks[ ci].c_str(), m_chunks[ ci].size() - PaddingSize, ci+1 == m_chunks.size());
+				continue;
+			}
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_size;
+	}
+
+private:
+	std::vector<std::string> m_chunks;
+	std::size_t m_size;
+};
+
+/// \class IStreamScanBenchmark
+/// \brief Scanning a document read from an input stream with XMLScanner on an IStreamIterator, optionally copying the scanner for every element as for a lookahead
+template <class InputCharSet, class OutputCharSet>
+class IStreamScanBenchmark :public Benchmark
+{
+public:
+	IStreamScanBenchmark( const std::string& doc_, bool copyScanner_)
+		:m_doc(doc_),m_copyScanner(copyScanner_){}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<IStreamIterator,InputCharSet,OutputCharSet,std::string> Scanner;
+		std::istringstream input( m_doc);
+		StdInputStream stream( input);
+		Scanner scanner( (IStreamIterator( &stream)));
+		std::size_t rt = 0;
+		for (;;)
+		{
+			if (m_copyScanner)
+			{
+				Scanner lookahead( scanner);
+			}
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size();
+	}
+
+private:
+	const std::string& m_doc;
+	bool m_copyScanner;
+};
+
+/// \class IStreamCopyBenchmark
+/// \brief Reading a document from an input stream with a TextScanner on an IStreamIterator, copying the TextScanner at every '<' for a lookahead of one character
+/// \remark Measures the copying of the iterator alone, without the copying of the XMLScanner state and output buffer as in IStreamScanBenchmark. The events counted are the copies
+class IStreamCopyBenchmark :public Benchmark
+{
+public:
+	explicit IStreamCopyBenchmark( const std::string& doc_)
+		:m_doc(doc_){}
+
+	virtual std::size_t run()
+	{
+		typedef TextScanner<IStreamIterator,charset::UTF8> Scanner;
+		std::istringstream input( m_doc);
+		StdInputStream stream( input);
+		Scanner scanner( (IStreamIterator( &stream)));
+		std::size_t rt = 0;
+		for (; *scanner; ++scanner)
+		{
+			if (*scanner == '<')
+			{
+				Scanner lookahead( scanner);
+				++lookahead;
+				if (*lookahead) ++rt;
+			}
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size();
+	}
+
+private:
+	const std::string& m_doc;
+};
+
+#if defined(TEXTWOLF_WITH_ZLIB)
+/// \class GzipScanBenchmark
+/// \brief Scanning a gzip compressed document inflated on the fly with XMLScanner on an IStreamIterator reading from a GzipInputStream
+template <class InputCharSet, class OutputCharSet>
+class GzipScanBenchmark :public Benchmark
+{
+public:
+	explicit GzipScanBenchmark( const std::string& doc_)
+		:m_size(doc_.size())
+	{
+		z_stream zs;
+		std::memset( &zs, 0, sizeof(zs));
+		if (deflateInit2( &zs, Z_DEFAULT_COMPRESSION, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK) throw std::runtime_error( "deflateInit2 failed");
+		std::vector<char> buf( deflateBound( &zs, (uLong)doc_.size()) + 64);
+		zs.next_in = (Bytef*)const_cast<char*>( doc_.c_str());
+		zs.avail_in = (uInt)doc_.size();
+		zs.next_out = (Bytef*)&buf[0];
+		zs.avail_out = (uInt)buf.size();
+		int rc = deflate( &zs, Z_FINISH);
+		deflateEnd( &zs);
+		if (rc != Z_STREAM_END) throw std::runtime_error( "deflate failed");
+		m_compressed.assign( &buf[0], buf.size() - zs.avail_out);
+	}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<IStreamIterator,InputCharSet,OutputCharSet,std::string> Scanner;
+		std::istringstream input( m_compressed);
+		StdInputStream source( input);
+		GzipInputStream stream( &source);
+		Scanner scanner( (IStreamIterator( &stream, 65536)));
+		std::size_t rt = 0;
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_size;
+	}
+
+private:
+	std::string m_compressed;
+	std::size_t m_size;
+};
+#endif
+
+/// \class ReadAheadScanBenchmark
+/// \brief Scanning a document read from an input stream in a background thread with XMLScanner on a ReadAheadIterator
+template <class InputCharSet, class OutputCharSet>
+class ReadAheadScanBenchmark :public Benchmark
+{
+public:
+	explicit ReadAheadScanBenchmark( const std::string& doc_)
+		:m_doc(doc_){}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<ReadAheadIterator,InputCharSet,OutputCharSet,std::string> Scanner;
+		std::istringstream input( m_doc);
+		StdInputStream source( input);
+		ReadAheadStream stream( &source, 65536);
+		Scanner scanner( (ReadAheadIterator( &stream)));
+		std::size_t rt = 0;
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size();
+	}
+
+private:
+	const std::string& m_doc;
+};
+
+/// \class MmapScanBenchmark
+/// \brief Scanning a document written to a file and mapped into memory with XMLScanner on a MmapFileIterator
+template <class InputCharSet, class OutputCharSet>
+class MmapScanBenchmark :public Benchmark
+{
+public:
+	explicit MmapScanBenchmark( const std::string& doc_)
+		:m_size(doc_.size())
+	{
+		std::ofstream out( fileName(), std::ios::out | std::ios::binary | std::ios::trunc);
+		out.write( doc_.c_str(), doc_.size());
+		if (!out) throw std::runtime_error( "failed to write benchmark file");
+	}
+
+	virtual ~MmapScanBenchmark()
+	{
+		std::remove( fileName());
+	}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<MmapFileIterator,InputCharSet,OutputCharSet,std::string> Scanner;
+		MmapFile file( fileName());
+		Scanner scanner( (MmapFileIterator( file)));
+		std::size_t rt = 0;
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_size;
+	}
+
+private:
+	static const char* fileName()	{return "benchmark_mmap.tmp";}
+	std::size_t m_size;
+};
+
+/// \class SelectBenchmark
+/// \brief Scanning a document with XMLScanner and selecting elements with XMLPathSelect
+class SelectBenchmark :public Benchmark
+{
+public:
+	typedef XMLPathSelectAutomaton<charset::UTF8> Automaton;
+
+	SelectBenchmark( const std::string& doc_, unsigned int nofExpressions)
+		:m_doc(doc_),m_nofSelected(0)
+	{
+		for (unsigned int ii=0; ii<nofExpressions; ++ii)
+		{
+			std::ostringstream name;
+			name << "e" << (ii % bench::Corpus::NofElementNames);
+			(*m_atm)--[ name.str().c_str()]("id") = ii+1;
+		}
+	}
+
+	virtual std::size_t run()
+	{
+		typedef XMLScanner<CStringIterator,charset::UTF8,charset::UTF8,std::string> Scanner;
+		typedef XMLPathSelect<charset::UTF8> Selector;
+		Scanner scanner( CStringIterator( m_doc.c_str(), m_doc.size()));
+		scanner.setZeroCopy();
+		Selector selector( &m_atm);
+		std::size_t rt = 0;
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			++rt;
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+			Selector::iterator itr = selector.push( type, scanner.getItemPtr(), scanner.getItemSize()), end = selector.end();
+			for (; itr != end; ++itr) ++m_nofSelected;
+		}
+		return rt;
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_doc.size();
+	}
+
+private:
+	const std::string& m_doc;
+	Automaton m_atm;
+	std::size_t m_nofSelected;
+};
+
+/// \class PrintBenchmark
+/// \brief Printing the elements of a document with XMLPrinter
+/// \tparam IOCharset character set encoding of the output
+template <class IOCharset=charset::UTF8>
+class PrintBenchmark :public Benchmark
+{
+public:
+	/// \param [in] doc_ document to print encoded as UTF-8
+	/// \param [in] output_ character set encoding instance of the output (with the code page)
+	/// \param [in] encoding_ name of the encoding of the output in the XML header
+	explicit PrintBenchmark( const std::string& doc_, const IOCharset& output_=IOCharset(), const char* encoding_="UTF-8")
+		:m_size(doc_.size()),m_output(output_),m_encoding(encoding_)
+	{
+		typedef XMLScanner<CStringIterator,charset::UTF8,charset::UTF8,std::string> Scanner;
+		Scanner scanner( CStringIterator( doc_.c_str(), doc_.size()));
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			if (type == XMLScannerBase::Exit) break;
+			if (type == XMLScannerBase::ErrorOccurred) throw std::runtime_error( std::string( "xml error: ") + scanner.getItemPtr());
+			m_events.push( type, scanner.getItemPtr(), scanner.getItemSize());
+		}
+	}
+
+	virtual std::size_t run()
+	{
+		typedef XMLPrinter<IOCharset,charset::UTF8,std::string> Printer;
+		Printer printer( m_output);
+		std::string out;
+		printer.printHeader( m_encoding, 0, out);
+		for (std::size_t ii=0; ii<m_events.size(); ++ii)
+		{
+			const char* content = m_events.content( ii);
+			std::size_t contentsize = m_events.contentSize( ii);
+			switch (m_events.type( ii))
+			{
+				case XMLScannerBase::OpenTag: printer.printOpenTag( content, contentsize, out); break;
+				case XMLScannerBase::TagAttribName: printer.printAttribute( content, contentsize, out); break;
+				case XMLScannerBase::TagAttribValue:
+				case XMLScannerBase::Content: printer.printValue( content, contentsize, out); break;
+				case XMLScannerBase::CloseTag:
+				case XMLScannerBase::CloseTagIm: printer.printCloseTag( out); break;
+				default: break;
+			}
+		}
+		return m_events.size();
+	}
+
+	virtual std::size_t size() const
+	{
+		return m_size;
+	}
+
+private:
+	EventBuffer m_events;
+	std::size_t m_size;
+	IOCharset m_output;
+	const char* m_encoding;
+};
+
+/// \class Runner
+/// \brief Runs the benchmarks selected and prints and compares their results
+class Runner
+{
+public:
+	Runner( double minTime_, const std::string& filter_, double tolerance_)
+		:m_minTime(minTime_),m_filter(filter_),m_tolerance(tolerance_),m_nofRegressions(0){}
+
+	void loadBaseline( const char* filename)
+	{
+		std::ifstream file( filename);
+		if (!file) throw std::runtime_error( std::string( "cannot open baseline file ") + filename);
+		std::string line;
+		while (std::getline( file, line))
+		{
+			if (line.empty() || line[0] == '#') continue;
+			std::istringstream cols( line);
+			std::string name;
+			double mbPerSec;
+			if (cols >> name >> mbPerSec) m_baseline[ name] = mbPerSec;
+		}
+	}
+
+	void run( const std::string& name, Benchmark& bm)
+	{
+		if (!m_filter.empty() && name.find( m_filter) == std::string::npos) return;
+		Result res = measure( bm, m_minTime);
+		std::cout << name << '\t' << res.mbPerSec << '\t' << res.eventsPerSec << '\t' << res.allocsPerMB;
+		std::map<std::string,double>::const_iterator bi = m_baseline.find( name);
+		if (bi != m_baseline.end() && bi->second > 0.0)
+		{
+			double ratio = res.mbPerSec / bi->second;
+			std::cout << '\t' << ratio;
+			if (ratio < 1.0 - m_tolerance/100.0)
+			{
+				std::cout << "\tREGRESSION";
+				++m_nofRegressions;
+			}
+		}
+		std::cout << std::endl;
+	}
+
+	unsigned int nofRegressions() const
+	{
+		return m_nofRegressions;
+	}
+
+private:
+	double m_minTime;
+	std::string m_filter;
+	double m_tolerance;
+	std::map<std::string,double> m_baseline;
+	unsigned int m_nofRegressions;
+};
+
+int main( int argc, const char** argv)
+{
+	try
+	{
+		std::size_t docsize = 4000000;
+		double minTime = 0.5;
+		double tolerance = 10.0;
+		std::string filter;
+		const char* baseline = 0;
+		for (int ai=1; ai+1<argc; ai+=2)
+		{
+			if (std::strcmp( argv[ai], "-s") == 0) docsize = std::atol( argv[ai+1]);
+			else if (std::strcmp( argv[ai], "-t") == 0) minTime = std::atof( argv[ai+1]);
+			else if (std::strcmp( argv[ai], "-f") == 0) filter = argv[ai+1];
+			else if (std::strcmp( argv[ai], "-b") == 0) baseline = argv[ai+1];
+			else if (std::strcmp( argv[ai], "-r") == 0) tolerance = std::atof( argv[ai+1]);
+			else throw std::runtime_error( std::string( "unknown option ") + argv[ai]);
+		}
+		Runner runner( minTime, filter, tolerance);
+		if (baseline) runner.loadBaseline( baseline);
+		std::cout << "#name\tMB/s\tevents/s\tallocations/MB" << (baseline?"\tratio":"") << std::endl;
+
+		std::vector<std::string> docs;
+		for (int ki=0; ki<bench::Corpus::NofKinds; ++ki)
+		{
+			docs.push_back( bench::Corpus::generate( (bench::Corpus::Kind)ki, docsize, "UTF-8"));
+		}
+		for (int ki=0; ki<bench::Corpus::NofKinds; ++ki)
+		{
+			std::string prefix = std::string( "scan/") + bench::Corpus::kindName( (bench::Corpus::Kind)ki) + "/";
+			{
+				ScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki], false);
+				runner.run( prefix + "UTF-8>UTF-8", bm);
+			}
+			{
+				ScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki], true);
+				runner.run( prefix + "UTF-8>UTF-8/zerocopy", bm);
+			}
+			{
+				IteratorScanBenchmark bm( docs[ ki]);
+				runner.run( prefix + "UTF-8>UTF-8/zerocopy/iterator", bm);
+			}
+			{
+				BatchScanBenchmark bm( docs[ ki], 256);
+				runner.run( prefix + "UTF-8>UTF-8/zerocopy/nextItems", bm);
+			}
+			{
+				ScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki], true, true);
+				runner.run( prefix + "UTF-8>UTF-8/zerocopy/strict", bm);
+			}
+			{
+				StructuralScanBenchmark bm( docs[ ki]);
+				runner.run( prefix + "UTF-8>UTF-8/structural", bm);
+			}
+			{
+				ScanBenchmark<charset::UTF8,charset::UTF16LE> bm( docs[ ki], false);
+				runner.run( prefix + "UTF-8>UTF-16LE", bm);
+			}
+			{
+				PaddedScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki], false);
+				runner.run( prefix + "UTF-8>UTF-8/padded", bm);
+			}
+			{
+				ScanBenchmark<charset::UTF8,charset::UTF8,LookaheadTextScanner<CStringIterator,charset::UTF8> > bm( docs[ ki], false);
+				runner.run( prefix + "UTF-8>UTF-8/lookahead", bm);
+			}
+			{
+				PushScanBenchmark<SrcIterator,charset::UTF8,charset::UTF8> bm( docs[ ki], 65536);
+				runner.run( prefix + "UTF-8>UTF-8/push", bm);
+			}
+			{
+				PushScanBenchmark<PaddedSrcIterator,charset::UTF8,charset::UTF8> bm( docs[ ki], 65536);
+				runner.run( prefix + "UTF-8>UTF-8/push/padded", bm);
+			}
+			{
+				IStreamScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki], false);
+				runner.run( prefix + "UTF-8>UTF-8/istream", bm);
+			}
+			{
+				IStreamScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki], true);
+				runner.run( prefix + "UTF-8>UTF-8/istream/copy", bm);
+			}
+			{
+				IStreamCopyBenchmark bm( docs[ ki]);
+				runner.run( prefix + "UTF-8/istream/textscanner/copy", bm);
+			}
+			{
+				ReadAheadScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki]);
+				runner.run( prefix + "UTF-8>UTF-8/readahead", bm);
+			}
+#if defined(TEXTWOLF_WITH_ZLIB)
+			{
+				GzipScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki]);
+				runner.run( prefix + "UTF-8>UTF-8/gzip", bm);
+			}
+#endif
+			{
+				MmapScanBenchmark<charset::UTF8,charset::UTF8> bm( docs[ ki]);
+				runner.run( prefix + "UTF-8>UTF-8/mmap", bm);
+			}
+		}
+		{
+			std::string isolatin = bench::Corpus::transcode<charset::IsoLatin>( bench::Corpus::generate( bench::Corpus::ContentHeavy, docsize, "ISO-8859-1"));
+			std::string utf16le = bench::Corpus::transcode<charset::UTF16LE>( bench::Corpus::generate( bench::Corpus::ContentHeavy, docsize, "UTF-16LE"));
+			std::string utf16be = bench::Corpus::transcode<charset::UTF16BE>( bench::Corpus::generate( bench::Corpus::ContentHeavy, docsize, "UTF-16BE"));
+			std::string ucs2be = bench::Corpus::transcode<charset::UCS2BE>( bench::Corpus::generate( bench::Corpus::ContentHeavy, docsize, "UCS-2"));
+			{
+				ScanBenchmark<charset::IsoLatin,charset::UTF8> bm( isolatin, false);
+				runner.run( "scan/content/ISO-8859-1>UTF-8", bm);
+			}
+			{
+				ScanBenchmark<charset::IsoLatin,charset::IsoLatin> bm( isolatin, true);
+				runner.run( "scan/content/ISO-8859-1>ISO-8859-1/zerocopy", bm);
+			}
+			{
+				ScanBenchmark<charset::UTF16LE,charset::UTF8> bm( utf16le, false);
+				runner.run( "scan/content/UTF-16LE>UTF-8", bm);
+			}
+			{
+				ScanBenchmark<charset::UTF16LE,charset::UTF8,LookaheadTextScanner<CStringIterator,charset::UTF16LE> > bm( utf16le, false);
+				runner.run( "scan/content/UTF-16LE>UTF-8/lookahead", bm);
+			}
+			{
+				ScanBenchmark<charset::UTF16BE,charset::UTF8> bm( utf16be, false);
+				runner.run( "scan/content/UTF-16BE>UTF-8", bm);
+			}
+			{
+				ScanBenchmark<charset::UTF16LE,charset::UTF16LE> bm( utf16le, true);
+				runner.run( "scan/content/UTF-16LE>UTF-16LE/zerocopy", bm);
+			}
+			{
+				ScanBenchmark<charset::UCS2BE,charset::UTF8> bm( ucs2be, false);
+				runner.run( "scan/content/UCS-2BE>UTF-8", bm);
+			}
+			{
+				ScanBenchmark<charset::UCS2BE,charset::UCS2BE> bm( ucs2be, false);
+				runner.run( "scan/content/UCS-2BE>UCS-2BE", bm);
+			}
+		}
+		{
+			static const unsigned int nofExpressions[] = {1, 100, 10000, 0};
+			for (unsigned int ei=0; nofExpressions[ ei]; ++ei)
+			{
+				std::ostringstream name;
+				name << "select/attributes/" << nofExpressions[ ei];
+				if (!filter.empty() && name.str().find( filter) == std::string::npos) continue;
+				SelectBenchmark bm( docs[ bench::Corpus::AttributeHeavy], nofExpressions[ ei]);
+				runner.run( name.str(), bm);
+			}
+		}
+		{
+			PrintBenchmark<> bm( docs[ bench::Corpus::AttributeHeavy]);
+			runner.run( "print/attributes", bm);
+		}
+		{
+			PrintBenchmark<> bm( docs[ bench::Corpus::ContentHeavy]);
+			runner.run( "print/content", bm);
+		}
+		{
+			// ... the characters of ISO-8859-2 beyond U+00FF are printed through the inverse code page table of the overlay characters
+			std::string doc = bench::Corpus::generate( bench::Corpus::ContentHeavy, docsize, "UTF-8", bench::Corpus::CentralEuropean);
+			{
+				PrintBenchmark<> bm( doc);
+				runner.run( "print/content/central-european/UTF-8", bm);
+			}
+			{
+				PrintBenchmark<charset::IsoLatin> bm( doc, charset::IsoLatin( 2), "ISO-8859-2");
+				runner.run( "print/content/central-european/ISO-8859-2", bm);
+			}
+		}
+		return runner.nofRegressions()?1:0;
+	}
+	catch (const std::exception& err)
+	{
+		std::cerr << "ERROR " << err.what() << std::endl;
+		return 2;
+	}
+}
@@ -0,0 +1,205 @@
+/// \file bench/corpus.hpp
+/// \brief Deterministic generator of synthetic XML documents for the benchmarks
+
+#ifndef __TEXTWOLF_BENCH_CORPUS_HPP__
+#define __TEXTWOLF_BENCH_CORPUS_HPP__
+#include "textwolf/charset.hpp"
+#include "textwolf/textscanner.hpp"
+#include "textwolf/cstringiterator.hpp"
+#include <string>
+#include <cstdio>
+#include <cstddef>
+
+namespace bench {
+
+/// \class Random
+/// \brief Linear congruential generator, so that the documents generated are the same on all platforms
+class Random
+{
+public:
+	explicit Random( unsigned int seed_)
+		:m_value(seed_){}
+
+	/// \brief Get a random number in the range [0,max)
+	unsigned int get( unsigned int max)
+	{
+		m_value = m_value * 1103515245U + 12345U;
+		return ((m_value >> 16) & 0x7FFF) % max;
+	}
+
+private:
+	unsigned int m_value;
+};
+
+/// \class Corpus
+/// \brief Generator of synthetic XML documents of different kinds encoded as UTF-8
+/// \remark The words of the language Western contain characters of the ISO-8859-1 range, so that every document can be transcoded to ISO-8859-1 without loss. The words of the language CentralEuropean contain characters of ISO-8859-2 beyond U+00FF
+class Corpus
+{
+public:
+	/// \enum Kind
+	/// \brief Kinds of documents
+	enum Kind
+	{
+		DeepNesting,		///< elements nested 64 levels deep
+		AttributeHeavy,		///< empty elements with many attributes
+		ContentHeavy,		///< elements with long texts
+		EntityHeavy,		///< texts with many entities
+		NofKinds
+	};
+
+	/// \enum Language
+	/// \brief Languages of the words in the texts
+	enum Language
+	{
+		Western,		///< words with characters of ISO-8859-1
+		CentralEuropean		///< words with characters of ISO-8859-2
+	};
+
+	/// \brief Get the name of a kind of documents
+	static const char* kindName( Kind kind)
+	{
+		static const char* ar[ NofKinds] = {"deep","attributes","content","entities"};
+		return ar[ kind];
+	}
+
+	/// \brief Number of different element names in AttributeHeavy documents (e0,e1,...)
+	enum {NofElementNames=10000};
+
+	/// \brief Generate a document
+	/// \param [in] kind kind of the document
+	/// \param [in] size minimum size of the document in bytes
+	/// \param [in] encoding name of the encoding in the XML header
+	/// \param [in] language language of the words in the texts
+	/// \return the document encoded as UTF-8
+	static std::string generate( Kind kind, std::size_t size, const char* encoding, Language language=Western)
+	{
+		Random rnd( 1 + (unsigned int)kind);
+		std::string rt( "<?xml version=\"1.0\" encoding=\"");
+		rt.append( encoding);
+		rt.append( "\"?>\n<doc>\n");
+		while (rt.size() < size)
+		{
+			switch (kind)
+			{
+				case DeepNesting: appendDeep( rt, rnd, language); break;
+				case AttributeHeavy: appendAttributes( rt, rnd, language); break;
+				case ContentHeavy: appendContent( rt, rnd, language); break;
+				case EntityHeavy: appendEntities( rt, rnd, language); break;
+				case NofKinds: break;
+			}
+		}
+		rt.append( "</doc>\n");
+		return rt;
+	}
+
+	/// \brief Transcode a document from UTF-8 to another character set encoding
+	template <class CharSet>
+	static std::string transcode( const std::string& doc, const CharSet& charset=CharSet())
+	{
+		std::string rt;
+		textwolf::CStringIterator itr( doc.c_str(), doc.size());
+		textwolf::TextScanner<textwolf::CStringIterator,textwolf::charset::UTF8> ts( itr);
+		textwolf::UChar ch;
+		while ((ch = ts.chr()) != 0)
+		{
+			charset.print( ch, rt);
+			++ts;
+		}
+		return rt;
+	}
+
+private:
+	static const char* word( Random& rnd, Language language)
+	{
+		static const char* ar[ 2][ 16] =
+		{
+			{
+				"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog",
+				"M\xc3\xbcller", "Stra\xc3\x9f" "e", "caf\xc3\xa9", "na\xc3\xafve", "data", "value", "record", "stream"
+			},
+			{
+				"the", "quick", "brown", "fox", "jumps", "over", "lazy", "dog",
+				"\xc5\x81\xc3\xb3" "d\xc5\xba", "Gda\xc5\x84sk", "\xc4\x8c" "esk\xc3\xbd", "\xc5\x99" "eka", "Gy\xc5\x91r", "\xc5\xbe" "aba", "\xc5\x9bwiat", "m\xc3\xa1j"
+			}
+		};
+		return ar[ language][ rnd.get( 16)];
+	}
+
+	static void appendNumber( std::string& doc, unsigned int num)
+	{
+		char buf[ 16];
+		std::sprintf( buf, "%u", num);
+		doc.append( buf);
+	}
+
+	static void appendText( std::string& doc, Random& rnd, Language language, unsigned int nofWords)
+	{
+		for (unsigned int ii=0; ii<nofWords; ++ii)
+		{
+			if (ii) doc.push_back( ' ');
+			doc.append( word( rnd, language));
+		}
+	}
+
+	static void appendDeep( std::string& doc, Random& rnd, Language language)
+	{
+		unsigned int depth = 64;
+		for (unsigned int ii=0; ii<depth; ++ii)
+		{
+			doc.append( "<n");
+			appendNumber( doc, ii);
+			doc.push_back( '>');
+		}
+		appendText( doc, rnd, language, 2);
+		for (unsigned int ii=depth; ii>0; --ii)
+		{
+			doc.append( "</n");
+			appendNumber( doc, ii-1);
+			doc.push_back( '>');
+		}
+		doc.push_back( '\n');
+	}
+
+	static void appendAttributes( std::string& doc, Random& rnd, Language language)
+	{
+		doc.append( "<e");
+		appendNumber( doc, rnd.get( NofElementNames));
+		doc.append( " id='");
+		appendNumber( doc, rnd.get( 1000000));
+		doc.push_back( '\'');
+		for (unsigned int ii=0; ii<10; ++ii)
+		{
+			doc.append( " a");
+			appendNumber( doc, ii);
+			doc.append( (ii & 1)?"=\"":"='");
+			appendText( doc, rnd, language, 1 + rnd.get( 3));
+			doc.push_back( (ii & 1)?'\"':'\'');
+		}
+		doc.append( "/>\n");
+	}
+
+	static void appendContent( std::string& doc, Random& rnd, Language language)
+	{
+		doc.append( "<p>");
+		appendText( doc, rnd, language, 40 + rnd.get( 80));
+		doc.append( "</p>\n");
+	}
+
+	static void appendEntities( std::string& doc, Random& rnd, Language language)
+	{
+		static const char* ar[ 8] = {"&amp;", "&lt;", "&gt;", "&quot;", "&apos;", "&#228;", "&#xE9;", "&#223;"};
+		doc.append( "<p>");
+		for (unsigned int ii=0; ii<20; ++ii)
+		{
+			doc.append( word( rnd, language));
+			doc.push_back( ' ');
+			doc.append( ar[ rnd.get( 8)]);
+			doc.push_back( ' ');
+		}
+		doc.append( "</p>\n");
+	}
+};
+
+}//namespace
+#endif
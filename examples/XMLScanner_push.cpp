@@ -0,0 +1,36 @@
+#include "textwolf/xmlscanner.hpp"
+#include "textwolf/charset.hpp"
+#include "textwolf/sourceiterator.hpp"
+#include <iostream>
+#include <string>
+#include <stdexcept>
+typedef textwolf::charset::UTF8 Encoding;
+typedef textwolf::SrcIterator Iterator;
+typedef textwolf::XMLScanner<Iterator,Encoding,Encoding,std::string> Scanner;
+
+bool output( Scanner& scan, const char* chunk, std::size_t chunksize, bool eof)
+{
+	scan.putInput( chunk, chunksize, eof);
+	for (;;)
+	{
+		Scanner::ElementType type = scan.nextItem();
+		switch (type)
+		{
+			case Scanner::NeedMoreInput:
+				return false; //... do call the function with the next chunk
+			case Scanner::ErrorOccurred:
+			{
+				const char* err;
+				scan.getError( &err);
+				throw std::runtime_error( std::string("xml error: ") + err);
+			}
+			case Scanner::Exit:
+				return true;
+			default:
+			{
+				std::string elem = std::string( scan.getItemPtr(), scan.getItemSize());
+				std::cout << Scanner::getElementTypeName( type) << " " << elem << std::endl;
+			}
+		}
+	}
+}
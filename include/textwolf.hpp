@@ -42,16 +42,27 @@
 #include "textwolf/char.hpp"
 #include "textwolf/exception.hpp"
 #include "textwolf/staticbuffer.hpp"
+#include "textwolf/bytescan.hpp"
+#include "textwolf/entitytable.hpp"
 #include "textwolf/charset_interface.hpp"
 #include "textwolf/charset.hpp"
+#include "textwolf/utf8validator.hpp"
+#include "textwolf/widecharscanner.hpp"
+#include "textwolf/utf16transcoder.hpp"
 #include "textwolf/textscanner.hpp"
 #include "textwolf/xmlscanner.hpp"
+#include "textwolf/structuralindex.hpp"
+#include "textwolf/xmlstructuralscanner.hpp"
+#include "textwolf/thread.hpp"
+#include "textwolf/xmlparallelscanner.hpp"
 #include "textwolf/cstringiterator.hpp"
+#include "textwolf/paddedbufferiterator.hpp"
 #include "textwolf/sourceiterator.hpp"
 #include "textwolf/xmltagstack.hpp"
 #include "textwolf/xmlprinter.hpp"
 #include "textwolf/xmlhdrparser.hpp"
 #include "textwolf/xmlpathselect.hpp"
+#include "textwolf/xmlbatchprocessor.hpp"
 
 #endif
 
@@ -0,0 +1,263 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this context refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/bytescan.hpp
+/// \brief Search for the next byte out of a set of delimiter bytes in a memory block, vectorized with SSE2/AVX2 if available
+
+#ifndef __TEXTWOLF_BYTESCAN_HPP__
+#define __TEXTWOLF_BYTESCAN_HPP__
+#include "textwolf/char.hpp"
+#include <cstddef>
+#include <cstring>
+
+#ifndef TEXTWOLF_NO_SIMD
+#if defined(__AVX2__)
+#define TEXTWOLF_SIMD_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TEXTWOLF_SIMD_SSE2
+#include <emmintrin.h>
+#endif
+#if defined(_MSC_VER) && (defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2))
+#include <intrin.h>
+#endif
+#endif
+namespace textwolf {
+
+/// \class ByteScanTable
+/// \brief Set of delimiter bytes with a search for the first delimiter in a block of bytes
+/// \remark The vectorized search evaluates blocks of 16 (SSE2) or 32 (AVX2) bytes at once. Bytes in the range [0x00..0x20] and [0x80..0xFF] are tested with a range comparison, the others with one comparison per byte in the set. If there are more than MaxNofVectorChars of them, the search falls back to the scalar version. Define TEXTWOLF_NO_SIMD to disable vectorization.
+/// \remark ByteScanTable is an aggregate without constructor, so that tables of sets can be constant initialized data (see XMLScannerTables::tokenRun). Its members are public only for this reason. Sets are built with ByteScanSet, a value initialized ByteScanTable() is the empty set
+struct ByteScanTable
+{
+	/// \brief Maximum number of delimiters in the range [0x21..0x7F] for the vectorized search
+	enum {MaxNofVectorChars=16};
+
+	/// \brief Test if a byte is a delimiter
+	/// \param[in] ch the byte to test
+	/// \return true, if 'ch' is in the set
+	bool operator[]( unsigned char ch) const
+	{
+		return ((map[ ch >> 5] >> (ch & 31)) & 1) != 0;
+	}
+
+	/// \brief Find the first delimiter in the block [src,end)
+	/// \param[in] src start of the block to search
+	/// \param[in] end end of the block to search
+	/// \return pointer to the first delimiter found or 'end', if there is none
+	const char* find( const char* src, const char* end) const
+	{
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+		if (vectorize)
+		{
+			for (; src + BlockSize <= end; src += BlockSize)
+			{
+				unsigned int mask = candidates( src);
+				while (mask)
+				{
+					unsigned int idx = firstbit( mask);
+					if ((*this)[ (unsigned char)src[ idx]]) return src + idx;
+					mask &= mask - 1;
+				}
+			}
+		}
+#endif
+		for (; src < end && !(*this)[ (unsigned char)*src]; ++src){}
+		return src;
+	}
+
+	/// \brief Find the first delimiter in a null terminated block of bytes
+	/// \remark The byte 0 has to be an element of the set
+	/// \remark The vectorized search is done with find(const char*,const char*) on pieces of ZChunkSize bytes, whose length is determined with strnlen first, so that no byte beyond the terminating 0 is read
+	/// \param[in] src start of the block to search
+	/// \return pointer to the first delimiter found
+	const char* findz( const char* src) const
+	{
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+		if (vectorize)
+		{
+			for (;;)
+			{
+				std::size_t len = strnlen( src, ZChunkSize);
+				const char* rt = find( src, src + len);
+				if (rt != src + len || len < ZChunkSize) return rt;
+				src += len;
+			}
+		}
+#endif
+		for (; !(*this)[ (unsigned char)*src]; ++src){}
+		return src;
+	}
+
+	/// \brief Find the first delimiter of a set in a block of bytes, with the interface of WideCharScanner::findDelimiter
+	/// \param[in] delim set of delimiters
+	/// \param[in] src start of the block to search
+	/// \param[in] end end of the block to search or NULL, if the block is null terminated
+	/// \return pointer to the first delimiter found or 'end', if there is none
+	static const char* findDelimiter( const ByteScanTable& delim, const char* src, const char* end)
+	{
+		return end ? delim.find( src, end) : delim.findz( src);
+	}
+
+	unsigned int map[ 8];				///< set of delimiters, bit (ch % 32) of map[ ch / 32] is set for the delimiter ch
+	unsigned char chr[ MaxNofVectorChars];		///< delimiters tested with a single comparison in the vectorized search
+	unsigned int nofchr;				///< number of elements in chr
+	bool low;					///< true, if the bytes [0x00..0x20] are candidates in the vectorized search
+	bool high;					///< true, if the bytes [0x80..0xFF] are candidates in the vectorized search
+	bool vectorize;					///< true, if the set is suitable for the vectorized search
+
+private:
+#if defined(TEXTWOLF_SIMD_AVX2)
+	enum {BlockSize=32};
+
+	/// \brief Get the bit mask of the delimiter candidates in a block of BlockSize bytes (a superset of the delimiters in the block)
+	unsigned int candidates( const char* src) const
+	{
+		__m256i blk = _mm256_loadu_si256( (const __m256i*)src);
+		__m256i rt = _mm256_setzero_si256();
+		if (low) rt = _mm256_cmpeq_epi8( _mm256_min_epu8( blk, _mm256_set1_epi8( 0x20)), blk);
+		if (high) rt = _mm256_or_si256( rt, _mm256_cmpgt_epi8( _mm256_setzero_si256(), blk));
+		for (unsigned int ii=0; ii<nofchr; ++ii)
+		{
+			rt = _mm256_or_si256( rt, _mm256_cmpeq_epi8( blk, _mm256_set1_epi8( (char)chr[ii])));
+		}
+		return (unsigned int)_mm256_movemask_epi8( rt);
+	}
+#elif defined(TEXTWOLF_SIMD_SSE2)
+	enum {BlockSize=16};
+
+	/// \brief Get the bit mask of the delimiter candidates in a block of BlockSize bytes (a superset of the delimiters in the block)
+	unsigned int candidates( const char* src) const
+	{
+		__m128i blk = _mm_loadu_si128( (const __m128i*)src);
+		__m128i rt = _mm_setzero_si128();
+		if (low) rt = _mm_cmpeq_epi8( _mm_min_epu8( blk, _mm_set1_epi8( 0x20)), blk);
+		if (high) rt = _mm_or_si128( rt, _mm_cmplt_epi8( blk, _mm_setzero_si128()));
+		for (unsigned int ii=0; ii<nofchr; ++ii)
+		{
+			rt = _mm_or_si128( rt, _mm_cmpeq_epi8( blk, _mm_set1_epi8( (char)chr[ii])));
+		}
+		return (unsigned int)_mm_movemask_epi8( rt);
+	}
+#endif
+
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+	/// \brief Maximum number of bytes of a null terminated block measured with strnlen at once by findz(const char*)
+	enum {ZChunkSize=256};
+
+	/// \brief Get the index of the lowest bit set in a non zero mask
+	static unsigned int firstbit( unsigned int mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long rt;
+		_BitScanForward( &rt, mask);
+		return (unsigned int)rt;
+#else
+		return (unsigned int)__builtin_ctz( mask);
+#endif
+	}
+#endif
+};
+
+/// \class ByteScanSet
+/// \brief Set of delimiter bytes built byte by byte or by intervals for the search with ByteScanTable
+class ByteScanSet
+	:public ByteScanTable
+{
+public:
+	/// \brief Constructor
+	ByteScanSet()
+		:ByteScanTable(ByteScanTable())
+	{
+		vectorize = true;
+	}
+
+	/// \brief Add a delimiter byte to the set
+	/// \param[in] ch the byte to add
+	ByteScanSet& operator()( unsigned char ch)
+	{
+		add( ch);
+		update();
+		return *this;
+	}
+
+	/// \brief Add the delimiter bytes in the interval [from,to] to the set
+	/// \param[in] from start of the intervall (belongs also to the set)
+	/// \param[in] to end of the intervall (belongs also to the set)
+	ByteScanSet& operator()( unsigned char from, unsigned char to)
+	{
+		for (unsigned int ii=from; ii<=to; ++ii) add( (unsigned char)ii);
+		update();
+		return *this;
+	}
+
+private:
+	void add( unsigned char ch)
+	{
+		map[ ch >> 5] |= 1U << (ch & 31);
+	}
+
+	/// \brief Recalculate the parameters of the vectorized search after a change of the set
+	void update()
+	{
+		nofchr = 0;
+		low = false;
+		high = false;
+		vectorize = true;
+		unsigned int nofdelim = 0;
+		unsigned int ii;
+		for (ii=0; ii<MaxNofVectorChars; ++ii) chr[ ii] = 0;
+		for (ii=0; ii<0x80; ++ii) if ((*this)[ (unsigned char)ii]) ++nofdelim;
+		for (ii=0x80; ii<0x100; ++ii) if ((*this)[ (unsigned char)ii]) high = true;
+
+		if (nofdelim > MaxNofVectorChars)
+		{
+			// ... too many delimiters for single comparisons: use a range check for [0x00..0x20]
+			low = true;
+		}
+		for (ii=(low?0x21:0); ii<0x80; ++ii)
+		{
+			if (!(*this)[ (unsigned char)ii]) continue;
+			if (nofchr == MaxNofVectorChars)
+			{
+				vectorize = false;
+				break;
+			}
+			chr[ nofchr++] = (unsigned char)ii;
+		}
+	}
+};
+
+}//namespace
+#endif
@@ -42,5 +42,6 @@
 #include "textwolf/charset_utf16.hpp"
 #include "textwolf/charset_ucs.hpp"
 #include "textwolf/charset_isolatin.hpp"
+#include "textwolf/charset_windows125x.hpp"
 #endif
 
@@ -83,6 +83,8 @@ struct Interface
 {
 	/// \brief Maximum character this characer set encoding can represent
 	enum {MaxChar=0xFF};
+	/// \brief Size of a code unit of this character set encoding in bytes (1 for byte oriented encodings)
+	enum {CodeUnitSize=1};
 
 	/// \brief Skip to start of the next character
 	/// \tparam Iterator source iterator used
@@ -129,6 +131,22 @@ struct Interface
 	template <class Buffer_>
 	void print( UChar chr, Buffer_& buf) const;
 
+	/// \brief Prints an array of unicode characters to a buffer
+	/// \remark Encodes the characters through a raw pointer into a local chunk that is appended to the buffer at once with appendBytes(Buffer&,const char*,std::size_t). Characters that are not representable in the character set encoding are printed with print(UChar,Buffer&)
+	/// \tparam Buffer_ STL back insertion sequence
+	/// \param [in] begin pointer to the first character to print
+	/// \param [in] end pointer to the end of the characters to print
+	/// \param [out] buf buffer to print to
+	template <class Buffer_>
+	void print( const UChar* begin, const UChar* end, Buffer_& buf) const;
+
+	/// \brief Get the size of the prefix of a block of bytes that consists of complete characters only
+	/// \remark Used for copying runs of bytes without decoding them and for holding back characters split between two chunks in push mode (see XMLScanner::putInput(const char*,std::size_t,bool))
+	/// \param [in] src pointer to the block of bytes starting with a character
+	/// \param [in] srcsize size of the block in bytes
+	/// \return the size of the prefix in bytes
+	static std::size_t completeSize( const char* src, std::size_t srcsize);
+
 	/// \brief Evaluate if two character set encodings of the same type are equal in all properties (code page, etc.)
 	/// \return true if yes
 	static bool is_equal( const Interface&, const Interface&)
@@ -60,7 +60,8 @@ struct UCS2
 		MSB=(byteorder==ByteOrder::LE),			//< most significant byte index (0 or 1)
 		Print1shift=(byteorder==ByteOrder::BE)?8:0,	//< value to shift with to get the 1st character to print
 		Print2shift=(byteorder==ByteOrder::LE)?8:0,	//< value to shift with to get the 2nd character to print
-		MaxChar=0xFFFFU
+		MaxChar=0xFFFFU,
+		CodeUnitSize=2
 	};
 
 	/// \brief See template<class Iterator>Interface::skip(char*,unsigned int&,Iterator&)
@@ -137,6 +138,42 @@ struct UCS2
 		}
 	}
 
+	/// \brief See template<class Buffer>Interface::print(const UChar*,const UChar*,Buffer&)
+	template <class Buffer_>
+	void print( const UChar* begin, const UChar* end, Buffer_& buf) const
+	{
+		enum {ChunkSize=256};
+		char tmp[ 2*ChunkSize];
+		while (begin != end)
+		{
+			const UChar* chunkend = (end - begin > ChunkSize) ? (begin + ChunkSize) : end;
+			char* cc = tmp;
+			for (; begin != chunkend; ++begin)
+			{
+				UChar chr = *begin;
+				if (chr>MaxChar)
+				{
+					appendBytes( buf, tmp, cc - tmp);
+					cc = tmp;
+					print( chr, buf);
+				}
+				else
+				{
+					cc[0] = (char)(unsigned char)(chr >> Print1shift);
+					cc[1] = (char)(unsigned char)(chr >> Print2shift);
+					cc += 2;
+				}
+			}
+			appendBytes( buf, tmp, cc - tmp);
+		}
+	}
+
+	/// \brief See Interface::completeSize(const char*,std::size_t)
+	static inline std::size_t completeSize( const char*, std::size_t srcsize)
+	{
+		return srcsize & ~(std::size_t)1;
+	}
+
 	/// \brief See template<class Buffer>Interface::is_equal( const Interface&, const Interface&)
 	static inline bool is_equal( const UCS2&, const UCS2&)
 	{
@@ -160,7 +197,8 @@ struct UCS4
 		Print2shift=(byteorder==ByteOrder::BE)?16:8,	//< value to shift with to get the 2nd character to print
 		Print3shift=(byteorder==ByteOrder::BE)?8:16,	//< value to shift with to get the 3rd character to print
 		Print4shift=(byteorder==ByteOrder::BE)?0:24,	//< value to shift with to get the 4th character to print
-		MaxChar=0xFFFFFFFFU
+		MaxChar=0xFFFFFFFFU,
+		CodeUnitSize=4
 	};
 
 	/// \brief See template<class Iterator>Interface::fetchbytes(char*,unsigned int&,Iterator&)
@@ -213,6 +251,34 @@ struct UCS4
 		buf.push_back( (unsigned char)((chr >> Print4shift) & 0xFF));
 	}
 
+	/// \brief See template<class Buffer>Interface::print(const UChar*,const UChar*,Buffer&)
+	template <class Buffer_>
+	static void print( const UChar* begin, const UChar* end, Buffer_& buf)
+	{
+		enum {ChunkSize=256};
+		char tmp[ 4*ChunkSize];
+		while (begin != end)
+		{
+			const UChar* chunkend = (end - begin > ChunkSize) ? (begin + ChunkSize) : end;
+			char* cc = tmp;
+			for (; begin != chunkend; ++begin,cc+=4)
+			{
+				UChar chr = *begin;
+				cc[0] = (char)(unsigned char)((chr >> Print1shift) & 0xFF);
+				cc[1] = (char)(unsigned char)((chr >> Print2shift) & 0xFF);
+				cc[2] = (char)(unsigned char)((chr >> Print3shift) & 0xFF);
+				cc[3] = (char)(unsigned char)((chr >> Print4shift) & 0xFF);
+			}
+			appendBytes( buf, tmp, cc - tmp);
+		}
+	}
+
+	/// \brief See Interface::completeSize(const char*,std::size_t)
+	static inline std::size_t completeSize( const char*, std::size_t srcsize)
+	{
+		return srcsize & ~(std::size_t)3;
+	}
+
 	/// \brief See template<class Buffer>Interface::is_equal( const Interface&, const Interface&)
 	static inline bool is_equal( const UCS4&, const UCS4&)
 	{
@@ -70,7 +70,8 @@ private:
 public:
 	enum
 	{
-		MaxChar=0x10FFFFU				//< maximum character in alphabet
+		MaxChar=0x10FFFFU,				//< maximum character in alphabet
+		CodeUnitSize=2					//< size of a code unit in bytes
 	};
 
 public:
@@ -204,6 +205,58 @@ public:
 		}
 	}
 
+	/// \brief See template<class Buffer>Interface::print(const UChar*,const UChar*,Buffer&)
+	template <class Buffer_>
+	void print( const UChar* begin, const UChar* end, Buffer_& buf) const
+	{
+		enum {ChunkSize=256};
+		char tmp[ 4*ChunkSize];
+		while (begin != end)
+		{
+			const UChar* chunkend = (end - begin > ChunkSize) ? (begin + ChunkSize) : end;
+			char* cc = tmp;
+			for (; begin != chunkend; ++begin)
+			{
+				UChar ch = *begin;
+				if (ch <= 0xFFFF && (ch - 0xD800) >= 0x400)
+				{
+					cc[0] = (char)(unsigned char)((ch >> Print1shift) & 0xFF);
+					cc[1] = (char)(unsigned char)((ch >> Print2shift) & 0xFF);
+					cc += 2;
+				}
+				else if (ch > 0xFFFF && ch <= 0x10FFFF)
+				{
+					UChar hi = ((ch - 0x10000) >> 10) + 0xD800;
+					UChar lo = ((ch - 0x10000) & 0x3FF) + 0xDC00;
+					cc[0] = (char)(unsigned char)((hi >> Print1shift) & 0xFF);
+					cc[1] = (char)(unsigned char)((hi >> Print2shift) & 0xFF);
+					cc[2] = (char)(unsigned char)((lo >> Print1shift) & 0xFF);
+					cc[3] = (char)(unsigned char)((lo >> Print2shift) & 0xFF);
+					cc += 4;
+				}
+				else
+				{
+					// ... high surrogates and characters beyond 0x10FFFF are printed as character references
+					appendBytes( buf, tmp, cc - tmp);
+					cc = tmp;
+					print( ch, buf);
+				}
+			}
+			appendBytes( buf, tmp, cc - tmp);
+		}
+	}
+
+	/// \brief See Interface::completeSize(const char*,std::size_t)
+	/// \remark A unit with a high surrogate always forms a character with the unit following it, so the last character is incomplete if the trailing run of high surrogate units has an odd length
+	static std::size_t completeSize( const char* src, std::size_t srcsize)
+	{
+		std::size_t rt = srcsize & ~(std::size_t)1;
+		std::size_t pos = rt;
+		while (pos >= 2 && ((unsigned char)src[ pos-2+MSB] - 0xD8U) <= 0x03U) pos -= 2;
+		if (((rt - pos) & 2) != 0) rt -= 2;
+		return rt;
+	}
+
 	/// \brief See template<class Buffer>Interface::is_equal( const Interface&, const Interface&)
 	static inline bool is_equal( const UTF16&, const UTF16&)
 	{
@@ -41,6 +41,7 @@
 #include "textwolf/charset_interface.hpp"
 #include "textwolf/exception.hpp"
 #include <cstddef>
+#include <cstring>
 
 namespace textwolf {
 namespace charset {
@@ -51,6 +52,7 @@ struct UTF8
 {
 	/// \brief Maximum character that can be represented by this encoding implementation
 	enum {MaxChar=0x7FFFFFFFU};
+	enum {CodeUnitSize=1};
 	enum {
 		B11111111=0xFF,
 		B01111111=0x7F,
@@ -94,6 +96,37 @@ struct UTF8
 		}
 	};
 
+	/// \brief Get the length of a character in bytes from its first byte (same mapping as CharLengthTab)
+	/// \remark Uses constant tables, so there is no initialization on first use like for a static CharLengthTab
+	/// \param [in] ch first byte of the character
+	/// \return the length of the character in bytes or 0 for a byte that cannot start a character
+	static inline unsigned int charLength( unsigned char ch)
+	{
+		static const unsigned char lengthByHighNibble[ 16] = {1,1,1,1,1,1,1,1,0,0,0,0,2,2,3,0};
+		static const unsigned char lengthByLowNibble[ 16] = {4,4,4,4,4,4,4,4,5,5,5,5,6,6,7,8};
+		return (ch < B11110000)?lengthByHighNibble[ ch >> 4]:lengthByLowNibble[ ch & B00001111];
+	}
+
+	/// \brief Get the number of ASCII bytes at the start of a block
+	/// \remark Blocks of 8 bytes are checked at once
+	/// \param [in] src pointer to the block
+	/// \param [in] srcsize size of the block in bytes
+	/// \return the number of bytes before the first non ASCII byte or srcsize
+	static inline std::size_t asciiSize( const char* src, std::size_t srcsize)
+	{
+		static const EChar nonAsciiMask = ((EChar)0x80808080U << 32) | (EChar)0x80808080U;
+		std::size_t pos = 0;
+		while (pos + 8 <= srcsize)
+		{
+			EChar blk;
+			std::memcpy( &blk, src+pos, sizeof(blk));
+			if ((blk & nonAsciiMask) != 0) break;
+			pos += 8;
+		}
+		for (; pos < srcsize && (unsigned char)src[ pos] <= 127; ++pos){}
+		return pos;
+	}
+
 	/// \brief Get the size of the current character in bytes (variable length encoding)
 	/// \param [in] buf buffer for the character data
 	/// \param [in,out] bufpos position in 'buf'
@@ -101,20 +134,21 @@ struct UTF8
 	template <class Iterator>
 	static inline unsigned int size( char* buf, unsigned int& bufpos, Iterator& itr)
 	{
-		static CharLengthTab charLengthTab;
 		if (bufpos==0)
 		{
 			buf[0] = *itr;
 			++itr;
 			++bufpos;
 		}
-		return charLengthTab[ (unsigned char)buf[ 0]];
+		return charLength( (unsigned char)buf[ 0]);
 	}
 
 	/// \brief See template<class Iterator>Interface::skip(char*,unsigned int&,Iterator&)
+	/// \remark An ASCII character fetched already is skipped without looking up its length
 	template <class Iterator>
 	static inline void skip( char* buf, unsigned int& bufpos, Iterator& itr)
 	{
+		if (bufpos == 1 && (unsigned char)buf[0] <= 127) return;
 		unsigned int bufsize = size( buf, bufpos, itr);
 		for (;bufpos < bufsize; ++bufpos)
 		{
@@ -145,6 +179,7 @@ struct UTF8
 			++itr;
 			++bufpos;
 		}
+		if ((unsigned char)buf[0] <= 127) return;
 		unsigned int bufsize = size( buf, bufpos, itr);
 		for (;bufpos < bufsize; ++bufpos)
 		{
@@ -205,6 +240,84 @@ struct UTF8
 		}
 	}
 
+	/// \brief See template<class Buffer>Interface::print(const UChar*,const UChar*,Buffer&)
+	template <class Buffer_>
+	void print( const UChar* begin, const UChar* end, Buffer_& buf) const
+	{
+		enum {ChunkSize=256};
+		char tmp[ 4*ChunkSize];
+		while (begin != end)
+		{
+			const UChar* chunkend = (end - begin > ChunkSize) ? (begin + ChunkSize) : end;
+			char* cc = tmp;
+			for (; begin != chunkend; ++begin)
+			{
+				UChar chr = *begin;
+				if (chr < 0x80)
+				{
+					*cc++ = (char)(unsigned char)chr;
+				}
+				else if (chr < 0x800)
+				{
+					cc[0] = (char)(unsigned char)(0xC0 | (chr >> 6));
+					cc[1] = (char)(unsigned char)(0x80 | (chr & 0x3F));
+					cc += 2;
+				}
+				else if (chr < 0x10000)
+				{
+					cc[0] = (char)(unsigned char)(0xE0 | (chr >> 12));
+					cc[1] = (char)(unsigned char)(0x80 | ((chr >> 6) & 0x3F));
+					cc[2] = (char)(unsigned char)(0x80 | (chr & 0x3F));
+					cc += 3;
+				}
+				else if (chr < 0x200000)
+				{
+					cc[0] = (char)(unsigned char)(0xF0 | (chr >> 18));
+					cc[1] = (char)(unsigned char)(0x80 | ((chr >> 12) & 0x3F));
+					cc[2] = (char)(unsigned char)(0x80 | ((chr >> 6) & 0x3F));
+					cc[3] = (char)(unsigned char)(0x80 | (chr & 0x3F));
+					cc += 4;
+				}
+				else
+				{
+					// ... 5 and 6 byte sequences are rare, they are printed one by one
+					appendBytes( buf, tmp, cc - tmp);
+					cc = tmp;
+					print( chr, buf);
+				}
+			}
+			appendBytes( buf, tmp, cc - tmp);
+		}
+	}
+
+	/// \brief See Interface::completeSize(const char*,std::size_t)
+	/// \remark Walks through the characters like skip(char*,unsigned int&,Iterator&) does, to get the same character boundaries also for invalid input. Runs of ASCII characters are skipped with asciiSize(const char*,std::size_t)
+	/// \remark The walk in a large block starts after the last 7 ASCII bytes in a row and not at the start of the block. No character is longer than 8 bytes, so the position after 7 ASCII bytes is a character boundary for any input before
+	static std::size_t completeSize( const char* src, std::size_t srcsize)
+	{
+		std::size_t pos = 0;
+		if (srcsize > 64)
+		{
+			unsigned int nofascii = 0;
+			pos = srcsize;
+			while (pos > 0 && nofascii < 7)
+			{
+				--pos;
+				nofascii = ((unsigned char)src[ pos] <= 127)?(nofascii+1):0;
+			}
+			if (nofascii == 7) pos += 7;
+		}
+		for (;;)
+		{
+			pos += asciiSize( src+pos, srcsize-pos);
+			if (pos >= srcsize) return pos;
+			unsigned int chrsize = charLength( (unsigned char)src[ pos]);
+			if (chrsize == 0) chrsize = 1;
+			if (pos + chrsize > srcsize) return pos;
+			pos += chrsize;
+		}
+	}
+
 	/// \brief See template<class Buffer>Interface::is_equal( const Interface&, const Interface&)
 	static bool is_equal( const UTF8&, const UTF8&)
 	{
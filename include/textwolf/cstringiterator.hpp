@@ -37,6 +37,7 @@
 
 #ifndef __TEXTWOLF_CSTRING_ITERATOR_HPP__
 #define __TEXTWOLF_CSTRING_ITERATOR_HPP__
+#include "textwolf/traits.hpp"
 #include <string>
 #include <cstring>
 #include <cstdlib>
@@ -112,10 +113,32 @@ public:
 	}
 
 private:
+	friend struct traits::ContiguousSource<CStringIterator>;
 	const char* m_src;
 	unsigned int m_size;
 	unsigned int m_pos;
 };
 
+namespace traits {
+template <>
+struct ContiguousSource<CStringIterator>
+{
+	enum {FixedBlock=1};
+	static const char* block( const CStringIterator& itr, std::size_t& size)
+	{
+		size = (itr.m_size > itr.m_pos)?(itr.m_size - itr.m_pos):0;
+		return itr.m_src + itr.m_pos;
+	}
+	static std::size_t offset( const CStringIterator& itr)
+	{
+		return itr.m_pos;
+	}
+	static void advance( CStringIterator& itr, std::size_t n)
+	{
+		itr.m_pos += n;
+	}
+};
+}//namespace traits
+
 }//namespace
 #endif
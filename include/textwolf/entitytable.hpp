@@ -0,0 +1,268 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this context refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/entitytable.hpp
+/// \brief Table of named entities with a constant time lookup (perfect hash)
+
+#ifndef __TEXTWOLF_ENTITY_TABLE_HPP__
+#define __TEXTWOLF_ENTITY_TABLE_HPP__
+#include "textwolf/char.hpp"
+#include "textwolf/exception.hpp"
+#include <map>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstring>
+#include <cstddef>
+
+namespace textwolf {
+
+/// \class EntityTable
+/// \brief Read only table of named entities built once from a list of entity definitions, for the lookup of the entities in the XML scanner
+/// \remark The table is a perfect hash (hash and displace): the name of an entity is hashed to a bucket and the seed stored for the bucket hashes all names of the bucket to distinct slots. A lookup calculates two hash values and compares one name. It does not allocate memory
+/// \remark The XML scanner refers to the table and does not copy it, so the table must live as long as the scanners using it
+/// \remark The XML scanner recognizes entity names of up to 15 bytes (XMLScanner::TokState::buf). A reference to an entity with a longer name is not looked up, it is passed through as text like an invalid entity reference
+class EntityTable :public throws_exception
+{
+public:
+	/// \class Entity
+	/// \brief Definition of an entity
+	struct Entity
+	{
+		const char* name;			///< name of the entity (without '&' and ';')
+		UChar value;				///< character the entity stands for
+	};
+
+	/// \brief Default constructor (empty table)
+	EntityTable()
+	{
+		build();
+	}
+
+	/// \brief Constructor
+	/// \param [in] ar array of entity definitions
+	/// \param [in] arsize number of elements in 'ar'
+	EntityTable( const Entity* ar, std::size_t arsize)
+	{
+		for (std::size_t ii=0; ii<arsize; ++ii) define( ar[ii].name, std::strlen( ar[ii].name), ar[ii].value);
+		build();
+	}
+
+	/// \brief Constructor
+	/// \remark Explicit, because the XML scanner refers to the table passed and must not get a temporary built on the fly
+	/// \param [in] map map of entity definitions (e.g. XMLScanner::EntityMap)
+	explicit EntityTable( const std::map<const char*,UChar>& map)
+	{
+		std::map<const char*,UChar>::const_iterator mi = map.begin(), me = map.end();
+		for (; mi != me; ++mi) define( mi->first, std::strlen( mi->first), mi->second);
+		build();
+	}
+
+	/// \brief Constructor
+	/// \remark Explicit, because the XML scanner refers to the table passed and must not get a temporary built on the fly
+	/// \param [in] map map of entity definitions
+	explicit EntityTable( const std::map<std::string,UChar>& map)
+	{
+		std::map<std::string,UChar>::const_iterator mi = map.begin(), me = map.end();
+		for (; mi != me; ++mi) define( mi->first.c_str(), mi->first.size(), mi->second);
+		build();
+	}
+
+	/// \brief Find an entity
+	/// \param [in] name name of the entity
+	/// \param [in] namesize size of 'name' in bytes
+	/// \param [out] value character the entity stands for
+	/// \return true, if the entity is defined
+	bool find( const char* name, std::size_t namesize, UChar& value) const
+	{
+		if (m_slot.empty()) return false;
+		unsigned int seed = m_seed[ hash( name, namesize, 0) & (m_seed.size()-1)];
+		const Slot& slot = m_slot[ hash( name, namesize, seed) & (m_slot.size()-1)];
+		if (slot.namesize != namesize || std::memcmp( m_names.c_str() + slot.nameofs, name, namesize) != 0) return false;
+		value = slot.value;
+		return true;
+	}
+
+	/// \brief Find an entity
+	/// \param [in] name null terminated name of the entity
+	/// \param [out] value character the entity stands for
+	/// \return true, if the entity is defined
+	bool find( const char* name, UChar& value) const
+	{
+		return find( name, std::strlen( name), value);
+	}
+
+	/// \brief Get the number of entities defined
+	std::size_t size() const
+	{
+		return m_def.size();
+	}
+
+private:
+	/// \class Slot
+	/// \brief Element of the hash table
+	struct Slot
+	{
+		std::size_t nameofs;			///< offset of the name in m_names
+		std::size_t namesize;			///< size of the name in bytes, (std::size_t)-1 for an empty slot
+		UChar value;				///< character the entity stands for
+
+		Slot() :nameofs(0),namesize((std::size_t)-1),value(0){}
+	};
+
+	/// \brief Hash function (FNV-1a with a seed)
+	static unsigned int hash( const char* name, std::size_t namesize, unsigned int seed)
+	{
+		unsigned int rt = 2166136261U ^ (seed * 0x9E3779B9U);
+		for (std::size_t ii=0; ii<namesize; ++ii)
+		{
+			rt ^= (unsigned char)name[ii];
+			rt *= 16777619U;
+		}
+		rt ^= rt >> 15;
+		return rt;
+	}
+
+	/// \brief Add an entity definition to the list
+	void define( const char* name, std::size_t namesize, UChar value)
+	{
+		Slot def;
+		def.nameofs = m_names.size();
+		def.namesize = namesize;
+		def.value = value;
+		m_names.append( name, namesize);
+		m_def.push_back( def);
+	}
+
+	/// \brief Order entity definitions by name
+	struct NameLess
+	{
+		const std::string* names;
+		explicit NameLess( const std::string* names_) :names(names_){}
+		bool operator()( const Slot& a, const Slot& b) const
+		{
+			return names->compare( a.nameofs, a.namesize, *names, b.nameofs, b.namesize) < 0;
+		}
+	};
+
+	/// \brief Order buckets by descending size
+	struct BucketSizeGreater
+	{
+		const std::vector< std::vector<std::size_t> >* buckets;
+		explicit BucketSizeGreater( const std::vector< std::vector<std::size_t> >* buckets_) :buckets(buckets_){}
+		bool operator()( std::size_t a, std::size_t b) const
+		{
+			return (*buckets)[a].size() > (*buckets)[b].size();
+		}
+	};
+
+	/// \brief Build the perfect hash table from the list of entity definitions
+	void build()
+	{
+		// ... eliminate duplicate definitions, the last one is valid
+		std::stable_sort( m_def.begin(), m_def.end(), NameLess( &m_names));
+		std::vector<Slot> def;
+		for (std::size_t ii=0; ii<m_def.size(); ++ii)
+		{
+			if (ii+1 < m_def.size() && !NameLess( &m_names)( m_def[ii], m_def[ii+1])) continue;
+			def.push_back( m_def[ii]);
+		}
+		m_def.swap( def);
+
+		std::size_t nofslots = 1;
+		while (nofslots < 2*m_def.size()) nofslots *= 2;
+		while (!build( nofslots)) nofslots *= 2;
+	}
+
+	/// \brief Try to build the perfect hash table with a given number of slots
+	/// \param [in] nofslots number of slots (power of 2)
+	/// \return true on success, false if no seed could be found for a bucket
+	bool build( std::size_t nofslots)
+	{
+		enum {MaxSeed=0x10000};
+		std::size_t nofbuckets = 1;
+		while (nofbuckets*2 < nofslots/2) nofbuckets *= 2;
+
+		std::vector< std::vector<std::size_t> > buckets( nofbuckets);
+		std::vector<std::size_t> order;
+		std::size_t ii;
+		for (ii=0; ii<m_def.size(); ++ii)
+		{
+			const char* name = m_names.c_str() + m_def[ii].nameofs;
+			buckets[ hash( name, m_def[ii].namesize, 0) & (nofbuckets-1)].push_back( ii);
+		}
+		for (ii=0; ii<nofbuckets; ++ii) order.push_back( ii);
+		std::stable_sort( order.begin(), order.end(), BucketSizeGreater( &buckets));
+
+		m_slot.assign( m_def.size()?nofslots:0, Slot());
+		m_seed.assign( nofbuckets, 0);
+		std::vector<std::size_t> slotidx;
+		for (ii=0; ii<nofbuckets; ++ii)
+		{
+			const std::vector<std::size_t>& bucket = buckets[ order[ii]];
+			if (bucket.empty()) break;
+			unsigned int seed = 1;
+			for (; seed < MaxSeed; ++seed)
+			{
+				slotidx.clear();
+				std::size_t ei = 0;
+				for (; ei < bucket.size(); ++ei)
+				{
+					const Slot& def = m_def[ bucket[ei]];
+					std::size_t si = hash( m_names.c_str() + def.nameofs, def.namesize, seed) & (nofslots-1);
+					if (m_slot[ si].namesize != (std::size_t)-1) break;
+					if (std::find( slotidx.begin(), slotidx.end(), si) != slotidx.end()) break;
+					slotidx.push_back( si);
+				}
+				if (ei == bucket.size()) break;
+			}
+			if (seed == MaxSeed) return false;
+			for (std::size_t ei=0; ei < bucket.size(); ++ei)
+			{
+				m_slot[ slotidx[ ei]] = m_def[ bucket[ei]];
+			}
+			m_seed[ order[ii]] = seed;
+		}
+		return true;
+	}
+
+private:
+	std::string m_names;				///< names of the entities
+	std::vector<Slot> m_def;			///< list of entity definitions
+	std::vector<Slot> m_slot;			///< hash table
+	std::vector<unsigned int> m_seed;		///< seeds of the buckets for the hash function addressing the slots
+};
+
+}//namespace
+#endif
@@ -0,0 +1,245 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/gzipinputstream.hpp
+/// \brief Input stream inflating gzip or deflate (zlib) compressed input on the fly
+/// \remark Decompression needs zlib, enabled by defining TEXTWOLF_WITH_ZLIB and linking with zlib (-lz). Without it only uncompressed input can be read
+
+#ifndef __TEXTWOLF_GZIP_INPUT_STREAM_HPP__
+#define __TEXTWOLF_GZIP_INPUT_STREAM_HPP__
+#include "textwolf/istreamiterator.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#if defined(TEXTWOLF_WITH_ZLIB)
+#include <zlib.h>
+#endif
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class GzipInputStream
+/// \brief Input stream reading gzip or deflate (zlib format) compressed data from another input stream and inflating it directly into the buffer of the reader (e.g. IStreamIterator)
+/// \remark The format is recognized by the header of the input. Concatenated gzip members are read as one stream. Input without a gzip or zlib header is passed through uncompressed, an XML document never starts with such a header
+/// \remark Errors are reported with errorcode(): the error code of the source stream, EILSEQ for corrupt or truncated compressed data, ENOMEM if zlib runs out of memory and ENOSYS for compressed input if textwolf is built without zlib (TEXTWOLF_WITH_ZLIB not defined)
+class GzipInputStream
+	:public IStream
+{
+public:
+	/// \brief Constructor
+	/// \param [in] source input stream to read the compressed data from
+	/// \param [in] inbufsize size of the buffer for the compressed data in bytes
+	explicit GzipInputStream( IStream* source, std::size_t inbufsize=65536)
+		:m_source(source)
+		,m_inbuf(0)
+		,m_inbufsize(inbufsize<2?2:inbufsize)
+		,m_insize(0)
+		,m_inpos(0)
+		,m_mode(Unknown)
+		,m_inMember(false)
+		,m_errno(0)
+	{
+		m_inbuf = (unsigned char*)std::malloc( m_inbufsize);
+		if (!m_inbuf) throw std::bad_alloc();
+#if defined(TEXTWOLF_WITH_ZLIB)
+		std::memset( &m_zstream, 0, sizeof(m_zstream));
+#endif
+	}
+
+	virtual ~GzipInputStream()
+	{
+#if defined(TEXTWOLF_WITH_ZLIB)
+		if (m_mode == Compressed) ::inflateEnd( &m_zstream);
+#endif
+		std::free( m_inbuf);
+	}
+
+	/// \brief Read uncompressed data
+	/// \return the number of bytes read, 0 at the end of data or on error (see errorcode())
+	virtual std::size_t read( void* buf, std::size_t bufsize)
+	{
+		if (m_errno || !bufsize) return 0;
+		if (m_mode == Unknown && !detect()) return 0;
+		if (m_mode == Plain) return readPlain( buf, bufsize);
+		return readCompressed( buf, bufsize);
+	}
+
+	virtual int errorcode() const
+	{
+		return m_errno;
+	}
+
+	/// \brief Find out if a block of data starts with a gzip or zlib header
+	/// \param [in] hdr first two bytes of the data
+	static bool isCompressedHeader( const unsigned char* hdr)
+	{
+		if (hdr[0] == 0x1F && hdr[1] == 0x8B) return true;
+		// ... zlib header: compression method deflate, window size at most 32K and check bits
+		return ((hdr[0] & 0x0F) == 8 && (hdr[0] >> 4) <= 7 && ((hdr[0] << 8) | hdr[1]) % 31 == 0);
+	}
+
+private:
+	enum Mode {Unknown,Plain,Compressed};
+
+	/// \brief Read the first bytes of the source to find out if it is compressed
+	/// \return false on error
+	bool detect()
+	{
+		while (m_insize < 2)
+		{
+			std::size_t nn = m_source->read( m_inbuf + m_insize, m_inbufsize - m_insize);
+			if (m_source->errorcode())
+			{
+				m_errno = m_source->errorcode();
+				return false;
+			}
+			if (!nn) break;
+			m_insize += nn;
+		}
+		if (m_insize < 2 || !isCompressedHeader( m_inbuf))
+		{
+			m_mode = Plain;
+			return true;
+		}
+#if defined(TEXTWOLF_WITH_ZLIB)
+		m_zstream.next_in = m_inbuf;
+		m_zstream.avail_in = (uInt)m_insize;
+		// ... window size 15 + 32 for detecting gzip or zlib format
+		if (::inflateInit2( &m_zstream, 15 + 32) != Z_OK)
+		{
+			m_errno = ENOMEM;
+			return false;
+		}
+		m_mode = Compressed;
+		m_inMember = true;
+		return true;
+#else
+		m_errno = ENOSYS;
+		return false;
+#endif
+	}
+
+	/// \brief Read uncompressed input, the bytes read for detecting the format first
+	std::size_t readPlain( void* buf, std::size_t bufsize)
+	{
+		if (m_inpos < m_insize)
+		{
+			std::size_t nn = m_insize - m_inpos;
+			if (nn > bufsize) nn = bufsize;
+			std::memcpy( buf, m_inbuf + m_inpos, nn);
+			m_inpos += nn;
+			return nn;
+		}
+		std::size_t rt = m_source->read( buf, bufsize);
+		m_errno = m_source->errorcode();
+		return m_errno ? 0 : rt;
+	}
+
+#if defined(TEXTWOLF_WITH_ZLIB)
+	/// \brief Read the next block of compressed data from the source
+	/// \return false at the end of the source or on error
+	bool fillInput()
+	{
+		std::size_t nn = m_source->read( m_inbuf, m_inbufsize);
+		if (m_source->errorcode())
+		{
+			m_errno = m_source->errorcode();
+			return false;
+		}
+		m_zstream.next_in = m_inbuf;
+		m_zstream.avail_in = (uInt)nn;
+		return nn > 0;
+	}
+
+	std::size_t readCompressed( void* buf, std::size_t bufsize)
+	{
+		if (bufsize > (1U<<30)) bufsize = (1U<<30);
+		m_zstream.next_out = (Bytef*)buf;
+		m_zstream.avail_out = (uInt)bufsize;
+		while (m_zstream.avail_out)
+		{
+			if (!m_zstream.avail_in && !fillInput())
+			{
+				// ... end of the source, it must not end in the middle of a member
+				if (m_inMember && !m_errno) m_errno = EILSEQ;
+				break;
+			}
+			if (!m_inMember)
+			{
+				// ... another gzip member follows
+				::inflateReset( &m_zstream);
+				m_inMember = true;
+			}
+			int rc = ::inflate( &m_zstream, Z_NO_FLUSH);
+			if (rc == Z_STREAM_END)
+			{
+				m_inMember = false;
+			}
+			else if (rc != Z_OK && rc != Z_BUF_ERROR)
+			{
+				m_errno = (rc == Z_MEM_ERROR) ? ENOMEM : EILSEQ;
+			}
+			if (m_errno) break;
+		}
+		return m_errno ? 0 : (bufsize - m_zstream.avail_out);
+	}
+#else
+	std::size_t readCompressed( void*, std::size_t)
+	{
+		return 0;
+	}
+#endif
+
+private:
+	GzipInputStream( const GzipInputStream&);		///< non copyable
+	GzipInputStream& operator=( const GzipInputStream&);	///< non copyable
+
+	IStream* m_source;				///< stream to read the compressed data from
+	unsigned char* m_inbuf;				///< buffer for the data read from the source
+	std::size_t m_inbufsize;			///< size of m_inbuf
+	std::size_t m_insize;				///< number of bytes read for detecting the format
+	std::size_t m_inpos;				///< number of bytes read for detecting the format already returned for uncompressed input
+	Mode m_mode;					///< format of the input, Unknown before the first read
+	bool m_inMember;				///< true, if the inflater is in the middle of a compressed member
+	int m_errno;					///< error code
+#if defined(TEXTWOLF_WITH_ZLIB)
+	z_stream m_zstream;				///< inflater state
+#endif
+};
+
+}//namespace
+#endif
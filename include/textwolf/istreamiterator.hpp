@@ -39,6 +39,7 @@
 #define __TEXTWOLF_ISTREAM_ITERATOR_HPP__
 #include "textwolf/exception.hpp"
 #include "textwolf/position.hpp"
+#include "textwolf/traits.hpp"
 #include <iostream>
 #include <fstream>
 #include <iterator>
@@ -119,54 +120,80 @@ private:
 
 /// \class IStreamIterator
 /// \brief Input iterator on an STL input stream
+/// \remark The data read is followed by PaddingSize null bytes in the buffer as sentinel. Increment does not check the end of the data read and element access checks it only when it reads a null byte. The next block is read when the iterator reads the sentinel at or beyond the end of the data read
+/// \remark The buffer is shared with reference counting by the copies of an iterator, so that copying an iterator does not allocate anything. An iterator reading the next block while its buffer is shared allocates a buffer of its own (copy on write), so the copies keep the data they are iterating on. The reference count is not synchronized, the copies of an iterator must be used in the same thread
 class IStreamIterator
 	:public throws_exception
 {
 public:
+	/// \brief Number of null bytes after the data read in the buffer (at least the maximum size of a character in bytes, as the scanner skips the bytes of a character without reading them)
+	enum {PaddingSize=8};
+
 	/// \brief Default constructor
-	IStreamIterator(){}
+	IStreamIterator()
+		:m_input(0),m_shared(0),m_buf(emptyBuffer()),m_bufsize(0),m_readsize(0),m_readpos(0),m_abspos(0){}
 	/// \brief Destructor
 	~IStreamIterator()
 	{
-		std::free(m_buf);
+		release();
 	}
 
 	/// \brief Constructor
 	/// \param [in] input input to iterate on
 	IStreamIterator( IStream* input, std::size_t bufsize=8192)
-		:m_input(input),m_buf((char*)std::malloc(bufsize)),m_bufsize(bufsize),m_readsize(0),m_readpos(0),m_abspos(0)
+		:m_input(input),m_shared(allocBuffer(bufsize)),m_buf(m_shared->data()),m_bufsize(bufsize),m_readsize(0),m_readpos(0),m_abspos(0)
 	{
-		if (!m_buf) throw std::bad_alloc();
-		fillbuf();
+		try
+		{
+			fillbuf();
+		}
+		catch (...)
+		{
+			release();
+			throw;
+		}
 	}
 
 	/// \brief Copy constructor
 	/// \param [in] o iterator to copy
 	IStreamIterator( const IStreamIterator& o)
-		:m_input(o.m_input),m_buf((char*)std::malloc(o.m_bufsize)),m_bufsize(o.m_bufsize),m_readsize(o.m_readsize),m_readpos(o.m_readpos),m_abspos(o.m_abspos)
+		:m_input(o.m_input),m_shared(o.m_shared),m_buf(o.m_buf),m_bufsize(o.m_bufsize),m_readsize(o.m_readsize),m_readpos(o.m_readpos),m_abspos(o.m_abspos)
 	{
-		if (!m_buf) throw std::bad_alloc();
-		std::memcpy( m_buf, o.m_buf, o.m_readsize);
+		if (m_shared) ++m_shared->refcnt;
+	}
+
+	/// \brief Assignment
+	/// \param [in] o iterator to copy
+	IStreamIterator& operator=( const IStreamIterator& o)
+	{
+		if (o.m_shared) ++o.m_shared->refcnt;
+		release();
+		m_input = o.m_input;
+		m_shared = o.m_shared;
+		m_buf = o.m_buf;
+		m_bufsize = o.m_bufsize;
+		m_readsize = o.m_readsize;
+		m_readpos = o.m_readpos;
+		m_abspos = o.m_abspos;
+		return *this;
 	}
 
 	/// \brief Element access
 	/// \return current character
 	inline char operator* ()
 	{
-		return (m_readpos < m_readsize)?m_buf[m_readpos]:0;
+		char ch = m_buf[m_readpos];
+		if (!ch && m_readpos >= m_readsize)
+		{
+			return nextbuf();
+		}
+		return ch;
 	}
 
 	/// \brief Pre increment
 	inline IStreamIterator& operator++()
 	{
-		if (m_readpos+1 >= m_readsize)
-		{
-			fillbuf();
-		}
-		else
-		{
-			++m_readpos;
-		}
+		++m_readpos;
 		return *this;
 	}
 
@@ -181,23 +208,112 @@ public:
 	}
 
 private:
+	/// \brief Buffer shared by the copies of an iterator, the data follows the header
+	struct Buffer
+	{
+		std::size_t refcnt;			///< number of iterators referencing the buffer
+
+		char* data()
+		{
+			return (char*)(this+1);
+		}
+	};
+
+	static Buffer* allocBuffer( std::size_t bufsize)
+	{
+		Buffer* rt = (Buffer*)std::malloc( sizeof(Buffer) + bufsize + PaddingSize);
+		if (!rt) throw std::bad_alloc();
+		rt->refcnt = 1;
+		return rt;
+	}
+
+	void release()
+	{
+		if (m_shared && --m_shared->refcnt == 0) std::free( m_shared);
+		m_shared = 0;
+	}
+
+	/// \brief Padding without data for the iterator constructed empty
+	static const char* emptyBuffer()
+	{
+		static const char ar[ PaddingSize] = {0,0,0,0,0,0,0,0};
+		return ar;
+	}
+
 	bool fillbuf()
 	{
 		m_abspos += m_readsize;
-		m_readsize = m_input->read( m_buf, m_bufsize);
 		m_readpos = 0;
+		if (!m_input)
+		{
+			m_readsize = 0;
+			return true;
+		}
+		if (m_shared->refcnt > 1)
+		{
+			// ... copy on write, the other iterators sharing the buffer keep their data
+			Buffer* buf = allocBuffer( m_bufsize);
+			release();
+			m_shared = buf;
+		}
+		char* data = m_shared->data();
+		m_buf = data;
+		m_readsize = m_input->read( data, m_bufsize);
+		std::memset( data + m_readsize, 0, PaddingSize);
 		if (m_input->errorcode()) throw exception( FileReadError);
 		return true;
 	}
 
+	/// \brief Continue with the next block read after the iterator reached the sentinel at or beyond the end of the data read
+	/// \return the current character of the next block or 0 at the end of data
+	char nextbuf()
+	{
+		while (m_readsize && m_readpos >= m_readsize)
+		{
+			// ... the bytes skipped beyond the end of the data read belong to the next block
+			std::size_t skipped = m_readpos - m_readsize;
+			fillbuf();
+			m_readpos = skipped;
+		}
+		if (!m_readsize)
+		{
+			// ... end of data, keep the iterator inside the padding
+			m_readpos = 0;
+			return 0;
+		}
+		return m_buf[m_readpos];
+	}
+
 private:
+	friend struct traits::ContiguousSource<IStreamIterator>;
 	IStream* m_input;
-	char* m_buf;
+	Buffer* m_shared;
+	const char* m_buf;
 	std::size_t m_bufsize;
 	std::size_t m_readsize;
 	std::size_t m_readpos;
 	PositionIndex m_abspos;
 };
 
+namespace traits {
+template <>
+struct ContiguousSource<IStreamIterator>
+{
+	enum {FixedBlock=0};
+	static const char* block( const IStreamIterator& itr, std::size_t& size)
+	{
+		size = (itr.m_readsize > itr.m_readpos)?(itr.m_readsize - itr.m_readpos):0;
+		return itr.m_buf + itr.m_readpos;
+	}
+	static std::size_t offset( const IStreamIterator& itr)
+	{
+		return (itr.m_readpos <= itr.m_readsize)?itr.m_readpos:0;
+	}
+	static void advance( IStreamIterator& itr, std::size_t n)
+	{
+		itr.m_readpos += n;
+	}
+};
+}//namespace traits
 }//namespace
 #endif
@@ -0,0 +1,300 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/mmapfileiterator.hpp
+/// \brief textwolf iterator on a file mapped into memory
+
+#ifndef __TEXTWOLF_MMAP_FILE_ITERATOR_HPP__
+#define __TEXTWOLF_MMAP_FILE_ITERATOR_HPP__
+#include "textwolf/exception.hpp"
+#include "textwolf/position.hpp"
+#include "textwolf/traits.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if !defined(MAP_ANONYMOUS) && defined(MAP_ANON)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+#endif
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class MmapFile
+/// \brief Complete contents of a file mapped read only into memory, followed by PaddingSize null bytes as sentinel
+/// \remark The memory block can be iterated with MmapFileIterator or passed with data() and size() to the scanners working on a memory block (XMLParallelScanner, XMLStructuralScanner)
+/// \remark On POSIX systems the file is mapped into an anonymous mapping reserved with the size of the file plus the padding, so that the padding is always there without copying anything. The mapping is declared to be read sequentially (madvise MADV_SEQUENTIAL). On Windows the file is copied to a buffer only if the last page of the file mapping has no room for the padding
+/// \remark The file must not be truncated while it is mapped
+class MmapFile
+	:public throws_exception
+{
+public:
+	/// \brief Number of null bytes after the end of the file contents (at least the maximum size of a character in bytes, see PaddedBufferIterator)
+	enum {PaddingSize=8};
+
+	/// \brief Constructor
+	/// \param [in] path path of the file to map
+	explicit MmapFile( const char* path)
+		:m_data(emptyFile()),m_size(0),m_map(0),m_mapsize(0),m_copy(0)
+	{
+		open( path);
+	}
+
+	/// \brief Destructor
+	~MmapFile()
+	{
+		close();
+	}
+
+	/// \brief Get the contents of the file, followed by PaddingSize null bytes
+	const char* data() const		{return m_data;}
+	/// \brief Get the size of the file in bytes without the padding
+	std::size_t size() const		{return m_size;}
+
+private:
+#if defined(_WIN32)
+	void open( const char* path)
+	{
+		HANDLE fh = ::CreateFileA( path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+		if (fh == INVALID_HANDLE_VALUE) throw exception( FileReadError);
+		LARGE_INTEGER filesize;
+		if (!::GetFileSizeEx( fh, &filesize) || (ULONGLONG)filesize.QuadPart > (ULONGLONG)((std::size_t)-1 - PaddingSize))
+		{
+			::CloseHandle( fh);
+			throw exception( FileReadError);
+		}
+		std::size_t size = (std::size_t)filesize.QuadPart;
+		if (size == 0)
+		{
+			::CloseHandle( fh);
+			return;
+		}
+		HANDLE mh = ::CreateFileMappingA( fh, NULL, PAGE_READONLY, 0, 0, NULL);
+		::CloseHandle( fh);
+		if (!mh) throw exception( FileReadError);
+		m_map = ::MapViewOfFile( mh, FILE_MAP_READ, 0, 0, 0);
+		::CloseHandle( mh);
+		if (!m_map) throw exception( FileReadError);
+		m_mapsize = size;
+		m_size = size;
+
+		SYSTEM_INFO sysinfo;
+		::GetSystemInfo( &sysinfo);
+		std::size_t rest = size % sysinfo.dwPageSize;
+		if (rest && rest <= sysinfo.dwPageSize - PaddingSize)
+		{
+			// ... the rest of the last page is filled with null bytes
+			m_data = (const char*)m_map;
+			return;
+		}
+		m_copy = (char*)std::malloc( size + PaddingSize);
+		if (!m_copy)
+		{
+			close();
+			throw exception( OutOfMem);
+		}
+		std::memcpy( m_copy, m_map, size);
+		std::memset( m_copy + size, 0, PaddingSize);
+		::UnmapViewOfFile( m_map);
+		m_map = 0;
+		m_data = m_copy;
+	}
+
+	void close()
+	{
+		if (m_map) ::UnmapViewOfFile( m_map);
+		std::free( m_copy);
+		m_map = 0;
+		m_copy = 0;
+	}
+#else
+	void open( const char* path)
+	{
+		int fd = ::open( path, O_RDONLY);
+		if (fd < 0) throw exception( FileReadError);
+		struct stat st;
+		if (::fstat( fd, &st) != 0 || st.st_size < 0 || (PositionIndex)st.st_size > (PositionIndex)((std::size_t)-1 - PaddingSize))
+		{
+			::close( fd);
+			throw exception( FileReadError);
+		}
+		std::size_t size = (std::size_t)st.st_size;
+		if (size == 0)
+		{
+			::close( fd);
+			return;
+		}
+		// ... reserve the address range for the file and the padding, the pages beyond the file mapped over it stay null
+		std::size_t pagesize = (std::size_t)::sysconf( _SC_PAGESIZE);
+		std::size_t mapsize = ((size + PaddingSize + pagesize - 1) / pagesize) * pagesize;
+		void* area = ::mmap( 0, mapsize, PROT_READ, MAP_PRIVATE|MAP_ANONYMOUS, -1, 0);
+		if (area == MAP_FAILED)
+		{
+			::close( fd);
+			throw exception( FileReadError);
+		}
+		m_map = area;
+		m_mapsize = mapsize;
+		void* mem = ::mmap( area, size, PROT_READ, MAP_PRIVATE|MAP_FIXED, fd, 0);
+		::close( fd);
+		if (mem == MAP_FAILED)
+		{
+			close();
+			throw exception( FileReadError);
+		}
+#ifdef MADV_SEQUENTIAL
+		::madvise( mem, size, MADV_SEQUENTIAL);
+#endif
+		m_data = (const char*)mem;
+		m_size = size;
+	}
+
+	void close()
+	{
+		if (m_map) ::munmap( m_map, m_mapsize);
+		m_map = 0;
+	}
+#endif
+
+	/// \brief Padding without data for an empty file
+	static const char* emptyFile()
+	{
+		static const char ar[ PaddingSize] = {0,0,0,0,0,0,0,0};
+		return ar;
+	}
+
+private:
+	MmapFile( const MmapFile&);			///< non copyable
+	MmapFile& operator=( const MmapFile&);		///< non copyable
+
+	const char* m_data;				///< contents of the file followed by the padding
+	std::size_t m_size;				///< size of the file in bytes
+	void* m_map;					///< memory mapped or NULL
+	std::size_t m_mapsize;				///< size of the memory mapped in bytes
+	char* m_copy;					///< copy of the file with padding or NULL, if the memory mapped has no room for the padding (Windows only)
+};
+
+
+/// \class MmapFileIterator
+/// \brief Input iterator on a file mapped into memory with MmapFile
+/// \remark As PaddedBufferIterator the iterator does not compare its position with the end on every byte read but relies on the null bytes of the padding after the end of the file
+/// \remark The MmapFile must exist as long as the iterator or any span in zero copy mode returned by a scanner using it
+class MmapFileIterator
+{
+public:
+	/// \brief Default constructor
+	MmapFileIterator()
+		:m_src(0)
+		,m_itr(0)
+		,m_end(0){}
+
+	/// \brief Constructor
+	/// \param [in] file file mapped to iterate on
+	explicit MmapFileIterator( const MmapFile& file)
+		:m_src(file.data())
+		,m_itr(file.data())
+		,m_end(file.data()+file.size()){}
+
+	/// \brief Copy constructor
+	/// \param [in] o iterator to copy
+	MmapFileIterator( const MmapFileIterator& o)
+		:m_src(o.m_src)
+		,m_itr(o.m_itr)
+		,m_end(o.m_end){}
+
+	/// \brief Element access
+	/// \return current character
+	inline char operator* () const
+	{
+		return *m_itr;
+	}
+
+	/// \brief Preincrement
+	inline MmapFileIterator& operator++()
+	{
+		++m_itr;
+		return *this;
+	}
+
+	inline int operator - (const MmapFileIterator& o) const
+	{
+		if (m_src != o.m_src) return 0;
+		return (int)(m_itr - o.m_itr);
+	}
+
+	/// \brief Get the absolute position of the iterator in the file in bytes
+	PositionIndex position() const
+	{
+		return (PositionIndex)(m_itr - m_src);
+	}
+
+private:
+	friend struct traits::ContiguousSource<MmapFileIterator>;
+	const char* m_src;
+	const char* m_itr;
+	const char* m_end;
+};
+
+namespace traits {
+template <>
+struct ContiguousSource<MmapFileIterator>
+{
+	enum {FixedBlock=1};
+	static const char* block( const MmapFileIterator& itr, std::size_t& size)
+	{
+		size = (itr.m_end > itr.m_itr)?(itr.m_end - itr.m_itr):0;
+		return itr.m_itr;
+	}
+	static std::size_t offset( const MmapFileIterator& itr)
+	{
+		return itr.m_itr - itr.m_src;
+	}
+	static void advance( MmapFileIterator& itr, std::size_t n)
+	{
+		itr.m_itr += n;
+	}
+};
+}//namespace traits
+
+}//namespace
+#endif
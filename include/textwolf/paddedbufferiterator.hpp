@@ -0,0 +1,136 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/paddedbufferiterator.hpp
+/// \brief textwolf iterator on a memory block followed by a padding of null bytes
+
+#ifndef __TEXTWOLF_PADDED_BUFFER_ITERATOR_HPP__
+#define __TEXTWOLF_PADDED_BUFFER_ITERATOR_HPP__
+#include "textwolf/traits.hpp"
+#include <string>
+#include <cstddef>
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class PaddedBufferIterator
+/// \brief Input iterator on a memory block of known size, that is followed by PaddingSize null bytes as sentinel
+/// \remark Unlike CStringIterator the iterator does not compare its position with the end on every byte read. The end of input is recognized by the scanner reading the null bytes of the padding as end of text. An incomplete character at the end of input swallows at most the bytes of the padding but the last one, so the scanner always reads a null byte before it leaves the padding
+/// \remark The input may contain null bytes, the scanner stops at the first one as with any other iterator
+class PaddedBufferIterator
+{
+public:
+	/// \brief Number of null bytes required after the end of the memory block (at least the maximum size of a character in bytes)
+	enum {PaddingSize=8};
+
+	/// \brief Default constructor
+	PaddedBufferIterator()
+		:m_src(0)
+		,m_itr(0)
+		,m_end(0){}
+
+	/// \brief Constructor
+	/// \param [in] src memory block to iterate on, followed by PaddingSize null bytes
+	/// \param [in] size size of the memory block in bytes without the padding
+	PaddedBufferIterator( const char* src, std::size_t size)
+		:m_src(src)
+		,m_itr(src)
+		,m_end(src+size){}
+
+	/// \brief Copy constructor
+	/// \param [in] o iterator to copy
+	PaddedBufferIterator( const PaddedBufferIterator& o)
+		:m_src(o.m_src)
+		,m_itr(o.m_itr)
+		,m_end(o.m_end){}
+
+	/// \brief Append the padding required to a buffer holding the input
+	/// \remark The iterator is constructed with the pointer to the buffer and the size of the buffer without the padding, e.g. PaddedBufferIterator( buf.c_str(), buf.size() - PaddingSize)
+	/// \param [in,out] buf buffer to append the padding to
+	static void appendPadding( std::string& buf)
+	{
+		buf.append( (std::size_t)PaddingSize, '\0');
+	}
+
+	/// \brief Element access
+	/// \return current character
+	inline char operator* () const
+	{
+		return *m_itr;
+	}
+
+	/// \brief Preincrement
+	inline PaddedBufferIterator& operator++()
+	{
+		++m_itr;
+		return *this;
+	}
+
+	inline int operator - (const PaddedBufferIterator& o) const
+	{
+		if (m_src != o.m_src) return 0;
+		return (int)(m_itr - o.m_itr);
+	}
+
+private:
+	friend struct traits::ContiguousSource<PaddedBufferIterator>;
+	const char* m_src;
+	const char* m_itr;
+	const char* m_end;
+};
+
+namespace traits {
+template <>
+struct ContiguousSource<PaddedBufferIterator>
+{
+	enum {FixedBlock=1};
+	static const char* block( const PaddedBufferIterator& itr, std::size_t& size)
+	{
+		size = (itr.m_end > itr.m_itr)?(itr.m_end - itr.m_itr):0;
+		return itr.m_itr;
+	}
+	static std::size_t offset( const PaddedBufferIterator& itr)
+	{
+		return itr.m_itr - itr.m_src;
+	}
+	static void advance( PaddedBufferIterator& itr, std::size_t n)
+	{
+		itr.m_itr += n;
+	}
+};
+}//namespace traits
+
+}//namespace
+#endif
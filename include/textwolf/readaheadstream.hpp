@@ -0,0 +1,451 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/readaheadstream.hpp
+/// \brief Input stream reading ahead in a background thread and iterator on its buffers
+
+#ifndef __TEXTWOLF_READ_AHEAD_STREAM_HPP__
+#define __TEXTWOLF_READ_AHEAD_STREAM_HPP__
+#include "textwolf/istreamiterator.hpp"
+#include "textwolf/thread.hpp"
+#include "textwolf/exception.hpp"
+#include "textwolf/position.hpp"
+#include "textwolf/traits.hpp"
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <cerrno>
+#include <new>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class FdInputStream
+/// \brief Input stream implementation reading from a file descriptor (file, pipe or socket)
+/// \remark The file descriptor is not closed by the stream
+class FdInputStream
+	:public IStream
+{
+public:
+	/// \brief Constructor
+	/// \param [in] fd_ file descriptor to read from
+	explicit FdInputStream( int fd_)
+		:m_fd(fd_),m_errno(0){}
+
+	virtual ~FdInputStream(){}
+	virtual std::size_t read( void* buf, std::size_t bufsize)
+	{
+		for (;;)
+		{
+#if defined(_WIN32)
+			int rt = ::_read( m_fd, buf, (unsigned int)(bufsize > (1U<<30) ? (1U<<30) : bufsize));
+#else
+			ssize_t rt = ::read( m_fd, buf, bufsize);
+#endif
+			if (rt >= 0)
+			{
+				m_errno = 0;
+				return (std::size_t)rt;
+			}
+			if (errno != EINTR)
+			{
+				m_errno = errno;
+				return 0;
+			}
+		}
+	}
+
+	virtual int errorcode() const
+	{
+		return m_errno;
+	}
+
+private:
+	int m_fd;
+	int m_errno;
+};
+
+
+/// \class ReadAheadStream
+/// \brief Input stream reading from another input stream ahead of the consumer in a background thread into a ring of buffers
+/// \remark The reader thread hands over the buffers filled to the consumer and the consumer gives them back through two atomic counters without locking (single producer single consumer queue). A thread only waits on a condition if the ring is empty (consumer) or full (reader), so that the latency of reading overlaps with scanning
+/// \remark The buffers are iterated without copying with ReadAheadIterator. The stream can also be read with read(void*,std::size_t) as any other IStream, copying the data. The two ways of reading must not be mixed
+/// \remark If no thread can be created (always with TEXTWOLF_NO_THREADS), the consumer reads the buffers itself when it needs them
+/// \remark The destructor stops the reader thread. It waits for a read of the source stream in progress to return
+class ReadAheadStream
+	:public IStream
+{
+public:
+	/// \brief Number of null bytes after the data read in every buffer (at least the maximum size of a character in bytes, see IStreamIterator)
+	enum {PaddingSize=8};
+
+	/// \brief Constructor
+	/// \param [in] source input stream to read from in the background, must not be used by anybody else as long as this stream exists
+	/// \param [in] bufsize size of a buffer in bytes
+	/// \param [in] nofBuffers number of buffers in the ring (at least 2 for reading ahead while the consumer holds a buffer)
+	ReadAheadStream( IStream* source, std::size_t bufsize=(1<<20), std::size_t nofBuffers=4)
+		:m_source(source)
+		,m_slots(0)
+		,m_nofSlots(nofBuffers?nofBuffers:1)
+		,m_bufsize(bufsize?bufsize:1)
+		,m_nofFilled(0)
+		,m_nofReleased(0)
+		,m_terminate(false)
+		,m_readerWaiting(false)
+		,m_consumerWaiting(false)
+		,m_holding(false)
+		,m_errno(0)
+		,m_readbuf(0)
+		,m_readsize(0)
+		,m_readpos(0)
+		,m_threaded(false)
+	{
+		m_slots = new Slot[ m_nofSlots];
+		for (std::size_t ii=0; ii<m_nofSlots; ++ii)
+		{
+			m_slots[ ii].buf = (char*)std::malloc( m_bufsize + PaddingSize);
+			if (!m_slots[ ii].buf)
+			{
+				freeSlots();
+				throw std::bad_alloc();
+			}
+		}
+		m_task.stream = this;
+		m_threaded = m_thread.tryStart( &m_task);
+	}
+
+	/// \brief Destructor
+	virtual ~ReadAheadStream()
+	{
+		atomicStore( m_terminate, true);
+		{
+			Mutex::Lock lock( m_mutex);
+			m_condition.signal();
+		}
+		m_thread.join();
+		freeSlots();
+	}
+
+	/// \brief Read data, copying it from the buffers read ahead
+	/// \return the number of bytes read, at most the rest of the current buffer, 0 at the end of data or on error
+	virtual std::size_t read( void* buf, std::size_t bufsize)
+	{
+		if (m_readpos >= m_readsize)
+		{
+			m_readbuf = nextBuffer( m_readsize);
+			m_readpos = 0;
+		}
+		std::size_t rt = m_readsize - m_readpos;
+		if (rt > bufsize) rt = bufsize;
+		std::memcpy( buf, m_readbuf + m_readpos, rt);
+		m_readpos += rt;
+		return rt;
+	}
+
+	/// \brief Get the error code of the source stream, if the reader stopped because of an error
+	virtual int errorcode() const
+	{
+		return m_errno;
+	}
+
+	/// \brief Give back the buffer held by the consumer and take the next buffer filled by the reader, waiting for it if it is not read yet
+	/// \param [out] size number of bytes in the buffer returned, 0 at the end of data or on error (see errorcode())
+	/// \return the buffer, followed by PaddingSize null bytes. It is valid until the next call of this method
+	const char* nextBuffer( std::size_t& size)
+	{
+		if (m_holding)
+		{
+			const Slot& held = m_slots[ m_nofReleased % m_nofSlots];
+			if (held.size == 0)
+			{
+				// ... the last buffer is kept at the end of data
+				size = 0;
+				return held.buf;
+			}
+			atomicStore( m_nofReleased, m_nofReleased + 1);
+			if (atomicLoad( m_readerWaiting))
+			{
+				Mutex::Lock lock( m_mutex);
+				m_condition.signal();
+			}
+			m_holding = false;
+		}
+		if (atomicLoad( m_nofFilled) == m_nofReleased)
+		{
+			if (m_threaded)
+			{
+				Mutex::Lock lock( m_mutex);
+				atomicStore( m_consumerWaiting, true);
+				while (atomicLoad( m_nofFilled) == m_nofReleased) m_condition.wait( m_mutex);
+				atomicStore( m_consumerWaiting, false);
+			}
+			else
+			{
+				fill( m_slots[ m_nofFilled % m_nofSlots]);
+				m_nofFilled = m_nofFilled + 1;
+			}
+		}
+		const Slot& slot = m_slots[ m_nofReleased % m_nofSlots];
+		m_holding = true;
+		m_errno = slot.errorcode;
+		size = slot.size;
+		return slot.buf;
+	}
+
+private:
+	/// \brief Buffer of the ring
+	struct Slot
+	{
+		char* buf;				///< data read followed by the padding
+		std::size_t size;			///< number of bytes read, 0 at the end of data or on error
+		int errorcode;				///< error code of the source stream
+
+		Slot()
+			:buf(0),size(0),errorcode(0){}
+	};
+
+	/// \brief Task of the reader thread
+	struct ReaderTask
+		:public Thread::Task
+	{
+		ReadAheadStream* stream;
+
+		ReaderTask()
+			:stream(0){}
+		virtual void run()
+		{
+			stream->readAhead();
+		}
+	};
+
+	/// \brief Read a buffer from the source stream
+	void fill( Slot& slot)
+	{
+		slot.size = m_source->read( slot.buf, m_bufsize);
+		slot.errorcode = m_source->errorcode();
+		if (slot.errorcode) slot.size = 0;
+		std::memset( slot.buf + slot.size, 0, PaddingSize);
+	}
+
+	/// \brief Fill the buffers of the ring ahead of the consumer until the end of data or until the stream is destroyed
+	void readAhead()
+	{
+		for (;;)
+		{
+			if (m_nofFilled - atomicLoad( m_nofReleased) >= m_nofSlots)
+			{
+				Mutex::Lock lock( m_mutex);
+				atomicStore( m_readerWaiting, true);
+				while (!atomicLoad( m_terminate) && m_nofFilled - atomicLoad( m_nofReleased) >= m_nofSlots) m_condition.wait( m_mutex);
+				atomicStore( m_readerWaiting, false);
+			}
+			if (atomicLoad( m_terminate)) return;
+			Slot& slot = m_slots[ m_nofFilled % m_nofSlots];
+			fill( slot);
+			atomicStore( m_nofFilled, m_nofFilled + 1);
+			if (atomicLoad( m_consumerWaiting))
+			{
+				Mutex::Lock lock( m_mutex);
+				m_condition.signal();
+			}
+			if (slot.size == 0) return;
+		}
+	}
+
+	void freeSlots()
+	{
+		for (std::size_t ii=0; ii<m_nofSlots; ++ii) std::free( m_slots[ ii].buf);
+		delete [] m_slots;
+		m_slots = 0;
+	}
+
+private:
+	ReadAheadStream( const ReadAheadStream&);		///< non copyable
+	ReadAheadStream& operator=( const ReadAheadStream&);	///< non copyable
+
+	IStream* m_source;				///< stream read by the reader thread
+	Slot* m_slots;					///< ring of buffers
+	std::size_t m_nofSlots;				///< number of buffers in the ring
+	std::size_t m_bufsize;				///< size of a buffer without the padding
+	volatile std::size_t m_nofFilled;		///< number of buffers filled, only written by the reader
+	volatile std::size_t m_nofReleased;		///< number of buffers given back, only written by the consumer
+	volatile bool m_terminate;			///< true, if the reader has to stop
+	volatile bool m_readerWaiting;			///< true, if the reader waits for a buffer given back
+	volatile bool m_consumerWaiting;		///< true, if the consumer waits for a buffer filled
+	bool m_holding;					///< true, if the consumer holds the buffer m_nofReleased
+	int m_errno;					///< error code of the buffer held by the consumer
+	const char* m_readbuf;				///< buffer read with read(void*,std::size_t)
+	std::size_t m_readsize;				///< size of m_readbuf
+	std::size_t m_readpos;				///< bytes of m_readbuf already read
+	Mutex m_mutex;					///< mutex for waiting on m_condition
+	Condition m_condition;				///< condition signalled by the reader or the consumer to the other waiting
+	ReaderTask m_task;				///< task of the reader thread
+	Thread m_thread;				///< reader thread
+	bool m_threaded;				///< true, if the reader thread runs, false if the consumer reads the buffers itself
+};
+
+
+/// \class ReadAheadIterator
+/// \brief Input iterator on the buffers of a ReadAheadStream, switching to the next buffer without copying
+/// \remark As in IStreamIterator the data of a buffer is followed by null bytes as sentinel and the end of the buffer is only checked when reading a null byte
+/// \remark Copies of the iterator share the stream and the current buffer. Only one of them must be used for reading on
+class ReadAheadIterator
+	:public throws_exception
+{
+public:
+	/// \brief Default constructor
+	ReadAheadIterator()
+		:m_input(0),m_buf(emptyBuffer()),m_readsize(0),m_readpos(0),m_abspos(0){}
+
+	/// \brief Constructor
+	/// \param [in] input stream to iterate on
+	explicit ReadAheadIterator( ReadAheadStream* input)
+		:m_input(input),m_buf(emptyBuffer()),m_readsize(0),m_readpos(0),m_abspos(0)
+	{
+		fillbuf();
+	}
+
+	/// \brief Copy constructor
+	/// \param [in] o iterator to copy
+	ReadAheadIterator( const ReadAheadIterator& o)
+		:m_input(o.m_input),m_buf(o.m_buf),m_readsize(o.m_readsize),m_readpos(o.m_readpos),m_abspos(o.m_abspos){}
+
+	/// \brief Element access
+	/// \return current character
+	inline char operator* ()
+	{
+		char ch = m_buf[m_readpos];
+		if (!ch && m_readpos >= m_readsize)
+		{
+			return nextbuf();
+		}
+		return ch;
+	}
+
+	/// \brief Pre increment
+	inline ReadAheadIterator& operator++()
+	{
+		++m_readpos;
+		return *this;
+	}
+
+	int operator - (const ReadAheadIterator& o) const
+	{
+		return (int)m_readpos - o.m_readpos;
+	}
+
+	PositionIndex position() const
+	{
+		return m_abspos + m_readpos;
+	}
+
+private:
+	void fillbuf()
+	{
+		m_abspos += m_readsize;
+		m_readpos = 0;
+		if (!m_input)
+		{
+			m_readsize = 0;
+			return;
+		}
+		m_buf = m_input->nextBuffer( m_readsize);
+		if (m_input->errorcode()) throw exception( FileReadError);
+	}
+
+	/// \brief Continue with the next buffer after the iterator reached the sentinel at or beyond the end of the data of the current buffer
+	/// \return the current character of the next buffer or 0 at the end of data
+	char nextbuf()
+	{
+		while (m_readsize && m_readpos >= m_readsize)
+		{
+			// ... the bytes skipped beyond the end of the buffer belong to the next buffer
+			std::size_t skipped = m_readpos - m_readsize;
+			fillbuf();
+			m_readpos = skipped;
+		}
+		if (!m_readsize)
+		{
+			// ... end of data, keep the iterator inside the padding
+			m_readpos = 0;
+			return 0;
+		}
+		return m_buf[m_readpos];
+	}
+
+	/// \brief Padding without data for the iterator constructed empty
+	static const char* emptyBuffer()
+	{
+		static const char ar[ ReadAheadStream::PaddingSize] = {0,0,0,0,0,0,0,0};
+		return ar;
+	}
+
+private:
+	friend struct traits::ContiguousSource<ReadAheadIterator>;
+	ReadAheadStream* m_input;
+	const char* m_buf;
+	std::size_t m_readsize;
+	std::size_t m_readpos;
+	PositionIndex m_abspos;
+};
+
+namespace traits {
+template <>
+struct ContiguousSource<ReadAheadIterator>
+{
+	enum {FixedBlock=0};
+	static const char* block( const ReadAheadIterator& itr, std::size_t& size)
+	{
+		size = (itr.m_readsize > itr.m_readpos)?(itr.m_readsize - itr.m_readpos):0;
+		return itr.m_buf + itr.m_readpos;
+	}
+	static std::size_t offset( const ReadAheadIterator& itr)
+	{
+		return (itr.m_readpos <= itr.m_readsize)?itr.m_readpos:0;
+	}
+	static void advance( ReadAheadIterator& itr, std::size_t n)
+	{
+		itr.m_readpos += n;
+		if (itr.m_readpos >= itr.m_readsize) itr.fillbuf();
+	}
+};
+}//namespace traits
+}//namespace
+#endif
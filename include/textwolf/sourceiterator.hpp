@@ -39,6 +39,7 @@
 #define __TEXTWOLF_SOURCE_ITERATOR_HPP__
 #include "textwolf/exception.hpp"
 #include "textwolf/position.hpp"
+#include "textwolf/traits.hpp"
 #include <cstdlib>
 #include <stdexcept>
 #include <setjmp.h>
@@ -129,6 +130,18 @@ public:
 		m_eom = eom;
 	}
 
+	/// \brief Move the iterator to a copy of the chunk it iterates on, if the chunk starts at a given address
+	/// \remark Used by a copy of XMLScanner to iterate on its own buffer instead of the one of the scanner copied
+	/// \param[in] buf pointer to start of the input passed with putInput(const char*,std::size_t,jmp_buf*)
+	/// \param[in] copy pointer to start of the copy of the input
+	void relocate( const char* buf, const char* copy)
+	{
+		if (m_start != buf) return;
+		m_itr = const_cast<char*>(copy) + (m_itr - m_start);
+		m_end = const_cast<char*>(copy) + (m_end - m_start);
+		m_start = const_cast<char*>(copy);
+	}
+
 	/// \brief Get the current position in the current chunk parsed
 	/// \remark Does not return the absolute position in the source parsed but the position in the chunk
 	std::size_t getPosition() const
@@ -147,6 +160,7 @@ public:
 	}
 
 private:
+	friend struct traits::ContiguousSource<SrcIterator>;
 	char* m_start;
 	char* m_itr;
 	char* m_end;
@@ -154,6 +168,197 @@ private:
 	PositionIndex m_abspos;
 };
 
+namespace traits {
+template <>
+struct ContiguousSource<SrcIterator>
+{
+	enum {FixedBlock=1};
+	static const char* block( const SrcIterator& itr, std::size_t& size)
+	{
+		size = (itr.m_end > itr.m_itr)?(itr.m_end - itr.m_itr):0;
+		return itr.m_itr;
+	}
+	static std::size_t offset( const SrcIterator& itr)
+	{
+		return itr.m_itr - itr.m_start;
+	}
+	static void advance( SrcIterator& itr, std::size_t n)
+	{
+		itr.m_itr += n;
+	}
+};
+
+template <>
+struct ChunkSource<SrcIterator>
+{
+	enum {Feedable=1};
+	enum {PaddingSize=0};
+};
+}//namespace traits
+
+
+/// \class PaddedSrcIterator
+/// \brief Input iterator as source for the XML scanner fed chunk by chunk like SrcIterator, with every chunk followed by PaddingSize null bytes as sentinel
+/// \remark Unlike SrcIterator the iterator does not compare its position with the end of the chunk on every byte read, but only when it reads a null byte. A null byte read at or beyond the end of the chunk triggers the longjmp or is returned as end of data as with SrcIterator. An incomplete character at the end of a chunk swallows at most the bytes of the padding but the last one, so the end of the chunk is always detected
+/// \remark The padding is not part of the chunk and is not scanned. It has to be provided by the caller, e.g. with a buffer of the chunk size plus PaddingSize bytes, where the bytes after the data read are set to 0
+class PaddedSrcIterator
+	:public throws_exception
+{
+public:
+	/// \brief Number of null bytes required after the end of every chunk passed (at least the maximum size of a character in bytes)
+	enum {PaddingSize=8};
+
+	/// \brief Empty constructor
+	/// \remark Iterates on an empty chunk (a padding without data), so that the first element access returns end of data
+	PaddedSrcIterator()
+		:m_start(const_cast<char*>(emptyChunk()))
+		,m_itr(m_start)
+		,m_end(m_start)
+		,m_eom(0)
+		,m_abspos(0){}
+
+	/// \brief Copy constructor
+	/// \param [in] o iterator to copy
+	PaddedSrcIterator( const PaddedSrcIterator& o)
+		:m_start(o.m_start)
+		,m_itr(o.m_itr)
+		,m_end(o.m_end)
+		,m_eom(o.m_eom)
+		,m_abspos(o.m_abspos){}
+
+	/// \brief Constructor
+	/// \param [in] buf source chunk to iterate on, followed by PaddingSize null bytes
+	/// \param [in] size size of source chunk to iterate on in bytes without the padding
+	/// \param [in] eom_ trigger to activate if end of data has been reached (no next chunk anymore)
+	PaddedSrcIterator( const char* buf, std::size_t size, jmp_buf* eom_=0)
+		:m_start(const_cast<char*>(buf))
+		,m_itr(const_cast<char*>(buf))
+		,m_end(m_itr+size)
+		,m_eom(eom_)
+		,m_abspos(0){}
+
+	/// \brief Assingment operator
+	PaddedSrcIterator& operator=( const PaddedSrcIterator& o)
+	{
+		m_start = o.m_start;
+		m_itr = o.m_itr;
+		m_end = o.m_end;
+		m_eom = o.m_eom;
+		m_abspos = o.m_abspos;
+		return *this;
+	}
+
+	/// \brief Element access operator (required by textwolf for an input iterator)
+	inline char operator*()
+	{
+		char ch = *m_itr;
+		if (!ch && m_itr >= m_end)
+		{
+			if (m_eom) longjmp(*m_eom,1);
+		}
+		return ch;
+	}
+
+	/// \brief Prefix increment operator (required by textwolf for an input iterator)
+	inline PaddedSrcIterator& operator++()
+	{
+		++m_itr;
+		return *this;
+	}
+
+	/// \brief Get the iterator difference in bytes
+	inline std::size_t operator-( const PaddedSrcIterator& b) const
+	{
+		if (b.m_end != m_end || m_itr < b.m_itr) throw exception( IllegalParam);
+		return m_itr - b.m_itr;
+	}
+
+	/// \brief Feed input to the source iterator
+	/// \param[in] buf poiner to start of input, followed by PaddingSize null bytes
+	/// \param[in] size size of input passed in bytes without the padding
+	/// \param[in] eom longjmp to call with parameter 1, if the end of data has been reached before EOF (null termination), eom=null, if the chunk passed contains the complete reset of the input and eof (null) can be returned if we reach the end
+	void putInput( const char* buf, std::size_t size, jmp_buf* eom=0)
+	{
+		m_abspos += size;
+		m_start = m_itr = const_cast<char*>(buf);
+		m_end = m_itr+size;
+		m_eom = eom;
+	}
+
+	/// \brief Move the iterator to a copy of the chunk it iterates on, if the chunk starts at a given address
+	/// \remark Used by a copy of XMLScanner to iterate on its own buffer instead of the one of the scanner copied
+	/// \param[in] buf pointer to start of the input passed with putInput(const char*,std::size_t,jmp_buf*)
+	/// \param[in] copy pointer to start of the copy of the input
+	void relocate( const char* buf, const char* copy)
+	{
+		if (m_start != buf) return;
+		m_itr = const_cast<char*>(copy) + (m_itr - m_start);
+		m_end = const_cast<char*>(copy) + (m_end - m_start);
+		m_start = const_cast<char*>(copy);
+	}
+
+	/// \brief Get the current position in the current chunk parsed
+	/// \remark Does not return the absolute position in the source parsed but the position in the chunk
+	std::size_t getPosition() const
+	{
+		return (m_end >= m_itr)?(m_itr-m_start):0;
+	}
+
+	PositionIndex position() const
+	{
+		return m_abspos - (m_end - m_itr);
+	}
+
+	bool endOfChunk() const
+	{
+		return (m_itr >= m_end);
+	}
+
+private:
+	/// \brief Padding without data for the iterator constructed empty
+	static const char* emptyChunk()
+	{
+		static const char ar[ PaddingSize] = {0,0,0,0,0,0,0,0};
+		return ar;
+	}
+
+private:
+	friend struct traits::ContiguousSource<PaddedSrcIterator>;
+	char* m_start;
+	char* m_itr;
+	char* m_end;
+	jmp_buf* m_eom;
+	PositionIndex m_abspos;
+};
+
+namespace traits {
+template <>
+struct ContiguousSource<PaddedSrcIterator>
+{
+	enum {FixedBlock=1};
+	static const char* block( const PaddedSrcIterator& itr, std::size_t& size)
+	{
+		size = (itr.m_end > itr.m_itr)?(itr.m_end - itr.m_itr):0;
+		return itr.m_itr;
+	}
+	static std::size_t offset( const PaddedSrcIterator& itr)
+	{
+		return itr.m_itr - itr.m_start;
+	}
+	static void advance( PaddedSrcIterator& itr, std::size_t n)
+	{
+		itr.m_itr += n;
+	}
+};
+
+template <>
+struct ChunkSource<PaddedSrcIterator>
+{
+	enum {Feedable=1};
+	enum {PaddingSize=PaddedSrcIterator::PaddingSize};
+};
+}//namespace traits
+
 }//namespace
 #endif
 
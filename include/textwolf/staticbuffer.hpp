@@ -41,6 +41,7 @@
 #include <cstddef>
 #include <cstring>
 #include <cstdlib>
+#include <string>
 #include <stdexcept>
 #include <new>
 
@@ -176,5 +177,28 @@ private:
 	bool m_overflow;			///< true, if an array bounds write would have happened with push_back
 };
 
+/// \brief Append an array of characters to a back insertion sequence
+/// \tparam Buffer STL back insertion sequence
+/// \param[in,out] buf the buffer to append to
+/// \param[in] cc the characters to append
+/// \param[in] ccsize the number of characters to append
+template <class Buffer>
+inline void appendBytes( Buffer& buf, const char* cc, std::size_t ccsize)
+{
+	for (std::size_t ii=0; ii<ccsize; ++ii) buf.push_back( cc[ii]);
+}
+
+/// \brief Append an array of characters to a string (see appendBytes(Buffer&,const char*,std::size_t))
+inline void appendBytes( std::string& buf, const char* cc, std::size_t ccsize)
+{
+	buf.append( cc, ccsize);
+}
+
+/// \brief Append an array of characters to a static buffer (see appendBytes(Buffer&,const char*,std::size_t))
+inline void appendBytes( StaticBuffer& buf, const char* cc, std::size_t ccsize)
+{
+	buf.append( cc, ccsize);
+}
+
 }//namespace
 #endif
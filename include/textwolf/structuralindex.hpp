@@ -0,0 +1,438 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this context refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/structuralindex.hpp
+/// \brief Index of the structural bytes of an XML document in memory (stage one of XMLStructuralScanner), computed 64 bytes at a time, vectorized with SSE2/AVX2 if available
+
+#ifndef __TEXTWOLF_STRUCTURAL_INDEX_HPP__
+#define __TEXTWOLF_STRUCTURAL_INDEX_HPP__
+#include "textwolf/char.hpp"
+#include "textwolf/bytescan.hpp"
+#include "textwolf/charset_utf8.hpp"
+#include "textwolf/textscanner.hpp"
+#include "textwolf/xmlscanner.hpp"
+#include <vector>
+#include <cstring>
+#include <cstddef>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class XMLStructuralIndex
+/// \brief Bitmaps of the structural bytes and of the quoted regions of a window of a UTF-8 XML document in memory (stage one of XMLStructuralScanner)
+/// \remark The document is divided into content, markup (between '&lt;' and '&gt;') and quoted regions (strings in markup). A byte is structural, if it terminates a token of the XML scanner in its region: '&lt;', '&amp;', carriage return and end of text in content, every byte that is not part of a name in markup, the closing quote, '&lt;', '&amp;', carriage return and end of text in a quoted region. A byte terminating a region belongs to the region it terminates
+/// \remark The bitmaps of the delimiters are computed with vector comparisons 64 bytes at a time. The regions are resolved with a scalar walk over the delimiters changing the region, so the cost of the walk is the number of region changes. The walk does not know comments, processing instructions and CDATA sections, XMLStructuralScanner checks the region at every position it continues scanning along the index at, and rebuilds the index there, if it does not match
+/// \remark The index is built for a window of the document growing from MinWindowSize to MaxWindowSize bytes, so that a rebuild is cheap and the memory used is bounded
+class XMLStructuralIndex
+{
+public:
+	/// \brief Region of the document a byte is in
+	enum Region
+	{
+		Content,			///< content outside markup
+		Markup,				///< markup between '&lt;' and '&gt;' outside quoted strings
+		Quoted				///< quoted string in markup
+	};
+	enum
+	{
+		BlockSize=64,			///< number of bytes of a block described by one bitmap word
+		MinWindowSize=4096,		///< size of the window built at a new start position
+		MaxWindowSize=65536		///< maximum size of the window the window size doubles to with every following window
+	};
+	/// \brief Bitmap of a block, bit N describes the byte N of the block
+	typedef EChar BlockMask;
+
+	/// \brief Constructor
+	/// \param [in] src pointer to the document
+	/// \param [in] srcsize size of the document in bytes
+	XMLStructuralIndex( const char* src, std::size_t srcsize)
+		:m_src(src)
+		,m_srcsize(srcsize)
+		,m_start(0)
+		,m_end(0)
+		,m_windowSize(0)
+		,m_region(Content)
+		,m_quote(0)
+		,m_irregular(false)
+		,m_structural(MaxWindowSize/BlockSize)
+		,m_markup(MaxWindowSize/BlockSize)
+		,m_quoted(MaxWindowSize/BlockSize)
+	{}
+
+	/// \brief Build the index of a window of MinWindowSize bytes
+	/// \param [in] start_ start position of the window in the document
+	/// \param [in] region_ region of the byte at the start position (Content or Markup)
+	void build( std::size_t start_, Region region_)
+	{
+		m_region = region_;
+		m_quote = 0;
+		buildWindow( start_, MinWindowSize);
+	}
+
+	/// \brief Build the index of the window following the current one, continuing with the region at the end of the current one
+	void buildNext()
+	{
+		buildWindow( m_end, (m_windowSize < MaxWindowSize)?(m_windowSize * 2):(std::size_t)MaxWindowSize);
+	}
+
+	/// \brief Get the start position of the window indexed
+	std::size_t start() const
+	{
+		return m_start;
+	}
+
+	/// \brief Get the end position of the window indexed
+	std::size_t end() const
+	{
+		return m_end;
+	}
+
+	/// \brief Evaluate if the window indexed contains a UTF-8 lead byte that is not followed by the continuation bytes of its character
+	/// \remark The lax UTF-8 decoding of the XML scanner swallows the bytes following a lead byte whatever they are, the region and the structural bytes of such a window cannot be resolved byte by byte
+	bool irregular() const
+	{
+		return m_irregular;
+	}
+
+	/// \brief Evaluate if a position is in the window indexed
+	/// \param [in] pos position in the document
+	bool covers( std::size_t pos) const
+	{
+		return pos >= m_start && pos < m_end;
+	}
+
+	/// \brief Get the region of a byte in the window indexed
+	/// \param [in] pos position in the document, covered by the window
+	Region region( std::size_t pos) const
+	{
+		std::size_t ofs = pos - m_start;
+		BlockMask bit = (BlockMask)1 << (ofs % BlockSize);
+		if ((m_markup[ ofs / BlockSize] & bit) != 0) return Markup;
+		if ((m_quoted[ ofs / BlockSize] & bit) != 0) return Quoted;
+		return Content;
+	}
+
+	/// \brief Evaluate if a byte in the window indexed is structural
+	/// \param [in] pos position in the document, covered by the window
+	bool structural( std::size_t pos) const
+	{
+		std::size_t ofs = pos - m_start;
+		return ((m_structural[ ofs / BlockSize] >> (ofs % BlockSize)) & 1) != 0;
+	}
+
+	/// \brief Find the next structural byte in the window indexed
+	/// \param [in] pos position in the document to start the search at, covered by the window
+	/// \return the position of the first structural byte at or after 'pos' or end(), if there is none in the window
+	std::size_t next( std::size_t pos) const
+	{
+		std::size_t ofs = pos - m_start;
+		std::size_t bi = ofs / BlockSize;
+		std::size_t nofBlocks = (m_end - m_start + BlockSize - 1) / BlockSize;
+		BlockMask mask = m_structural[ bi] & (~(BlockMask)0 << (ofs % BlockSize));
+		while (!mask)
+		{
+			if (++bi == nofBlocks) return m_end;
+			mask = m_structural[ bi];
+		}
+		std::size_t rt = m_start + bi * BlockSize + lowestBit( mask);
+		// ... the bytes after the end of the document in the last block are indexed as end of text
+		return (rt < m_end)?rt:m_end;
+	}
+
+private:
+	/// \class BlockMasks
+	/// \brief Bitmaps of the delimiters in a block changing the region or terminating a token in every region
+	struct BlockMasks
+	{
+		BlockMask lt;			///< '&lt;'
+		BlockMask gt;			///< '&gt;'
+		BlockMask sq;			///< single quote
+		BlockMask dq;			///< double quote
+		BlockMask special;		///< '&amp;', carriage return and end of text
+		BlockMask high;			///< bytes [0x80..0xFF]
+	};
+
+	/// \brief Build the index of a window
+	/// \param [in] start_ start position of the window in the document
+	/// \param [in] windowsize size of the window in bytes (a multiple of BlockSize)
+	void buildWindow( std::size_t start_, std::size_t windowsize)
+	{
+		m_start = start_;
+		m_end = (m_srcsize - m_start > windowsize)?(m_start + windowsize):m_srcsize;
+		m_windowSize = windowsize;
+		m_irregular = false;
+		std::size_t bi = 0;
+		for (std::size_t pos = m_start; pos < m_end; pos += BlockSize, ++bi)
+		{
+			const char* blk = m_src + pos;
+			char buf[ BlockSize];
+			if (m_end - pos < (std::size_t)BlockSize)
+			{
+				// ... last block of the document, padded with end of text
+				std::memset( buf, 0, sizeof(buf));
+				std::memcpy( buf, blk, m_end - pos);
+				blk = buf;
+			}
+			BlockMasks masks;
+			classify( blk, masks);
+			resolveRegions( blk, masks, m_structural[ bi], m_markup[ bi], m_quoted[ bi]);
+			if (masks.high && !checkLeads( pos, leadBytes( blk))) m_irregular = true;
+		}
+	}
+
+	/// \brief Resolve the regions of a block and the structural bytes in them, continuing with the region at the end of the block before
+	/// \param [in] blk pointer to the block
+	/// \param [in] masks bitmaps of the delimiters in the block
+	/// \param [out] structural bitmap of the structural bytes
+	/// \param [out] markup bitmap of the bytes in markup
+	/// \param [out] quoted bitmap of the bytes in quoted strings
+	void resolveRegions( const char* blk, const BlockMasks& masks, BlockMask& structural, BlockMask& markup, BlockMask& quoted)
+	{
+		BlockMask tokenDelim = masks.lt | masks.special;
+		BlockMask nameDelim = 0;
+		bool nameDelimResolved = false;
+		structural = 0;
+		markup = 0;
+		quoted = 0;
+		unsigned int pos = 0;
+		for (;;)
+		{
+			BlockMask from = ~(BlockMask)0 << pos;
+			BlockMask events;
+			switch (m_region)
+			{
+				case Content: events = masks.lt; break;
+				case Markup: events = masks.gt | masks.sq | masks.dq; break;
+				default: events = (m_quote == '\'')?masks.sq:masks.dq; break;
+			}
+			events &= from;
+			unsigned int ee = events?lowestBit( events):(unsigned int)BlockSize;
+			BlockMask part = (ee < (unsigned int)BlockSize)?(from & ((((BlockMask)2) << ee) - 1)):from;
+			switch (m_region)
+			{
+				case Content:
+					structural |= part & tokenDelim;
+					if (events) m_region = Markup;
+					break;
+				case Markup:
+					if (!nameDelimResolved)
+					{
+						// ... the delimiters of names are only needed in blocks with markup
+						nameDelim = nameDelimiters( blk);
+						nameDelimResolved = true;
+					}
+					structural |= part & nameDelim;
+					markup |= part;
+					if (events)
+					{
+						BlockMask bit = (BlockMask)1 << ee;
+						if (masks.gt & bit)
+						{
+							m_region = Content;
+						}
+						else
+						{
+							m_region = Quoted;
+							m_quote = (masks.sq & bit)?'\'':'\"';
+						}
+					}
+					break;
+				default:
+					structural |= part & (tokenDelim | ((m_quote == '\'')?masks.sq:masks.dq));
+					quoted |= part;
+					if (events) m_region = Markup;
+					break;
+			}
+			if (ee >= (unsigned int)BlockSize - 1) return;
+			pos = ee + 1;
+		}
+	}
+
+	/// \brief Check that the UTF-8 lead bytes of a block are followed by the continuation bytes of their character in the document
+	/// \param [in] blkpos position of the block in the document
+	/// \param [in] lead bitmap of the lead bytes in the block
+	/// \return true, if all characters are complete
+	bool checkLeads( std::size_t blkpos, BlockMask lead) const
+	{
+		while (lead)
+		{
+			std::size_t pos = blkpos + lowestBit( lead);
+			std::size_t len = charset::UTF8::charLength( (unsigned char)m_src[ pos]);
+			if (m_srcsize - pos < len) return false;
+			for (std::size_t ii=1; ii<len; ++ii)
+			{
+				if (((unsigned char)m_src[ pos+ii] & 0xC0) != 0x80) return false;
+			}
+			lead &= lead - 1;
+		}
+		return true;
+	}
+
+#if defined(TEXTWOLF_SIMD_AVX2)
+	enum {VectorSize=32};
+	typedef __m256i Vector;
+
+	static Vector load( const char* src)			{return _mm256_loadu_si256( (const __m256i*)src);}
+	static Vector eq( Vector a, char ch)			{return _mm256_cmpeq_epi8( a, _mm256_set1_epi8( ch));}
+	static Vector unite( Vector a, Vector b)			{return _mm256_or_si256( a, b);}
+	static Vector andnot( Vector a, Vector b)		{return _mm256_andnot_si256( a, b);}
+	static Vector lessEqual( Vector a, char ch)		{return _mm256_cmpeq_epi8( _mm256_min_epu8( a, _mm256_set1_epi8( ch)), a);}
+	static Vector greaterEqual( Vector a, char ch)		{return _mm256_cmpeq_epi8( _mm256_max_epu8( a, _mm256_set1_epi8( ch)), a);}
+	static BlockMask bits( Vector a, unsigned int ofs)	{return (BlockMask)(unsigned int)_mm256_movemask_epi8( a) << ofs;}
+#elif defined(TEXTWOLF_SIMD_SSE2)
+	enum {VectorSize=16};
+	typedef __m128i Vector;
+
+	static Vector load( const char* src)			{return _mm_loadu_si128( (const __m128i*)src);}
+	static Vector eq( Vector a, char ch)			{return _mm_cmpeq_epi8( a, _mm_set1_epi8( ch));}
+	static Vector unite( Vector a, Vector b)			{return _mm_or_si128( a, b);}
+	static Vector andnot( Vector a, Vector b)		{return _mm_andnot_si128( a, b);}
+	static Vector lessEqual( Vector a, char ch)		{return _mm_cmpeq_epi8( _mm_min_epu8( a, _mm_set1_epi8( ch)), a);}
+	static Vector greaterEqual( Vector a, char ch)		{return _mm_cmpeq_epi8( _mm_max_epu8( a, _mm_set1_epi8( ch)), a);}
+	static BlockMask bits( Vector a, unsigned int ofs)	{return (BlockMask)(unsigned int)_mm_movemask_epi8( a) << ofs;}
+#endif
+
+	/// \brief Compute the bitmaps of the delimiters in a block of BlockSize bytes
+	/// \param [in] src pointer to the block
+	/// \param [out] masks the bitmaps
+	static void classify( const char* src, BlockMasks& masks)
+	{
+		masks.lt = masks.gt = masks.sq = masks.dq = masks.special = masks.high = 0;
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+		for (unsigned int ofs=0; ofs<(unsigned int)BlockSize; ofs+=VectorSize)
+		{
+			Vector blk = load( src + ofs);
+			masks.lt |= bits( eq( blk, '<'), ofs);
+			masks.gt |= bits( eq( blk, '>'), ofs);
+			masks.sq |= bits( eq( blk, '\''), ofs);
+			masks.dq |= bits( eq( blk, '\"'), ofs);
+			masks.special |= bits( unite( unite( eq( blk, '&'), eq( blk, '\r')), eq( blk, 0)), ofs);
+			masks.high |= bits( blk, ofs);
+		}
+#else
+		for (unsigned int ii=0; ii<(unsigned int)BlockSize; ++ii)
+		{
+			unsigned char ch = (unsigned char)src[ ii];
+			BlockMask bit = (BlockMask)1 << ii;
+			switch (ch)
+			{
+				case '<': masks.lt |= bit; break;
+				case '>': masks.gt |= bit; break;
+				case '\'': masks.sq |= bit; break;
+				case '\"': masks.dq |= bit; break;
+				case '&': case '\r': case 0: masks.special |= bit; break;
+				default: if (ch >= 0x80) masks.high |= bit; break;
+			}
+		}
+#endif
+	}
+
+	/// \brief Compute the bitmap of the bytes that are not part of a name in markup in a block of BlockSize bytes (see XMLScannerTables::tokenRun of ReturnIdentifier)
+	/// \param [in] src pointer to the block
+	static BlockMask nameDelimiters( const char* src)
+	{
+		BlockMask rt = 0;
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+		for (unsigned int ofs=0; ofs<(unsigned int)BlockSize; ofs+=VectorSize)
+		{
+			Vector blk = load( src + ofs);
+			// ... control characters and space except 0x05, that is not a control character for the XML scanner (see ControlCharTable)
+			Vector delim = andnot( eq( blk, 0x05), lessEqual( blk, 0x20));
+			delim = unite( delim, unite( unite( eq( blk, '!'), eq( blk, '\"')), unite( eq( blk, '&'), eq( blk, '\''))));
+			delim = unite( delim, unite( unite( eq( blk, '/'), eq( blk, '<')), unite( eq( blk, '='), eq( blk, '>'))));
+			delim = unite( delim, unite( eq( blk, '?'), unite( eq( blk, '['), eq( blk, ']'))));
+			rt |= bits( delim, ofs);
+		}
+#else
+		typedef XMLScannerTables<> Tables;
+		for (unsigned int ii=0; ii<(unsigned int)BlockSize; ++ii)
+		{
+			if (Tables::tokenRun[ XMLScannerBase::ReturnIdentifier][ (unsigned char)src[ ii]]) rt |= (BlockMask)1 << ii;
+		}
+#endif
+		return rt;
+	}
+
+	/// \brief Compute the bitmap of the UTF-8 lead bytes [0xC0..0xFF] in a block of BlockSize bytes
+	/// \param [in] src pointer to the block
+	static BlockMask leadBytes( const char* src)
+	{
+		BlockMask rt = 0;
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+		for (unsigned int ofs=0; ofs<(unsigned int)BlockSize; ofs+=VectorSize)
+		{
+			rt |= bits( greaterEqual( load( src + ofs), (char)0xC0), ofs);
+		}
+#else
+		for (unsigned int ii=0; ii<(unsigned int)BlockSize; ++ii)
+		{
+			if ((unsigned char)src[ ii] >= 0xC0) rt |= (BlockMask)1 << ii;
+		}
+#endif
+		return rt;
+	}
+
+	/// \brief Get the index of the lowest bit set in a non zero mask
+	static unsigned int lowestBit( BlockMask mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long rt;
+		if (_BitScanForward( &rt, (unsigned long)(mask & 0xFFFFFFFFU))) return (unsigned int)rt;
+		_BitScanForward( &rt, (unsigned long)(mask >> 32));
+		return (unsigned int)rt + 32;
+#else
+		return (unsigned int)__builtin_ctzll( mask);
+#endif
+	}
+
+private:
+	const char* m_src;			///< pointer to the document
+	std::size_t m_srcsize;			///< size of the document in bytes
+	std::size_t m_start;			///< start position of the window indexed
+	std::size_t m_end;			///< end position of the window indexed
+	std::size_t m_windowSize;		///< size of the window indexed (without cutting it at the end of the document)
+	Region m_region;			///< region at the end of the window indexed
+	char m_quote;				///< quote of the string, if m_region is Quoted
+	bool m_irregular;			///< true, if the window indexed contains an incomplete UTF-8 character
+	std::vector<BlockMask> m_structural;	///< bitmaps of the structural bytes per block
+	std::vector<BlockMask> m_markup;	///< bitmaps of the bytes in markup per block
+	std::vector<BlockMask> m_quoted;	///< bitmaps of the bytes in quoted strings per block
+};
+
+}//namespace
+#endif
@@ -39,11 +39,49 @@
 
 #include "textwolf/char.hpp"
 #include "textwolf/charset_interface.hpp"
+#include "textwolf/charset_utf8.hpp"
+#include "textwolf/charset_singlebyte.hpp"
+#include "textwolf/utf16transcoder.hpp"
+#include "textwolf/widecharscanner.hpp"
 #include "textwolf/exception.hpp"
+#include "textwolf/staticbuffer.hpp"
+#include "textwolf/bytescan.hpp"
+#include "textwolf/traits.hpp"
 #include <cstddef>
 
 namespace textwolf {
 
+/// \class ControlCharTable
+/// \brief Constant table mapping ASCII characters to control character identifiers (the same mapping as TextScanner::ControlCharMap)
+/// \remark The table is constant initialized data, so there is no initialization on first use
+/// \tparam Dummy_ dummy template parameter for having the definition of the table in the header
+template <int Dummy_=0>
+struct ControlCharTable
+{
+	static const ControlCharacter ar[ 256];
+};
+
+template <int Dummy_>
+const ControlCharacter ControlCharTable<Dummy_>::ar[ 256] =
+{
+	EndOfText,Cntrl,Cntrl,Cntrl,Cntrl,Undef,Cntrl,Cntrl,Cntrl,Space,EndOfLine,Cntrl,Cntrl,Space,Cntrl,Cntrl,	// 0x00..0x0F
+	Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,Cntrl,	// 0x10..0x1F
+	Space,Exclam,Dq,Any,Any,Any,Amp,Sq,Any,Any,Any,Any,Any,Dash,Any,Slash,	// 0x20..0x2F
+	Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Lt,Equal,Gt,Questm,	// 0x30..0x3F
+	Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,	// 0x40..0x4F
+	Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Osb,Any,Csb,Any,Any,	// 0x50..0x5F
+	Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,	// 0x60..0x6F
+	Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,Any,	// 0x70..0x7F
+	Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,	// 0x80..0x8F
+	Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,	// 0x90..0x9F
+	Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,	// 0xA0..0xAF
+	Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,	// 0xB0..0xBF
+	Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,	// 0xC0..0xCF
+	Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,	// 0xD0..0xDF
+	Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,	// 0xE0..0xEF
+	Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef,Undef	// 0xF0..0xFF
+};
+
 /// \class TextScanner
 /// \brief Reader for scanning the input character by character
 /// \tparam Iterator source iterator type (implements preincrement and '*' input byte access indirection)
@@ -63,6 +101,7 @@ private:
 public:
 	/// \class ControlCharMap
 	/// \brief Map of ASCII characters to control character identifiers used in the XML scanner automaton
+	/// \remark The scanner uses the constant table ControlCharTable defining the same mapping
 	struct ControlCharMap  :public CharMap<ControlCharacter,Undef>
 	{
 		ControlCharMap()
@@ -133,6 +172,18 @@ public:
 		start = a;
 	}
 
+	/// \brief Restart scanning with a new source, keeping the character set
+	/// \param [in] a source iterator assignment
+	template <class IteratorAssignment>
+	void restart( const IteratorAssignment& a)
+	{
+		input = a;
+		start = a;
+		val = 0;
+		cur = 0;
+		state = 0;
+	}
+
 	/// \brief Get the current source iterator position
 	/// \return source iterator position in character words (usually bytes)
 	std::size_t getPosition() const
@@ -197,13 +248,84 @@ public:
 		}
 	}
 
+	/// \brief Direct copy of a run of characters up to the next delimiter from input to output without encoding/decoding them
+	/// \remark Copies only if the source iterator iterates on a memory block (see traits::ContiguousSource), the character set encoding is byte oriented or has wide code units searched with WideCharScanner and the character sets fulfill is_equal(..). Otherwise nothing is copied and the characters have to be processed one by one
+	/// \remark Must be called at the start of a character (after skip())
+	/// \param [in] delim set of bytes that terminate the run, containing at least 0
+	/// \param [in] output_ character set encoding of the output
+	/// \param [out] buf_ buffer to append the run to
+	/// \return the number of bytes copied
+	template <class Buffer>
+	inline std::size_t copyRun( const ByteScanTable& delim, const CharSet& output_, Buffer& buf_)
+	{
+		return copyRun_impl( delim, output_, buf_, traits::TypeCheck::is_true<((int)CharSet::CodeUnitSize == 1)>::type());
+	}
+
+	/// \brief Print a run of ASCII characters up to the next delimiter or non ASCII byte from input to an output of a different character set encoding without decoding them one by one
+	/// \remark Prints only if the character set encoding of the input is UTF-8 and the source iterator iterates on a memory block (see traits::ContiguousSource). Otherwise nothing is printed and the characters have to be processed one by one
+	/// \remark Must be called at the start of a character (after skip())
+	/// \param [in] delim set of bytes that terminate the run, containing at least 0
+	/// \param [in] output_ character set encoding of the output
+	/// \param [out] buf_ buffer to print the run to
+	/// \return the number of bytes consumed
+	template <class OutputCharSet, class Buffer>
+	inline std::size_t printAsciiRun( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_)
+	{
+		return printAsciiRun_impl( delim, output_, buf_, traits::TypeCheck::is_same<CharSet,charset::UTF8>::type());
+	}
+
+	/// \brief Print a run of characters up to the next delimiter from input to an output of a different character set encoding
+	/// \remark Converts the run in bulk with UTF16Transcoder for UTF-16 input and UTF-8 output or vice versa, decodes the run with the table of the code page for single byte code page input (see charset::SingleByteCharSetCheck) and with WideCharScanner for UTF-16, UCS-2 and UCS-4 input (see WideCharScanning), prints a run of ASCII characters with printAsciiRun(const ByteScanTable&,const OutputCharSet&,Buffer&) for the other pairs of character set encodings. Only possible if the source iterator iterates on a memory block (see traits::ContiguousSource), otherwise nothing is printed and the characters have to be processed one by one
+	/// \remark Must be called at the start of a character (after skip())
+	/// \param [in] delim set of bytes that terminate the run, containing at least 0. Characters beyond the ASCII range terminate the run, if 0x80 is in the set
+	/// \param [in] output_ character set encoding of the output
+	/// \param [out] buf_ buffer to print the run to
+	/// \return the number of bytes consumed
+	template <class OutputCharSet, class Buffer>
+	inline std::size_t printRun( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_)
+	{
+		return printRun_impl( delim, output_, buf_, typename UTF16Transcoding<CharSet,OutputCharSet>::Direction());
+	}
+
+	/// \brief Get the run of characters from the current character up to the next delimiter as a span in the source without copying it
+	/// \remark Only possible if the source iterator iterates on a memory block (see traits::ContiguousSource), the character set encoding is byte oriented and the delimiter terminating the run is found in the current block
+	/// \param [in] delim set of bytes that terminate the run, containing at least 0
+	/// \param [in] output_ character set encoding of the output the run is used for
+	/// \param [out] ptr_ pointer to the start of the run in the source, ptr_[size_] is the delimiter byte terminating the run
+	/// \param [out] size_ size of the run in bytes
+	/// \return true on success, false if the run has to be processed character by character
+	inline bool getRun( const ByteScanTable& delim, const CharSet& output_, const char*& ptr_, std::size_t& size_) const
+	{
+		return getRun_impl( delim, output_, ptr_, size_, traits::TypeCheck::is_true<((int)CharSet::CodeUnitSize == 1)>::type());
+	}
+
+	/// \brief Skip a run returned by getRun(const ByteScanTable&,const CharSet&,const char*&,std::size_t&)
+	/// \param [in] size_ size of the run in bytes
+	inline void skipRun( std::size_t size_)
+	{
+		if (!size_) return;
+		traits::ContiguousSource<Iterator>::advance( input, size_ - state);
+		state = 0;
+		cur = 0;
+		val = 0;
+	}
+
+	/// \brief Evaluate if all bytes of the current source memory block have been consumed and no byte of the current character has been fetched yet
+	/// \remark Always true for source iterators not iterating on a memory block (see traits::ContiguousSource)
+	/// \return true, if yes
+	inline bool endOfBlock() const
+	{
+		std::size_t blksize;
+		traits::ContiguousSource<Iterator>::block( input, blksize);
+		return state == 0 && blksize == 0;
+	}
+
 	/// \brief Get the control character representation of the current character
 	/// \return the control character
 	inline ControlCharacter control()
 	{
-		static ControlCharMap controlCharMap;
 		getcur();
-		return controlCharMap[ (unsigned char)cur];
+		return ControlCharTable<>::ar[ (unsigned char)cur];
 	}
 
 	/// \brief Get the ASCII character representation of the current character
@@ -238,6 +360,610 @@ public:
 	/// \brief Postincrement: Skip to the next character of the source
 	/// \return *this
 	inline TextScanner operator ++(int)	{TextScanner tmp(*this); skip(); return tmp;}
+
+private:
+	bool getRun_impl( const ByteScanTable&, const CharSet&, const char*&, std::size_t&, const traits::TypeCheck::NO&) const
+	{
+		return false;
+	}
+
+	bool getRun_impl( const ByteScanTable& delim, const CharSet& output_, const char*& ptr_, std::size_t& size_, const traits::TypeCheck::YES&) const
+	{
+		typedef traits::ContiguousSource<Iterator> Source;
+		if (!CharSet::is_equal( charset, output_)) return false;
+		std::size_t blksize;
+		const char* blk = Source::block( input, blksize);
+		// ... the bytes of the current character already fetched must be in the same block
+		if (!blk || Source::offset( input) < state) return false;
+
+		const char* start = blk - state;
+		const char* end;
+		if (blksize == (std::size_t)-1)
+		{
+			end = delim.findz( start);
+		}
+		else
+		{
+			end = delim.find( start, blk + blksize);
+			if (end == blk + blksize) return false;
+		}
+		size_ = end - start;
+		if (CharSet::completeSize( start, size_) != size_) return false;
+		ptr_ = start;
+		return true;
+	}
+
+	/// \brief Process a run of characters up to the next delimiter block by block
+	/// \remark The source iterator may provide the run in more than one block. The run is continued in the next block only if it reaches the end of the current one
+	/// \param [in,out] proc run processor with the methods runSize(const char* blk,const char* blkend) returning the size of the run in a block (blkend is NULL for a null terminated block) and emit(const char* run,std::size_t size) writing the run to the output and returning the number of bytes consumed
+	/// \return the number of bytes consumed
+	template <class RunProcessor>
+	std::size_t processRun( RunProcessor& proc)
+	{
+		typedef traits::ContiguousSource<Iterator> Source;
+		if (state != 0) return 0;
+		std::size_t rt = 0;
+		for (;;)
+		{
+			std::size_t blksize;
+			const char* blk = Source::block( input, blksize);
+			if (!blk || !blksize) break;
+
+			bool nullterminated = (blksize == (std::size_t)-1);
+			std::size_t runsize = proc.runSize( blk, nullterminated ? 0 : (blk + blksize));
+			std::size_t nn = runsize ? proc.emit( blk, runsize) : 0;
+			if (!nn) break;
+
+			Source::advance( input, nn);
+			rt += nn;
+			// ... continue only if the run reaches the end of the block and the source iterator may provide a next one
+			if (nullterminated || nn != blksize) break;
+		}
+		return rt;
+	}
+
+	/// \class RunCopier
+	/// \brief Run processor copying the complete characters of a run without decoding them
+	/// \tparam Scanner scanner finding the delimiters (ByteScanTable for byte oriented input, WideCharScanner for code units of 2 or 4 bytes)
+	template <class Scanner, class Buffer>
+	struct RunCopier
+	{
+		const ByteScanTable& delim;
+		Buffer& buf;
+
+		RunCopier( const ByteScanTable& delim_, Buffer& buf_)	:delim(delim_),buf(buf_){}
+
+		std::size_t runSize( const char* blk, const char* blkend) const
+		{
+			return CharSet::completeSize( blk, Scanner::findDelimiter( delim, blk, blkend) - blk);
+		}
+		std::size_t emit( const char* run, std::size_t size)
+		{
+			appendBytes( buf, run, size);
+			return size;
+		}
+	};
+
+	/// \class RunDecoder
+	/// \brief Run processor printing a run decoded a chunk of characters at a time
+	/// \tparam Decoder decoder with the methods findRunEnd(const ByteScanTable&,const char*,const char*) and decode(const char*,std::size_t,UChar*,std::size_t,std::size_t&) returning the number of bytes decoded
+	template <class Decoder, class OutputCharSet, class Buffer>
+	struct RunDecoder
+	{
+		enum {ChunkSize=128};
+		const ByteScanTable& delim;
+		const Decoder& decoder;
+		const OutputCharSet& output;
+		Buffer& buf;
+
+		RunDecoder( const ByteScanTable& delim_, const Decoder& decoder_, const OutputCharSet& output_, Buffer& buf_)
+			:delim(delim_),decoder(decoder_),output(output_),buf(buf_){}
+
+		std::size_t runSize( const char* blk, const char* blkend) const
+		{
+			return decoder.findRunEnd( delim, blk, blkend) - blk;
+		}
+		std::size_t emit( const char* run, std::size_t size)
+		{
+			UChar tmp[ ChunkSize];
+			std::size_t nn = 0;
+			while (nn < size)
+			{
+				std::size_t nofchars;
+				std::size_t consumed = decoder.decode( run + nn, size - nn, tmp, ChunkSize, nofchars);
+				if (!consumed) break;
+				output.print( tmp, tmp + nofchars, buf);
+				nn += consumed;
+			}
+			return nn;
+		}
+	};
+
+	/// \class AsciiDecoder
+	/// \brief Decoder for RunDecoder of the ASCII characters at the start of a run of UTF-8
+	struct AsciiDecoder
+	{
+		static const char* findRunEnd( const ByteScanTable& delim, const char* blk, const char* blkend)
+		{
+			const char* end = ByteScanTable::findDelimiter( delim, blk, blkend);
+			return blk + charset::UTF8::asciiSize( blk, end - blk);
+		}
+		static std::size_t decode( const char* src, std::size_t srcsize, UChar* dest, std::size_t destsize, std::size_t& nofchars)
+		{
+			nofchars = (srcsize > destsize) ? destsize : srcsize;
+			for (std::size_t ii=0; ii<nofchars; ++ii) dest[ ii] = (unsigned char)src[ ii];
+			return nofchars;
+		}
+	};
+
+	/// \class TableDecoder
+	/// \brief Decoder for RunDecoder of a single byte code page with the table of the code page
+	struct TableDecoder
+	{
+		const unsigned short* table;
+
+		explicit TableDecoder( const unsigned short* table_)	:table(table_){}
+
+		static const char* findRunEnd( const ByteScanTable& delim, const char* blk, const char* blkend)
+		{
+			return ByteScanTable::findDelimiter( delim, blk, blkend);
+		}
+		std::size_t decode( const char* src, std::size_t srcsize, UChar* dest, std::size_t destsize, std::size_t& nofchars) const
+		{
+			nofchars = (srcsize > destsize) ? destsize : srcsize;
+			for (std::size_t ii=0; ii<nofchars; ++ii) dest[ ii] = table[ (unsigned char)src[ ii]];
+			return nofchars;
+		}
+	};
+
+	/// \class WideDecoder
+	/// \brief Decoder for RunDecoder of code units of 2 or 4 bytes with WideCharScanner
+	struct WideDecoder
+	{
+		typedef typename WideCharScanning<CharSet>::Scanner Scanner;
+
+		static const char* findRunEnd( const ByteScanTable& delim, const char* blk, const char* blkend)
+		{
+			return Scanner::findDelimiter( delim, blk, blkend);
+		}
+		static std::size_t decode( const char* src, std::size_t srcsize, UChar* dest, std::size_t destsize, std::size_t& nofchars)
+		{
+			std::size_t chunksize = (srcsize > destsize * CharSet::CodeUnitSize) ? (destsize * CharSet::CodeUnitSize) : srcsize;
+			return Scanner::decode( src, chunksize, dest, nofchars);
+		}
+	};
+
+	/// \class RunTranscoder
+	/// \brief Run processor converting a run between UTF-16 and UTF-8 in bulk with UTF16Transcoder
+	template <class Transcoder, class Direction, class Buffer>
+	struct RunTranscoder
+	{
+		enum {ChunkSize=512};
+		const ByteScanTable& delim;
+		Buffer& buf;
+
+		RunTranscoder( const ByteScanTable& delim_, Buffer& buf_)	:delim(delim_),buf(buf_){}
+
+		std::size_t runSize( const char* blk, const char* blkend) const
+		{
+			// ... the conversion stops also at a character not complete in the block, so there is no need to call CharSet::completeSize here
+			return findRunEnd( delim, blk, blkend, Direction()) - blk;
+		}
+		std::size_t emit( const char* run, std::size_t size)
+		{
+			// ... the output of a chunk converted is at most twice as big as its input
+			char tmp[ 2*ChunkSize];
+			std::size_t nn = 0;
+			while (nn < size)
+			{
+				std::size_t chunksize = (size - nn > ChunkSize) ? (std::size_t)ChunkSize : (size - nn);
+				std::size_t outsize;
+				std::size_t consumed = transcode( run + nn, chunksize, tmp, outsize, Direction());
+				if (!consumed) break;
+				appendBytes( buf, tmp, outsize);
+				nn += consumed;
+			}
+			return nn;
+		}
+
+		/// \brief Find the end of the run in the block for UTF-16 input
+		static const char* findRunEnd( const ByteScanTable& delim, const char* blk, const char* blkend, const UTF16TranscodingDirection::FromUTF16&)
+		{
+			return Transcoder::findDelimiter( delim, blk, blkend);
+		}
+		/// \brief Find the end of the run in the block for UTF-8 input
+		static const char* findRunEnd( const ByteScanTable& delim, const char* blk, const char* blkend, const UTF16TranscodingDirection::ToUTF16&)
+		{
+			return ByteScanTable::findDelimiter( delim, blk, blkend);
+		}
+		static std::size_t transcode( const char* src, std::size_t srcsize, char* dest, std::size_t& destsize, const UTF16TranscodingDirection::FromUTF16&)
+		{
+			return Transcoder::toUTF8( src, srcsize, dest, destsize);
+		}
+		static std::size_t transcode( const char* src, std::size_t srcsize, char* dest, std::size_t& destsize, const UTF16TranscodingDirection::ToUTF16&)
+		{
+			return Transcoder::fromUTF8( src, srcsize, dest, destsize);
+		}
+	};
+
+	template <class OutputCharSet, class Buffer>
+	std::size_t printAsciiRun_impl( const ByteScanTable&, const OutputCharSet&, Buffer&, const traits::TypeCheck::NO&)
+	{
+		return 0;
+	}
+
+	template <class OutputCharSet, class Buffer>
+	std::size_t printAsciiRun_impl( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_, const traits::TypeCheck::YES&)
+	{
+		RunDecoder<AsciiDecoder,OutputCharSet,Buffer> proc( delim, AsciiDecoder(), output_, buf_);
+		return processRun( proc);
+	}
+
+	template <class OutputCharSet, class Buffer>
+	std::size_t printRun_impl( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_, const UTF16TranscodingDirection::None&)
+	{
+		return printDecodedRun_impl( delim, output_, buf_, traits::TypeCheck::is_true<charset::SingleByteCharSetCheck<CharSet>::value>::type());
+	}
+
+	template <class OutputCharSet, class Buffer>
+	std::size_t printDecodedRun_impl( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_, const traits::TypeCheck::NO&)
+	{
+		return printWideRun_impl( delim, output_, buf_, traits::TypeCheck::is_true<WideCharScanning<CharSet>::Enabled>::type());
+	}
+
+	template <class OutputCharSet, class Buffer>
+	std::size_t printWideRun_impl( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_, const traits::TypeCheck::NO&)
+	{
+		return printAsciiRun( delim, output_, buf_);
+	}
+
+	/// \brief Print a run of code units of 2 or 4 bytes found and decoded with WideCharScanner
+	template <class OutputCharSet, class Buffer>
+	std::size_t printWideRun_impl( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_, const traits::TypeCheck::YES&)
+	{
+		RunDecoder<WideDecoder,OutputCharSet,Buffer> proc( delim, WideDecoder(), output_, buf_);
+		return processRun( proc);
+	}
+
+	/// \brief Print a run of a single byte code page decoded with the table of the code page
+	template <class OutputCharSet, class Buffer>
+	std::size_t printDecodedRun_impl( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_, const traits::TypeCheck::YES&)
+	{
+		TableDecoder decoder( charset.decodeTable());
+		RunDecoder<TableDecoder,OutputCharSet,Buffer> proc( delim, decoder, output_, buf_);
+		return processRun( proc);
+	}
+
+	/// \brief Print a run converted between UTF-16 and UTF-8 with UTF16Transcoder
+	template <class OutputCharSet, class Buffer, class Direction>
+	std::size_t printRun_impl( const ByteScanTable& delim, const OutputCharSet&, Buffer& buf_, const Direction&)
+	{
+		RunTranscoder<typename UTF16Transcoding<CharSet,OutputCharSet>::Transcoder,Direction,Buffer> proc( delim, buf_);
+		return processRun( proc);
+	}
+
+	template <class Buffer>
+	std::size_t copyRun_impl( const ByteScanTable& delim, const CharSet& output_, Buffer& buf_, const traits::TypeCheck::NO&)
+	{
+		return copyWideRun_impl( delim, output_, buf_, traits::TypeCheck::is_true<WideCharScanning<CharSet>::Enabled>::type());
+	}
+
+	template <class Buffer>
+	std::size_t copyWideRun_impl( const ByteScanTable&, const CharSet&, Buffer&, const traits::TypeCheck::NO&)
+	{
+		return 0;
+	}
+
+	/// \brief Copy a run of code units of 2 or 4 bytes found with WideCharScanner
+	template <class Buffer>
+	std::size_t copyWideRun_impl( const ByteScanTable& delim, const CharSet& output_, Buffer& buf_, const traits::TypeCheck::YES&)
+	{
+		if (!CharSet::is_equal( charset, output_)) return 0;
+		RunCopier<typename WideCharScanning<CharSet>::Scanner,Buffer> proc( delim, buf_);
+		return processRun( proc);
+	}
+
+	/// \brief Copy a run of a byte oriented character set encoding
+	template <class Buffer>
+	std::size_t copyRun_impl( const ByteScanTable& delim, const CharSet& output_, Buffer& buf_, const traits::TypeCheck::YES&)
+	{
+		if (!CharSet::is_equal( charset, output_)) return 0;
+		RunCopier<ByteScanTable,Buffer> proc( delim, buf_);
+		return processRun( proc);
+	}
+};
+
+/// \class LookaheadTextScanner
+/// \brief Reader for scanning the input character by character with the same interface as TextScanner, that decodes the characters ahead a block at a time
+/// \remark The characters ahead are decoded into parallel arrays of Unicode characters and control character classes, that serve chr(), control(), ascii() and skip() without passing through the state of a TextScanner. This separates the decoding from the stepping of the scanner state machine (see XMLScanner, parameter InputReader_)
+/// \remark Decodes ahead only if the source iterator iterates on a memory block (see traits::ContiguousSource) and only characters completely in the current block. The remaining characters are read with TextScanner one by one
+/// \remark getPosition() does not count the bytes of the current character, if it is served from the characters decoded ahead
+/// \remark Pays off for character set encodings with code units of 2 or 4 bytes (UTF-16, UCS-2, UCS-4), where reading a character byte by byte is expensive. For byte oriented encodings reading character by character with TextScanner is cheaper
+/// \tparam Iterator source iterator type (implements preincrement and '*' input byte access indirection)
+/// \tparam CharSet character set of the source stream
+/// \tparam LookaheadSize maximum number of characters decoded ahead
+template <class Iterator, class CharSet, unsigned int LookaheadSize=64>
+class LookaheadTextScanner
+{
+private:
+	typedef traits::ContiguousSource<Iterator> Source;
+	enum {MaxCharSize=8};		///< maximum size of a character in bytes (size of the buffer TextScanner reads a character into)
+
+	TextScanner<Iterator,CharSet> scanner;	///< reader for the characters not decoded ahead, its iterator points to the start of the current character, if it is decoded ahead
+	CharSet charset;
+	UChar chrar[ LookaheadSize];		///< Unicode characters decoded ahead
+	unsigned char ctlar[ LookaheadSize];	///< control characters (ControlCharacter) of the characters decoded ahead
+	unsigned char asciiar[ LookaheadSize];	///< ASCII characters of the characters decoded ahead or 0 if not in ASCII range
+	unsigned char sizear[ LookaheadSize];	///< size of the characters decoded ahead in bytes
+	unsigned int idx;			///< index of the current character in the arrays
+	unsigned int nofchars;			///< number of characters decoded ahead in the arrays
+	const char* cur;			///< pointer to the current character in the source block, if it is decoded ahead
+	const char* end;			///< end of the characters decoded ahead in the source block
+	bool fetched;				///< true, if bytes of the current character have been fetched by 'scanner'
+
+public:
+	typedef typename TextScanner<Iterator,CharSet>::ControlCharMap ControlCharMap;
+
+	/// \brief Constructor
+	LookaheadTextScanner( const CharSet& charset_)
+		:scanner(charset_),charset(charset_),idx(0),nofchars(0),cur(0),end(0),fetched(false){}
+
+	LookaheadTextScanner( const CharSet& charset_, const Iterator& p_iterator)
+		:scanner(charset_,p_iterator),charset(charset_),idx(0),nofchars(0),cur(0),end(0),fetched(false){}
+
+	LookaheadTextScanner( const Iterator& p_iterator)
+		:scanner(p_iterator),charset(CharSet()),idx(0),nofchars(0),cur(0),end(0),fetched(false){}
+
+	/// \brief Assign something to the iterator while keeping the state
+	/// \param [in] a source iterator assignment
+	template <class IteratorAssignment>
+	void setSource( const IteratorAssignment& a)
+	{
+		scanner.setSource( a);
+		reset();
+	}
+
+	/// \brief Restart scanning with a new source, keeping the character set
+	/// \param [in] a source iterator assignment
+	template <class IteratorAssignment>
+	void restart( const IteratorAssignment& a)
+	{
+		scanner.restart( a);
+		fetched = false;
+		reset();
+	}
+
+	/// \brief Get the current source iterator position
+	/// \return source iterator position in character words (usually bytes)
+	std::size_t getPosition() const
+	{
+		return scanner.getPosition();
+	}
+
+	/// \brief Get the unicode representation of the current character
+	/// \return the unicode character
+	inline UChar chr()
+	{
+		if (lookahead()) return chrar[ idx];
+		fetched = true;
+		return scanner.chr();
+	}
+
+	/// \brief Get the iterator pointing to the current source position
+	inline const Iterator& getIterator() const
+	{
+		return scanner.getIterator();
+	}
+
+	/// \brief Get the iterator pointing to the current source position
+	/// \remark Drops the characters decoded ahead, because the iterator may be changed by the caller (e.g. SrcIterator::putInput)
+	inline Iterator& getIterator()
+	{
+		reset();
+		return scanner.getIterator();
+	}
+
+	/// \brief Direct copy of a character from input to output without encoding/decoding it
+	/// \remark see TextScanner::copychar(CharSet&,Buffer&)
+	template <class Buffer>
+	inline void copychar( CharSet& output_, Buffer& buf_)
+	{
+		if (lookahead())
+		{
+			if (CharSet::is_equal( charset, output_))
+			{
+				appendBytes( buf_, cur, sizear[ idx]);
+			}
+			else
+			{
+				output_.print( chrar[ idx], buf_);
+			}
+		}
+		else
+		{
+			fetched = true;
+			scanner.copychar( output_, buf_);
+		}
+	}
+
+	/// \brief see TextScanner::copyRun(const ByteScanTable&,const CharSet&,Buffer&)
+	template <class Buffer>
+	inline std::size_t copyRun( const ByteScanTable& delim, const CharSet& output_, Buffer& buf_)
+	{
+		return consumed( scanner.copyRun( delim, output_, buf_));
+	}
+
+	/// \brief see TextScanner::printAsciiRun(const ByteScanTable&,const OutputCharSet&,Buffer&)
+	template <class OutputCharSet, class Buffer>
+	inline std::size_t printAsciiRun( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_)
+	{
+		return consumed( scanner.printAsciiRun( delim, output_, buf_));
+	}
+
+	/// \brief see TextScanner::printRun(const ByteScanTable&,const OutputCharSet&,Buffer&)
+	template <class OutputCharSet, class Buffer>
+	inline std::size_t printRun( const ByteScanTable& delim, const OutputCharSet& output_, Buffer& buf_)
+	{
+		return consumed( scanner.printRun( delim, output_, buf_));
+	}
+
+	/// \brief see TextScanner::getRun(const ByteScanTable&,const CharSet&,const char*&,std::size_t&)
+	inline bool getRun( const ByteScanTable& delim, const CharSet& output_, const char*& ptr_, std::size_t& size_) const
+	{
+		return scanner.getRun( delim, output_, ptr_, size_);
+	}
+
+	/// \brief see TextScanner::skipRun(std::size_t)
+	inline void skipRun( std::size_t size_)
+	{
+		if (!size_) return;
+		scanner.skipRun( size_);
+		fetched = false;
+		consumed( size_);
+	}
+
+	/// \brief see TextScanner::endOfBlock()
+	inline bool endOfBlock() const
+	{
+		return scanner.endOfBlock();
+	}
+
+	/// \brief Get the control character representation of the current character
+	/// \return the control character
+	inline ControlCharacter control()
+	{
+		if (lookahead()) return (ControlCharacter)ctlar[ idx];
+		fetched = true;
+		return scanner.control();
+	}
+
+	/// \brief Get the ASCII character representation of the current character
+	/// \return the ASCII character or 0 if not defined
+	inline unsigned char ascii()
+	{
+		if (lookahead()) return asciiar[ idx];
+		fetched = true;
+		return scanner.ascii();
+	}
+
+	/// \brief Skip to the next character of the source
+	/// \return *this
+	inline LookaheadTextScanner& skip()
+	{
+		if (idx < nofchars)
+		{
+			Source::advance( scanner.getIterator(), sizear[ idx]);
+			cur += sizear[ idx];
+			++idx;
+		}
+		else
+		{
+			scanner.skip();
+			fetched = false;
+		}
+		return *this;
+	}
+
+	/// \brief see LookaheadTextScanner::chr()
+	inline UChar operator*()
+	{
+		return chr();
+	}
+
+	/// \brief Preincrement: Skip to the next character of the source
+	/// \return *this
+	inline LookaheadTextScanner& operator ++()	{return skip();}
+
+	/// \brief Postincrement: Skip to the next character of the source
+	/// \return *this
+	inline LookaheadTextScanner operator ++(int)	{LookaheadTextScanner tmp(*this); skip(); return tmp;}
+
+private:
+	/// \brief Drop the characters decoded ahead
+	void reset()
+	{
+		idx = 0;
+		nofchars = 0;
+	}
+
+	/// \brief Evaluate if the current character is decoded ahead, decode the next block of characters ahead if needed and possible
+	/// \return true, if the current character is served from the arrays
+	inline bool lookahead()
+	{
+		return idx < nofchars || (!fetched && decode());
+	}
+
+	/// \brief Decode the characters ahead of the iterator that are completely in the current block
+	/// \return true, if at least one character has been decoded
+	bool decode()
+	{
+		std::size_t blksize;
+		const char* blk = Source::block( scanner.getIterator(), blksize);
+		idx = 0;
+		nofchars = 0;
+		// ... a character starting at least MaxCharSize bytes before the end of a block of known size is in the block
+		bool nullterminated = (blksize == (std::size_t)-1);
+		if (!blk || (!nullterminated && blksize < MaxCharSize)) return false;
+		const char* last = nullterminated ? blk : (blk + blksize - MaxCharSize);
+
+		// ... decoding with local variables, because the stores to the byte arrays may alias the member variables
+		const char* cc = blk;
+		unsigned int nn = 0;
+		for (; nn < LookaheadSize && (nullterminated || cc <= last); ++nn)
+		{
+			unsigned char ch = (unsigned char)*cc;
+			if ((int)CharSet::CodeUnitSize == 1 && ch < 0x80 && ch)
+			{
+				// ... ASCII character of a byte oriented character set encoding
+				chrar[ nn] = ch;
+				ctlar[ nn] = (unsigned char)ControlCharTable<>::ar[ ch];
+				asciiar[ nn] = ch;
+				sizear[ nn] = 1;
+				++cc;
+				continue;
+			}
+			char buf[ MaxCharSize];
+			unsigned int state = 0;
+			const char* itr = cc;
+			signed char ach = CharSet::asciichar( buf, state, itr);
+			chrar[ nn] = charset.value( buf, state, itr);
+			CharSet::skip( buf, state, itr);
+			ctlar[ nn] = (unsigned char)ControlCharTable<>::ar[ (unsigned char)ach];
+			asciiar[ nn] = (ach >= 0) ? (unsigned char)ach : 0;
+			sizear[ nn] = (unsigned char)(itr - cc);
+			cc = itr;
+			// ... nothing is decoded beyond the end of text
+			if (ach == 0)
+			{
+				++nn;
+				break;
+			}
+		}
+		nofchars = nn;
+		cur = blk;
+		end = cc;
+		return nn != 0;
+	}
+
+	/// \brief Move the current character ahead by the bytes consumed by a run of the reader or drop the characters decoded ahead
+	/// \param [in] size_ number of bytes consumed
+	/// \return size_
+	std::size_t consumed( std::size_t size_)
+	{
+		if (!size_ || idx >= nofchars) return size_;
+		const char* pos = cur + size_;
+		if (pos >= end)
+		{
+			reset();
+			return size_;
+		}
+		while (cur < pos)
+		{
+			cur += sizear[ idx++];
+		}
+		if (cur != pos) reset();
+		return size_;
+	}
 };
 
 }//namespace
@@ -0,0 +1,324 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/thread.hpp
+/// \brief Minimal portable thread, mutex and condition for running scanners and readers in parallel (POSIX threads or Windows threads)
+
+#ifndef __TEXTWOLF_THREAD_HPP__
+#define __TEXTWOLF_THREAD_HPP__
+
+#ifndef TEXTWOLF_NO_THREADS
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#endif
+#endif
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class Thread
+/// \brief Thread running a task
+/// \remark With TEXTWOLF_NO_THREADS defined or if no thread can be created, the task is run in the calling thread when starting it
+class Thread
+{
+public:
+	/// \class Task
+	/// \brief Interface of a task run by a thread. It must not throw
+	struct Task
+	{
+		virtual ~Task(){}
+		virtual void run()=0;
+	};
+
+	/// \brief Constructor
+	Thread()
+		:m_running(false){}
+
+	/// \brief Destructor (waits for the task to finish)
+	~Thread()
+	{
+		join();
+	}
+
+	/// \brief Start a task
+	/// \param [in] task the task to run, must stay valid until join() returns
+	void start( Task* task)
+	{
+		if (!tryStart( task)) task->run();
+	}
+
+	/// \brief Start a task only if it can be run in its own thread
+	/// \param [in] task the task to run, must stay valid until join() returns
+	/// \return true, if the task has been started, false if no thread could be created (always with TEXTWOLF_NO_THREADS). The task is not run then
+	bool tryStart( Task* task)
+	{
+		join();
+#if defined(TEXTWOLF_NO_THREADS)
+		(void)task;
+#elif defined(_WIN32)
+		m_handle = CreateThread( 0, 0, &threadMain, task, 0, 0);
+		m_running = (m_handle != 0);
+#else
+		m_running = (pthread_create( &m_handle, 0, &threadMain, task) == 0);
+#endif
+		return m_running;
+	}
+
+	/// \brief Wait for the task started to finish
+	void join()
+	{
+		if (!m_running) return;
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		WaitForSingleObject( m_handle, INFINITE);
+		CloseHandle( m_handle);
+#elif !defined(TEXTWOLF_NO_THREADS)
+		pthread_join( m_handle, 0);
+#endif
+		m_running = false;
+	}
+
+private:
+	Thread( const Thread&);			///< non copyable
+	Thread& operator=( const Thread&);	///< non copyable
+
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+	static DWORD WINAPI threadMain( LPVOID task)
+	{
+		((Task*)task)->run();
+		return 0;
+	}
+	HANDLE m_handle;			///< thread handle
+#elif !defined(TEXTWOLF_NO_THREADS)
+	static void* threadMain( void* task)
+	{
+		((Task*)task)->run();
+		return 0;
+	}
+	pthread_t m_handle;			///< thread handle
+#endif
+	bool m_running;				///< true, if a thread has been started and not joined yet
+};
+
+/// \class Mutex
+/// \brief Mutual exclusion lock
+/// \remark With TEXTWOLF_NO_THREADS defined locking does nothing
+class Mutex
+{
+public:
+	/// \brief Constructor
+	Mutex()
+	{
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		InitializeCriticalSection( &m_handle);
+#elif !defined(TEXTWOLF_NO_THREADS)
+		pthread_mutex_init( &m_handle, 0);
+#endif
+	}
+
+	/// \brief Destructor
+	~Mutex()
+	{
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		DeleteCriticalSection( &m_handle);
+#elif !defined(TEXTWOLF_NO_THREADS)
+		pthread_mutex_destroy( &m_handle);
+#endif
+	}
+
+	/// \brief Acquire the lock
+	void lock()
+	{
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		EnterCriticalSection( &m_handle);
+#elif !defined(TEXTWOLF_NO_THREADS)
+		pthread_mutex_lock( &m_handle);
+#endif
+	}
+
+	/// \brief Release the lock
+	void unlock()
+	{
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		LeaveCriticalSection( &m_handle);
+#elif !defined(TEXTWOLF_NO_THREADS)
+		pthread_mutex_unlock( &m_handle);
+#endif
+	}
+
+	/// \class Lock
+	/// \brief Lock held during the lifetime of this object
+	class Lock
+	{
+	public:
+		/// \brief Constructor acquiring the lock
+		/// \param [in] mutex_ mutex to lock
+		explicit Lock( Mutex& mutex_)
+			:m_mutex(mutex_)
+		{
+			m_mutex.lock();
+		}
+
+		/// \brief Destructor releasing the lock
+		~Lock()
+		{
+			m_mutex.unlock();
+		}
+
+	private:
+		Lock( const Lock&);			///< non copyable
+		Lock& operator=( const Lock&);		///< non copyable
+		Mutex& m_mutex;				///< mutex locked
+	};
+
+private:
+	friend class Condition;
+	Mutex( const Mutex&);			///< non copyable
+	Mutex& operator=( const Mutex&);	///< non copyable
+
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+	CRITICAL_SECTION m_handle;		///< critical section handle
+#elif !defined(TEXTWOLF_NO_THREADS)
+	pthread_mutex_t m_handle;		///< mutex handle
+#endif
+};
+
+/// \class Condition
+/// \brief Condition variable to wait on for a thread holding a mutex until another thread signals it
+/// \remark With TEXTWOLF_NO_THREADS defined waiting and signalling does nothing
+class Condition
+{
+public:
+	/// \brief Constructor
+	Condition()
+	{
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		InitializeConditionVariable( &m_handle);
+#elif !defined(TEXTWOLF_NO_THREADS)
+		pthread_cond_init( &m_handle, 0);
+#endif
+	}
+
+	/// \brief Destructor
+	~Condition()
+	{
+#if !defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		pthread_cond_destroy( &m_handle);
+#endif
+	}
+
+	/// \brief Release the mutex locked by the caller, wait until the condition is signalled and acquire the mutex again
+	/// \remark The wait may also end without a signal, the caller has to check its condition again
+	/// \param [in] mutex mutex locked by the caller
+	void wait( Mutex& mutex)
+	{
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		SleepConditionVariableCS( &m_handle, &mutex.m_handle, INFINITE);
+#elif !defined(TEXTWOLF_NO_THREADS)
+		pthread_cond_wait( &m_handle, &mutex.m_handle);
+#else
+		(void)mutex;
+#endif
+	}
+
+	/// \brief Wake up a thread waiting on the condition
+	void signal()
+	{
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+		WakeConditionVariable( &m_handle);
+#elif !defined(TEXTWOLF_NO_THREADS)
+		pthread_cond_signal( &m_handle);
+#endif
+	}
+
+private:
+	Condition( const Condition&);			///< non copyable
+	Condition& operator=( const Condition&);	///< non copyable
+
+#if defined(_WIN32) && !defined(TEXTWOLF_NO_THREADS)
+	CONDITION_VARIABLE m_handle;		///< condition variable handle
+#elif !defined(TEXTWOLF_NO_THREADS)
+	pthread_cond_t m_handle;		///< condition variable handle
+#endif
+};
+
+/// \brief Read a variable written by another thread
+/// \remark Loads and stores with atomicLoad(const volatile T&) and atomicStore(volatile T&,T) are sequentially consistent. Used for counters and flags handing over data between two threads without locking
+/// \param [in] var variable to read, a word sized integer or a bool
+/// \return the value read
+template <typename T>
+inline T atomicLoad( const volatile T& var)
+{
+#if defined(TEXTWOLF_NO_THREADS)
+	return var;
+#elif defined(_WIN32)
+	MemoryBarrier();
+	T rt = var;
+	MemoryBarrier();
+	return rt;
+#elif defined(__ATOMIC_SEQ_CST)
+	return __atomic_load_n( &var, __ATOMIC_SEQ_CST);
+#else
+	__sync_synchronize();
+	T rt = var;
+	__sync_synchronize();
+	return rt;
+#endif
+}
+
+/// \brief Write a variable read by another thread (see atomicLoad(const volatile T&))
+/// \param [in,out] var variable to write, a word sized integer or a bool
+/// \param [in] value value to write
+template <typename T>
+inline void atomicStore( volatile T& var, T value)
+{
+#if defined(TEXTWOLF_NO_THREADS)
+	var = value;
+#elif defined(_WIN32)
+	MemoryBarrier();
+	var = value;
+	MemoryBarrier();
+#elif defined(__ATOMIC_SEQ_CST)
+	__atomic_store_n( &var, value, __ATOMIC_SEQ_CST);
+#else
+	__sync_synchronize();
+	var = value;
+	__sync_synchronize();
+#endif
+}
+
+}//namespace
+#endif
@@ -36,6 +36,7 @@
 #define __TEXTWOLF_TRAITS_HPP__
 /// \file textwolf/traits.hpp
 /// \brief Type traits
+#include <cstddef>
 
 namespace textwolf {
 namespace traits {
@@ -59,6 +60,68 @@ public:
 	{
 		static const YES type() {return YES();} 
 	};
+
+	template<bool cond, int dummy_=0>
+	struct is_true
+	{
+		static const NO type() {return NO();}
+	};
+
+	template<int dummy_>
+	struct is_true<true,dummy_>
+	{
+		static const YES type() {return YES();}
+	};
+};
+
+/// \class ContiguousSource
+/// \brief Access to the memory block behind a source iterator for block oriented scanning (see TextScanner::copyRun, TextScanner::getRun)
+/// \remark This default is for iterators not iterating on contiguous memory. Iterators on memory blocks specialize it
+/// \tparam Iterator source iterator type
+template <class Iterator>
+struct ContiguousSource
+{
+	/// \brief 1, if the block returned by block(const Iterator&,std::size_t&) covers all input assigned to the iterator, 0, if the iterator replaces its block on its own when reaching its end or if it does not iterate on a memory block
+	enum {FixedBlock=0};
+	/// \brief Get the block of bytes ahead of the iterator
+	/// \param [out] size number of bytes readable from the pointer returned, (std::size_t)-1 for a null terminated block of unknown size
+	/// \return pointer to the current byte or NULL if the iterator does not iterate on a memory block
+	static const char* block( const Iterator&, std::size_t& size)	{size=0; return 0;}
+	/// \brief Get the number of bytes of the block before the iterator that are still accessible, (std::size_t)-1 if not known
+	static std::size_t offset( const Iterator&)			{return 0;}
+	/// \brief Advance the iterator by a number of bytes inside the block returned by block(const Iterator&,std::size_t&)
+	static void advance( Iterator&, std::size_t)			{}
+};
+
+template <>
+struct ContiguousSource<char*>
+{
+	enum {FixedBlock=1};
+	static const char* block( char* const& itr, std::size_t& size)	{size=(std::size_t)-1; return itr;}
+	static std::size_t offset( char* const&)			{return (std::size_t)-1;}
+	static void advance( char*& itr, std::size_t n)			{itr += n;}
+};
+
+template <>
+struct ContiguousSource<const char*>
+{
+	enum {FixedBlock=1};
+	static const char* block( const char* const& itr, std::size_t& size)	{size=(std::size_t)-1; return itr;}
+	static std::size_t offset( const char* const&)				{return (std::size_t)-1;}
+	static void advance( const char*& itr, std::size_t n)			{itr += n;}
+};
+
+/// \class ChunkSource
+/// \brief Properties of a source iterator that is fed chunk by chunk with putInput(const char*,std::size_t) (see XMLScanner::putInput(const char*,std::size_t,bool))
+/// \remark This default is for iterators that cannot be fed chunk by chunk. SrcIterator and PaddedSrcIterator specialize it
+/// \tparam Iterator source iterator type
+template <class Iterator>
+struct ChunkSource
+{
+	/// \brief 1, if the iterator can be fed chunk by chunk
+	enum {Feedable=0};
+	/// \brief Number of null bytes required after the end of every chunk passed, 0 if the iterator does not read beyond the end of a chunk
+	enum {PaddingSize=0};
 };
 
 }}//namespace
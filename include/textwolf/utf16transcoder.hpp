@@ -0,0 +1,325 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/utf16transcoder.hpp
+/// \brief Conversion of runs of characters between UTF-16 and UTF-8 in bulk, vectorized with SSE2 if available
+
+#ifndef __TEXTWOLF_UTF16_TRANSCODER_HPP__
+#define __TEXTWOLF_UTF16_TRANSCODER_HPP__
+#include "textwolf/char.hpp"
+#include "textwolf/bytescan.hpp"
+#include "textwolf/charset_interface.hpp"
+#include "textwolf/charset_utf8.hpp"
+#include "textwolf/charset_utf16.hpp"
+#include "textwolf/widecharscanner.hpp"
+#include <cstddef>
+
+namespace textwolf {
+
+/// \class UTF16Transcoder
+/// \brief Conversion of runs of characters from UTF-16 to UTF-8 and back without decoding and printing the characters one by one
+/// \tparam encoding charset::ByteOrder::LE or charset::ByteOrder::BE
+/// \remark The conversion stops at the first character that is not well formed (an unpaired surrogate in UTF-16, an invalid, overlong or surrogate sequence in UTF-8), so that the caller can process it one by one with the character set encodings, getting the same result for invalid input as before
+/// \remark The ASCII characters of blocks of 8 code units (UTF-16) or 16 bytes (UTF-8) are narrowed or widened at once with SSE2 up to the first non ASCII character, the other characters are converted one by one. Define TEXTWOLF_NO_SIMD to disable vectorization
+template <int encoding>
+class UTF16Transcoder
+{
+private:
+	enum
+	{
+		LSB=(encoding==charset::ByteOrder::BE),			//< least significant byte index (0 or 1)
+		MSB=(encoding==charset::ByteOrder::LE)			//< most significant byte index (0 or 1)
+	};
+
+public:
+	/// \brief Find the first UTF-16 code unit that is a delimiter in the block [src,end)
+	/// \remark A code unit in the ASCII range is a delimiter, if its value is in the set, a code unit beyond the ASCII range, if 0x80 is in the set (like the byte of a non ASCII character in UTF-8)
+	/// \param[in] delim set of delimiters
+	/// \param[in] src start of the block to search
+	/// \param[in] end end of the block to search or NULL for a block terminated with the code unit 0 (0 has to be an element of the set then)
+	/// \return pointer to the first delimiter found or to the end of the last complete code unit in the block, if there is none
+	static const char* findDelimiter( const ByteScanTable& delim, const char* src, const char* end)
+	{
+		return WideCharScanner<2,encoding>::findDelimiter( delim, src, end);
+	}
+
+	/// \brief Convert UTF-16 to UTF-8
+	/// \param[in] src pointer to the UTF-16 input
+	/// \param[in] srcsize size of the input in bytes
+	/// \param[out] dest where to write the UTF-8 output to, at least 3*srcsize/2 bytes
+	/// \param[out] destsize number of bytes written to 'dest'
+	/// \return number of bytes of the input converted, less than 'srcsize' if the conversion stopped at a character not well formed or at a surrogate pair exceeding the input
+	static std::size_t toUTF8( const char* src, std::size_t srcsize, char* dest, std::size_t& destsize)
+	{
+		std::size_t ii = 0;
+		char* dd = dest;
+		while (ii + 2 <= srcsize)
+		{
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+			if (ii + 16 <= srcsize)
+			{
+				// ... narrow the ASCII characters at the start of the next 8 code units
+				__m128i units = loadUnits( src + ii);
+				unsigned int mask = (unsigned int)_mm_movemask_epi8( asciiUnits( units));
+				_mm_storel_epi64( (__m128i*)dd, _mm_packus_epi16( units, units));
+				if (mask == 0xFFFF)
+				{
+					ii += 16;
+					dd += 8;
+					continue;
+				}
+				unsigned int nn = firstbit( ~mask) >> 1;
+				ii += 2*nn;
+				dd += nn;
+			}
+#endif
+			// ... convert the next character
+			unsigned int ch = unit( src + ii);
+			if (ch < 0x80)
+			{
+				*dd++ = (char)ch;
+				ii += 2;
+			}
+			else if (ch < 0x800)
+			{
+				*dd++ = (char)(0xC0 | (ch >> 6));
+				*dd++ = (char)(0x80 | (ch & 0x3F));
+				ii += 2;
+			}
+			else if (ch - 0xD800 >= 0x800)
+			{
+				*dd++ = (char)(0xE0 | (ch >> 12));
+				*dd++ = (char)(0x80 | ((ch >> 6) & 0x3F));
+				*dd++ = (char)(0x80 | (ch & 0x3F));
+				ii += 2;
+			}
+			else if (ch < 0xDC00 && ii + 4 <= srcsize && unit( src + ii + 2) - 0xDC00 < 0x400)
+			{
+				ch = ((ch - 0xD800) << 10) + (unit( src + ii + 2) - 0xDC00) + 0x10000;
+				*dd++ = (char)(0xF0 | (ch >> 18));
+				*dd++ = (char)(0x80 | ((ch >> 12) & 0x3F));
+				*dd++ = (char)(0x80 | ((ch >> 6) & 0x3F));
+				*dd++ = (char)(0x80 | (ch & 0x3F));
+				ii += 4;
+			}
+			else
+			{
+				destsize = dd - dest;
+				return ii;
+			}
+		}
+		destsize = dd - dest;
+		return ii;
+	}
+
+	/// \brief Convert UTF-8 to UTF-16
+	/// \param[in] src pointer to the UTF-8 input
+	/// \param[in] srcsize size of the input in bytes
+	/// \param[out] dest where to write the UTF-16 output to, at least 2*srcsize bytes
+	/// \param[out] destsize number of bytes written to 'dest'
+	/// \return number of bytes of the input converted, less than 'srcsize' if the conversion stopped at a character not well formed or at a character exceeding the input
+	static std::size_t fromUTF8( const char* src, std::size_t srcsize, char* dest, std::size_t& destsize)
+	{
+		std::size_t ii = 0;
+		char* dd = dest;
+		while (ii < srcsize)
+		{
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+			if (ii + 16 <= srcsize)
+			{
+				// ... widen the ASCII characters at the start of the next 16 bytes
+				__m128i bytes = _mm_loadu_si128( (const __m128i*)(src + ii));
+				unsigned int mask = (unsigned int)_mm_movemask_epi8( bytes);
+				storeUnits( dd, bytes);
+				if (mask == 0)
+				{
+					ii += 16;
+					dd += 32;
+					continue;
+				}
+				unsigned int nn = firstbit( mask);
+				ii += nn;
+				dd += 2*nn;
+			}
+#endif
+			// ... convert the next character
+			unsigned int ch = (unsigned char)src[ ii];
+			if (ch < 0x80)
+			{
+				putUnit( dd, ch);
+				ii += 1;
+				continue;
+			}
+			unsigned int chrsize = charset::UTF8::charLength( (unsigned char)ch);
+			if (ch < 0xC2 || ch > 0xF4 || ii + chrsize > srcsize)
+			{
+				destsize = dd - dest;
+				return ii;
+			}
+			bool wellformed = true;
+			ch &= (0x7F >> chrsize);
+			for (unsigned int ci=1; ci<chrsize; ++ci)
+			{
+				unsigned char follow = (unsigned char)src[ ii+ci];
+				ch = (ch << 6) | (follow & 0x3F);
+				if ((follow & 0xC0) != 0x80) wellformed = false;
+			}
+			// ... invalid follow bytes, overlong forms, surrogates and characters beyond 0x10FFFF are left to the caller
+			if (!wellformed
+			||  (chrsize == 3 && (ch < 0x800 || ch - 0xD800 < 0x800))
+			||  (chrsize == 4 && (ch < 0x10000 || ch > 0x10FFFF)))
+			{
+				destsize = dd - dest;
+				return ii;
+			}
+			if (ch < 0x10000)
+			{
+				putUnit( dd, ch);
+			}
+			else
+			{
+				ch -= 0x10000;
+				putUnit( dd, 0xD800 + (ch >> 10));
+				putUnit( dd, 0xDC00 + (ch & 0x3FF));
+			}
+			ii += chrsize;
+		}
+		destsize = dd - dest;
+		return ii;
+	}
+
+private:
+	/// \brief Get the value of the code unit at 'src'
+	static unsigned int unit( const char* src)
+	{
+		return ((unsigned int)(unsigned char)src[ MSB] << 8) | (unsigned char)src[ LSB];
+	}
+
+	/// \brief Write a code unit to 'dest' and advance 'dest'
+	static void putUnit( char*& dest, unsigned int ch)
+	{
+		dest[ MSB] = (char)(unsigned char)(ch >> 8);
+		dest[ LSB] = (char)(unsigned char)(ch & 0xFF);
+		dest += 2;
+	}
+
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+	/// \brief Load 8 code units into the 16 bit elements of a vector
+	static __m128i loadUnits( const char* src)
+	{
+		__m128i rt = _mm_loadu_si128( (const __m128i*)src);
+		if (encoding == charset::ByteOrder::BE) rt = _mm_or_si128( _mm_slli_epi16( rt, 8), _mm_srli_epi16( rt, 8));
+		return rt;
+	}
+
+	/// \brief Get the mask of the code units in the ASCII range (elements with all bits set)
+	static __m128i asciiUnits( __m128i units)
+	{
+		return _mm_cmpeq_epi16( _mm_and_si128( units, _mm_set1_epi16( (short)0xFF80)), _mm_setzero_si128());
+	}
+
+	/// \brief Get the index of the lowest bit set in a non zero mask
+	static unsigned int firstbit( unsigned int mask)
+	{
+#if defined(_MSC_VER)
+		unsigned long rt;
+		_BitScanForward( &rt, mask);
+		return (unsigned int)rt;
+#else
+		return (unsigned int)__builtin_ctz( mask);
+#endif
+	}
+
+	/// \brief Write 16 ASCII characters as code units to 'dest'
+	static void storeUnits( char* dest, __m128i bytes)
+	{
+		__m128i zero = _mm_setzero_si128();
+		if (encoding == charset::ByteOrder::BE)
+		{
+			_mm_storeu_si128( (__m128i*)dest, _mm_unpacklo_epi8( zero, bytes));
+			_mm_storeu_si128( (__m128i*)(dest + 16), _mm_unpackhi_epi8( zero, bytes));
+		}
+		else
+		{
+			_mm_storeu_si128( (__m128i*)dest, _mm_unpacklo_epi8( bytes, zero));
+			_mm_storeu_si128( (__m128i*)(dest + 16), _mm_unpackhi_epi8( bytes, zero));
+		}
+	}
+#endif
+};
+
+/// \class UTF16TranscodingDirection
+/// \brief Tag types for the direction of the conversion selected by UTF16Transcoding
+struct UTF16TranscodingDirection
+{
+	struct None {};					///< no bulk conversion
+	struct FromUTF16 {};				///< UTF-16 input, UTF-8 output
+	struct ToUTF16 {};				///< UTF-8 input, UTF-16 output
+};
+
+/// \class UTF16Transcoding
+/// \brief Bulk conversion with UTF16Transcoder selected for a pair of input and output character set encodings (see TextScanner::printRun)
+/// \remark This default is for pairs without bulk conversion. The pairs of UTF-16 and UTF-8 specialize it
+/// \tparam InputCharSet character set encoding of the input
+/// \tparam OutputCharSet character set encoding of the output
+template <class InputCharSet, class OutputCharSet>
+struct UTF16Transcoding
+	:public UTF16TranscodingDirection
+{
+	typedef None Direction;				///< tag type of the conversion direction
+};
+
+template <int encoding>
+struct UTF16Transcoding<charset::UTF16<encoding>,charset::UTF8>
+	:public UTF16TranscodingDirection
+{
+	typedef FromUTF16 Direction;
+	typedef UTF16Transcoder<encoding> Transcoder;
+};
+
+template <int encoding>
+struct UTF16Transcoding<charset::UTF8,charset::UTF16<encoding> >
+	:public UTF16TranscodingDirection
+{
+	typedef ToUTF16 Direction;
+	typedef UTF16Transcoder<encoding> Transcoder;
+};
+
+template <> struct UTF16Transcoding<charset::UTF16LE,charset::UTF8> :public UTF16Transcoding<charset::UTF16<charset::ByteOrder::LE>,charset::UTF8> {};
+template <> struct UTF16Transcoding<charset::UTF16BE,charset::UTF8> :public UTF16Transcoding<charset::UTF16<charset::ByteOrder::BE>,charset::UTF8> {};
+template <> struct UTF16Transcoding<charset::UTF8,charset::UTF16LE> :public UTF16Transcoding<charset::UTF8,charset::UTF16<charset::ByteOrder::LE> > {};
+template <> struct UTF16Transcoding<charset::UTF8,charset::UTF16BE> :public UTF16Transcoding<charset::UTF8,charset::UTF16<charset::ByteOrder::BE> > {};
+
+}//namespace
+#endif
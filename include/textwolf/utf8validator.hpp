@@ -0,0 +1,404 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/utf8validator.hpp
+/// \brief Strict validation of UTF-8 input block by block, vectorized with lookup tables (SSSE3/AVX2) or comparisons (SSE2) if available
+
+#ifndef __TEXTWOLF_UTF8_VALIDATOR_HPP__
+#define __TEXTWOLF_UTF8_VALIDATOR_HPP__
+#include "textwolf/char.hpp"
+#include "textwolf/bytescan.hpp"
+#include "textwolf/charset_utf8.hpp"
+#include <cstddef>
+
+#if defined(TEXTWOLF_SIMD_AVX2) || (defined(TEXTWOLF_SIMD_SSE2) && defined(__SSSE3__))
+#define TEXTWOLF_SIMD_UTF8_LOOKUP
+#include <tmmintrin.h>
+#endif
+
+namespace textwolf {
+
+/// \class UTF8Validator
+/// \brief Strict validator for UTF-8 input passed block by block
+/// \remark Accepts only the shortest form of characters in the range [0..0x10FFFF] without surrogates (RFC 3629), in contrast to charset::UTF8 that also decodes overlong and 5/6 byte sequences
+/// \remark Blocks of 16 bytes are checked at once with the lookup table method of Keiser and Lemire ("Validating UTF-8 In Less Than One Instruction Per Byte") if SSSE3 is available, with comparisons if only SSE2 is available. Without SIMD (TEXTWOLF_NO_SIMD) runs of ASCII bytes are skipped 8 bytes at once and the rest is checked byte by byte. A character may be split between two blocks passed
+class UTF8Validator
+{
+public:
+	/// \brief Constructor
+	UTF8Validator()
+	{
+		reset();
+	}
+
+	/// \brief Reset the validator to the start of a new input
+	void reset()
+	{
+		m_pos = 0;
+		m_seqpos = 0;
+		m_need = 0;
+		m_lo = 0x80;
+		m_hi = 0xBF;
+		m_failed = false;
+		m_errpos = 0;
+	}
+
+	/// \brief Validate the next block of the input
+	/// \remark Only counts the bytes passed after an error has been found
+	/// \param [in] blk pointer to the block
+	/// \param [in] blksize size of the block in bytes
+	/// \return true, if no invalid sequence has been found up to now
+	bool check( const char* blk, std::size_t blksize)
+	{
+		if (m_failed)
+		{
+			m_pos += blksize;
+			return false;
+		}
+		const unsigned char* src = (const unsigned char*)blk;
+		const unsigned char* end = src + blksize;
+		while (src < end)
+		{
+			if (!m_need)
+			{
+				src = vectorRun( src, end);
+				if (src == end) break;
+			}
+			// ... check character by character at least up to the end of the next vector block
+			const unsigned char* stop = (std::size_t)(end - src) > VectorSize ? (src + VectorSize) : end;
+			for (; src < stop || (m_need && src < end); ++src)
+			{
+				if (!checkByte( *src, m_pos + (src - (const unsigned char*)blk)))
+				{
+					m_pos += blksize;
+					return false;
+				}
+			}
+		}
+		m_pos += blksize;
+		return true;
+	}
+
+	/// \brief Validate the end of the input
+	/// \remark Reports an error, if the last character of the input is incomplete
+	/// \return true, if the input passed is valid UTF-8
+	bool finish()
+	{
+		if (!m_failed && m_need) fail( m_seqpos);
+		return !m_failed;
+	}
+
+	/// \brief Check if an invalid sequence has been found
+	/// \return true, if yes
+	bool failed() const
+	{
+		return m_failed;
+	}
+
+	/// \brief Get the position of the first invalid sequence found
+	/// \return offset of the first byte of the sequence in bytes from the start of the input (the first block passed after reset())
+	std::size_t errorPosition() const
+	{
+		return m_errpos;
+	}
+
+	/// \brief Get the number of bytes passed
+	/// \return the sum of the sizes of the blocks passed since reset()
+	std::size_t position() const
+	{
+		return m_pos;
+	}
+
+	/// \brief Validate a complete input
+	/// \param [in] src pointer to the input
+	/// \param [in] srcsize size of the input in bytes
+	/// \param [out] errpos where to write the position of the first invalid sequence, if not NULL
+	/// \return true, if the input is valid UTF-8
+	static bool validate( const char* src, std::size_t srcsize, std::size_t* errpos=0)
+	{
+		UTF8Validator validator;
+		if (validator.check( src, srcsize) && validator.finish()) return true;
+		if (errpos) *errpos = validator.errorPosition();
+		return false;
+	}
+
+private:
+	/// \brief Check the next byte character by character
+	/// \param [in] ch the byte
+	/// \param [in] pos position of the byte in the input
+	/// \return false, if the byte completes an invalid sequence
+	bool checkByte( unsigned char ch, std::size_t pos)
+	{
+		if (m_need)
+		{
+			if (ch < m_lo || ch > m_hi) return fail( m_seqpos);
+			m_lo = 0x80;
+			m_hi = 0xBF;
+			--m_need;
+			return true;
+		}
+		if (ch < 0x80) return true;
+		m_seqpos = pos;
+		if (ch < 0xC2 || ch > 0xF4) return fail( pos);
+		m_need = charset::UTF8::charLength( ch) - 1;
+		// ... the range of the second byte excludes overlong forms, surrogates and characters beyond 0x10FFFF
+		switch (ch)
+		{
+			case 0xE0: m_lo = 0xA0; break;
+			case 0xED: m_hi = 0x9F; break;
+			case 0xF0: m_lo = 0x90; break;
+			case 0xF4: m_hi = 0x8F; break;
+		}
+		return true;
+	}
+
+	bool fail( std::size_t pos)
+	{
+		m_failed = true;
+		m_errpos = pos;
+		return false;
+	}
+
+#if defined(TEXTWOLF_SIMD_SSE2) || defined(TEXTWOLF_SIMD_AVX2)
+	enum {VectorSize=16};
+
+	/// \brief Skip the blocks of VectorSize bytes at the start of [src,end) that are valid, starting at a character boundary
+	/// \remark Each block is checked together with the last 3 bytes of the block before, so characters may span blocks. Blocks are processed in groups of 4, groups of ASCII bytes only are skipped without checking them
+	/// \return pointer to the first character not validated (a character boundary)
+	static const unsigned char* vectorRun( const unsigned char* src, const unsigned char* end)
+	{
+		const unsigned char* start = src;
+		const __m128i zero = _mm_setzero_si128();
+		// ... subtracted with saturation from a block, leaves non zero bytes for lead bytes of characters not complete in the block
+		const __m128i maxTail = _mm_setr_epi8( -1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1,-1, (char)(0xF0-1), (char)(0xE0-1), (char)(0xC0-1));
+		__m128i prev = zero;
+		for (; src + 4*VectorSize <= end; src += 4*VectorSize)
+		{
+			__m128i b0 = _mm_loadu_si128( (const __m128i*)src);
+			__m128i b1 = _mm_loadu_si128( (const __m128i*)(src + VectorSize));
+			__m128i b2 = _mm_loadu_si128( (const __m128i*)(src + 2*VectorSize));
+			__m128i b3 = _mm_loadu_si128( (const __m128i*)(src + 3*VectorSize));
+			if (_mm_movemask_epi8( _mm_or_si128( _mm_or_si128( b0, b1), _mm_or_si128( b2, b3))) == 0)
+			{
+				// ... ASCII only, valid if the block before has no character left incomplete
+				if (_mm_movemask_epi8( _mm_cmpeq_epi8( _mm_subs_epu8( prev, maxTail), zero)) != 0xFFFF) break;
+			}
+#if !defined(TEXTWOLF_SIMD_UTF8_LOOKUP)
+			else if (_mm_movemask_epi8( greaterEqual( _mm_max_epu8( _mm_max_epu8( _mm_max_epu8( b0, b1), _mm_max_epu8( b2, b3)), prev), 0xE0)) == 0)
+			{
+				// ... ASCII and 2 byte characters only
+				__m128i err = _mm_or_si128(
+						_mm_or_si128( blockErrors2( b0, prev), blockErrors2( b1, b0)),
+						_mm_or_si128( blockErrors2( b2, b1), blockErrors2( b3, b2)));
+				if (_mm_movemask_epi8( err) != 0) break;
+			}
+#endif
+			else
+			{
+				__m128i err = _mm_or_si128(
+						_mm_or_si128( blockErrors( b0, prev), blockErrors( b1, b0)),
+						_mm_or_si128( blockErrors( b2, b1), blockErrors( b3, b2)));
+				if (_mm_movemask_epi8( _mm_cmpeq_epi8( err, zero)) != 0xFFFF) break;
+			}
+			prev = b3;
+		}
+		for (; src + VectorSize <= end; src += VectorSize)
+		{
+			__m128i blk = _mm_loadu_si128( (const __m128i*)src);
+			if (_mm_movemask_epi8( _mm_cmpeq_epi8( blockErrors( blk, prev), zero)) != 0xFFFF) break;
+			prev = blk;
+		}
+		// ... back up to the start of a character not complete before the first byte not validated
+		if (src != start) src -= incompleteTail( src);
+		return src;
+	}
+
+	/// \brief Get the number of bytes at the end of a block that belong to a character not complete in the block
+	/// \param [in] end end of the block (the 3 bytes before must be readable)
+	static unsigned int incompleteTail( const unsigned char* end)
+	{
+		for (unsigned int ii=1; ii<=3; ++ii)
+		{
+			unsigned char ch = end[ -(int)ii];
+			if (ch < 0x80) return 0;
+			if (ch >= 0xC0) return (charset::UTF8::charLength( ch) > ii) ? ii : 0;
+		}
+		return 0;
+	}
+#else
+	enum {VectorSize=8};
+
+	static const unsigned char* vectorRun( const unsigned char* src, const unsigned char* end)
+	{
+		return src + charset::UTF8::asciiSize( (const char*)src, end - src);
+	}
+#endif
+
+#if defined(TEXTWOLF_SIMD_UTF8_LOOKUP)
+	/// \brief Check a block of 16 bytes with the lookup table method
+	/// \remark A character not complete at the end of the block is not reported as error, its bytes in the block are checked as far as they go
+	/// \param [in] blk the block
+	/// \param [in] prev the block before (validated) or zero, if the block starts at a character boundary
+	/// \return the mask of errors, zero if the block contains no invalid sequence
+	static __m128i blockErrors( __m128i blk, __m128i prev)
+	{
+		enum
+		{
+			TOO_SHORT=1<<0,		///< lead byte followed by a non continuation byte
+			TOO_LONG=1<<1,		///< ASCII byte followed by a continuation byte
+			OVERLONG_3=1<<2,	///< 3 byte sequence of a character < 0x800
+			TOO_LARGE=1<<3,		///< character > 0x10FFFF
+			SURROGATE=1<<4,		///< character in the range [0xD800..0xDFFF]
+			OVERLONG_2=1<<5,	///< 2 byte sequence of a character < 0x80
+			TOO_LARGE_1000=1<<6,	///< character > 0x10FFFF with a second byte 1000____
+			OVERLONG_4=1<<6,	///< 4 byte sequence of a character < 0x10000
+			TWO_CONTS=-0x80,	///< two continuation bytes, valid only as 3rd or 4th byte (bit 7, negative to fit into the signed char arguments of _mm_setr_epi8)
+			CARRY=TOO_SHORT|TOO_LONG|TWO_CONTS
+		};
+		const __m128i byte1High = _mm_setr_epi8(
+			TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG, TOO_LONG,
+			TWO_CONTS, TWO_CONTS, TWO_CONTS, TWO_CONTS,
+			TOO_SHORT|OVERLONG_2,
+			TOO_SHORT,
+			TOO_SHORT|OVERLONG_3|SURROGATE,
+			TOO_SHORT|TOO_LARGE|TOO_LARGE_1000|OVERLONG_4);
+		const __m128i byte1Low = _mm_setr_epi8(
+			CARRY|OVERLONG_3|OVERLONG_2|OVERLONG_4,
+			CARRY|OVERLONG_2,
+			CARRY,
+			CARRY,
+			CARRY|TOO_LARGE,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000|SURROGATE,
+			CARRY|TOO_LARGE|TOO_LARGE_1000,
+			CARRY|TOO_LARGE|TOO_LARGE_1000);
+		const __m128i byte2High = _mm_setr_epi8(
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT,
+			TOO_LONG|OVERLONG_2|TWO_CONTS|OVERLONG_3|TOO_LARGE_1000|OVERLONG_4,
+			TOO_LONG|OVERLONG_2|TWO_CONTS|OVERLONG_3|TOO_LARGE,
+			TOO_LONG|OVERLONG_2|TWO_CONTS|SURROGATE|TOO_LARGE,
+			TOO_LONG|OVERLONG_2|TWO_CONTS|SURROGATE|TOO_LARGE,
+			TOO_SHORT, TOO_SHORT, TOO_SHORT, TOO_SHORT);
+		const __m128i nibble = _mm_set1_epi8( 0x0F);
+
+		__m128i prev1 = _mm_alignr_epi8( blk, prev, 15);
+		__m128i prev2 = _mm_alignr_epi8( blk, prev, 14);
+		__m128i prev3 = _mm_alignr_epi8( blk, prev, 13);
+
+		__m128i sc = _mm_and_si128(
+				_mm_and_si128(
+					_mm_shuffle_epi8( byte1High, _mm_and_si128( _mm_srli_epi16( prev1, 4), nibble)),
+					_mm_shuffle_epi8( byte1Low, _mm_and_si128( prev1, nibble))),
+				_mm_shuffle_epi8( byte2High, _mm_and_si128( _mm_srli_epi16( blk, 4), nibble)));
+
+		// ... continuation bytes after a continuation byte are valid only as 3rd byte of a 3/4 byte sequence or as 4th byte of a 4 byte sequence
+		__m128i is3rd = _mm_subs_epu8( prev2, _mm_set1_epi8( (char)(0xE0-0x80)));
+		__m128i is4th = _mm_subs_epu8( prev3, _mm_set1_epi8( (char)(0xF0-0x80)));
+		__m128i must23 = _mm_and_si128( _mm_or_si128( is3rd, is4th), _mm_set1_epi8( (char)0x80));
+
+		return _mm_xor_si128( must23, sc);
+	}
+#elif defined(TEXTWOLF_SIMD_SSE2)
+	/// \brief Get the mask of the bytes in a block that are greater than or equal to a value (unsigned)
+	static __m128i greaterEqual( __m128i blk, unsigned char value)
+	{
+		return _mm_cmpeq_epi8( _mm_max_epu8( blk, _mm_set1_epi8( (char)value)), blk);
+	}
+
+	/// \brief Get the mask of the bytes in a block that are less than or equal to a value (unsigned)
+	static __m128i lessEqual( __m128i blk, unsigned char value)
+	{
+		return _mm_cmpeq_epi8( _mm_min_epu8( blk, _mm_set1_epi8( (char)value)), blk);
+	}
+
+	/// \brief Check a block of 16 bytes with comparisons (without the byte shuffle needed for the lookup table method)
+	/// \remark A character not complete at the end of the block is not reported as error, its bytes in the block are checked as far as they go
+	/// \param [in] blk the block
+	/// \param [in] prev the block before (validated) or zero, if the block starts at a character boundary
+	/// \return the mask of errors, zero if the block contains no invalid sequence
+	static __m128i blockErrors( __m128i blk, __m128i prev)
+	{
+		__m128i prev1 = _mm_or_si128( _mm_slli_si128( blk, 1), _mm_srli_si128( prev, 15));
+		__m128i prev2 = _mm_or_si128( _mm_slli_si128( blk, 2), _mm_srli_si128( prev, 14));
+		__m128i prev3 = _mm_or_si128( _mm_slli_si128( blk, 3), _mm_srli_si128( prev, 13));
+
+		// ... a byte must be a continuation byte [0x80..0xBF] (signed less than 0xC0), if and only if one of the 3 bytes before is a lead byte of a character covering it
+		__m128i cont = _mm_cmplt_epi8( blk, _mm_set1_epi8( (char)0xC0));
+		__m128i must = _mm_or_si128( greaterEqual( prev1, 0xC0), _mm_or_si128( greaterEqual( prev2, 0xE0), greaterEqual( prev3, 0xF0)));
+		__m128i err = _mm_xor_si128( cont, must);
+
+		// ... lead bytes of overlong 2 byte sequences and of characters beyond 0x10FFFF
+		err = _mm_or_si128( err, _mm_cmpeq_epi8( _mm_and_si128( blk, _mm_set1_epi8( (char)0xFE)), _mm_set1_epi8( (char)0xC0)));
+		err = _mm_or_si128( err, greaterEqual( blk, 0xF5));
+
+		// ... second bytes of overlong 3/4 byte sequences, surrogates and characters beyond 0x10FFFF
+		err = _mm_or_si128( err, _mm_and_si128( _mm_cmpeq_epi8( prev1, _mm_set1_epi8( (char)0xE0)), lessEqual( blk, 0x9F)));
+		err = _mm_or_si128( err, _mm_and_si128( _mm_cmpeq_epi8( prev1, _mm_set1_epi8( (char)0xED)), greaterEqual( blk, 0xA0)));
+		err = _mm_or_si128( err, _mm_and_si128( _mm_cmpeq_epi8( prev1, _mm_set1_epi8( (char)0xF0)), lessEqual( blk, 0x8F)));
+		err = _mm_or_si128( err, _mm_and_si128( _mm_cmpeq_epi8( prev1, _mm_set1_epi8( (char)0xF4)), greaterEqual( blk, 0x90)));
+		return err;
+	}
+
+	/// \brief Check a block of 16 bytes without bytes >= 0xE0 in the block and the block before (ASCII and 2 byte characters only) with comparisons
+	/// \param [in] blk the block
+	/// \param [in] prev the block before (validated) or zero, if the block starts at a character boundary
+	/// \return the mask of errors, zero if the block contains no invalid sequence
+	static __m128i blockErrors2( __m128i blk, __m128i prev)
+	{
+		__m128i prev1 = _mm_or_si128( _mm_slli_si128( blk, 1), _mm_srli_si128( prev, 15));
+		__m128i cont = _mm_cmplt_epi8( blk, _mm_set1_epi8( (char)0xC0));
+		__m128i err = _mm_xor_si128( cont, greaterEqual( prev1, 0xC0));
+		return _mm_or_si128( err, _mm_cmpeq_epi8( _mm_and_si128( blk, _mm_set1_epi8( (char)0xFE)), _mm_set1_epi8( (char)0xC0)));
+	}
+#endif
+
+private:
+	std::size_t m_pos;		///< number of bytes validated before the current block
+	std::size_t m_seqpos;		///< position of the first byte of the character not complete yet
+	unsigned int m_need;		///< number of continuation bytes missing to complete the current character
+	unsigned char m_lo;		///< lower bound of the next continuation byte
+	unsigned char m_hi;		///< upper bound of the next continuation byte
+	bool m_failed;			///< true, if an invalid sequence has been found
+	std::size_t m_errpos;		///< position of the first invalid sequence found
+};
+
+}//namespace
+#endif
@@ -0,0 +1,222 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/widecharscanner.hpp
+/// \brief Classification and decoding of runs of code units of the wide character set encodings UTF-16, UCS-2 and UCS-4, vectorized with SSE2 if available
+
+#ifndef __TEXTWOLF_WIDE_CHAR_SCANNER_HPP__
+#define __TEXTWOLF_WIDE_CHAR_SCANNER_HPP__
+#include "textwolf/char.hpp"
+#include "textwolf/bytescan.hpp"
+#include "textwolf/charset_interface.hpp"
+#include "textwolf/charset_utf16.hpp"
+#include "textwolf/charset_ucs.hpp"
+#include <cstddef>
+
+namespace textwolf {
+
+/// \class WideCharScanner
+/// \brief Search for delimiters and decoding of runs of code units of 2 or 4 bytes without processing the characters one by one
+/// \tparam CodeUnitSize size of a code unit in bytes (2 or 4)
+/// \tparam byteorder charset::ByteOrder::LE or charset::ByteOrder::BE
+/// \tparam Surrogates 1 if a code unit with a high surrogate forms a character with the code unit following it (UTF-16), 0 else (UCS-2, UCS-4)
+/// \remark The search classifies 16 code units at once with SSE2 and searches the classes with the delimiter set, swapping the bytes of the code units in a vector for the byte order not native. Define TEXTWOLF_NO_SIMD to disable vectorization
+template <int CodeUnitSize, int byteorder, int Surrogates=0>
+class WideCharScanner
+{
+public:
+	/// \brief Find the first code unit that is a delimiter in the block [src,end)
+	/// \remark A code unit in the ASCII range is a delimiter, if its value is in the set, a code unit beyond the ASCII range, if 0x80 is in the set (like the byte of a non ASCII character in UTF-8)
+	/// \param[in] delim set of delimiters
+	/// \param[in] src start of the block to search
+	/// \param[in] end end of the block to search or NULL for a block terminated with the code unit 0 (0 has to be an element of the set then)
+	/// \return pointer to the first delimiter found or to the end of the last complete code unit in the block, if there is none
+	static const char* findDelimiter( const ByteScanTable& delim, const char* src, const char* end)
+	{
+		if (!end)
+		{
+			for (; !delim[ unitClass( src)]; src += CodeUnitSize){}
+			return src;
+		}
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+		enum {NofClasses=32,BlockSize=NofClasses*CodeUnitSize};
+		char cls[ NofClasses];
+		for (; src + BlockSize <= end; src += BlockSize)
+		{
+			_mm_storeu_si128( (__m128i*)cls, unitClasses( src));
+			_mm_storeu_si128( (__m128i*)(cls + 16), unitClasses( src + 16*CodeUnitSize));
+			const char* dd = delim.find( cls, cls + NofClasses);
+			if (dd != cls + NofClasses) return src + CodeUnitSize*(dd - cls);
+		}
+#endif
+		for (; src + CodeUnitSize <= end; src += CodeUnitSize)
+		{
+			if (delim[ unitClass( src)]) return src;
+		}
+		return src;
+	}
+
+	/// \brief Decode the characters of a run of code units
+	/// \param[in] src pointer to the code units
+	/// \param[in] srcsize size of the input in bytes
+	/// \param[out] dest where to write the characters to, at least srcsize/CodeUnitSize elements
+	/// \param[out] destsize number of characters written to 'dest'
+	/// \return number of bytes of the input decoded, less than 'srcsize' if the decoding stopped at a high surrogate not followed by a low surrogate in the input (UTF-16), that has to be processed by the character set encoding
+	static std::size_t decode( const char* src, std::size_t srcsize, UChar* dest, std::size_t& destsize)
+	{
+		std::size_t ii = 0;
+		UChar* dd = dest;
+		for (; ii + CodeUnitSize <= srcsize; ii += CodeUnitSize)
+		{
+			UChar ch = unit( src + ii);
+			if (Surrogates && ch - 0xD800 < 0x400)
+			{
+				if (ii + 2*CodeUnitSize > srcsize) break;
+				UChar lo = unit( src + ii + CodeUnitSize);
+				if (lo - 0xDC00 >= 0x400) break;
+				ch = ((ch - 0xD800) << 10) + (lo - 0xDC00) + 0x10000;
+				ii += CodeUnitSize;
+			}
+			*dd++ = ch;
+		}
+		destsize = dd - dest;
+		return ii;
+	}
+
+	/// \brief Get the value of the code unit at 'src'
+	static UChar unit( const char* src)
+	{
+		const unsigned char* uu = (const unsigned char*)src;
+		if (CodeUnitSize == 2)
+		{
+			return (byteorder == charset::ByteOrder::BE)
+				? (((UChar)uu[0] << 8) | uu[1])
+				: (((UChar)uu[1] << 8) | uu[0]);
+		}
+		return (byteorder == charset::ByteOrder::BE)
+			? (((UChar)uu[0] << 24) | ((UChar)uu[1] << 16) | ((UChar)uu[2] << 8) | uu[3])
+			: (((UChar)uu[3] << 24) | ((UChar)uu[2] << 16) | ((UChar)uu[1] << 8) | uu[0]);
+	}
+
+	/// \brief Get the byte representing the code unit at 'src' in a delimiter set (see findDelimiter(const ByteScanTable&,const char*,const char*))
+	static unsigned char unitClass( const char* src)
+	{
+		UChar ch = unit( src);
+		return (ch >= 0x80) ? 0x80 : (unsigned char)ch;
+	}
+
+private:
+#if defined(TEXTWOLF_SIMD_AVX2) || defined(TEXTWOLF_SIMD_SSE2)
+	/// \brief Get the bytes representing 16 code units in a delimiter set (see unitClass(const char*))
+	static __m128i unitClasses( const char* src)
+	{
+		if (CodeUnitSize == 2)
+		{
+			return _mm_packus_epi16( unitClasses16( src), unitClasses16( src + 16));
+		}
+		return _mm_packus_epi16(
+				_mm_packs_epi32( unitClasses32( src), unitClasses32( src + 16)),
+				_mm_packs_epi32( unitClasses32( src + 32), unitClasses32( src + 48)));
+	}
+
+	/// \brief Get the bytes representing 8 code units of 2 bytes in a delimiter set as 16 bit elements
+	static __m128i unitClasses16( const char* src)
+	{
+		__m128i units = _mm_loadu_si128( (const __m128i*)src);
+		if (byteorder == charset::ByteOrder::BE)
+		{
+			units = _mm_or_si128( _mm_slli_epi16( units, 8), _mm_srli_epi16( units, 8));
+		}
+		__m128i ascii = _mm_cmpeq_epi16( _mm_and_si128( units, _mm_set1_epi16( (short)0xFF80)), _mm_setzero_si128());
+		return _mm_or_si128( _mm_and_si128( ascii, units), _mm_andnot_si128( ascii, _mm_set1_epi16( 0x80)));
+	}
+
+	/// \brief Get the bytes representing 4 code units of 4 bytes in a delimiter set as 32 bit elements
+	static __m128i unitClasses32( const char* src)
+	{
+		__m128i units = _mm_loadu_si128( (const __m128i*)src);
+		if (byteorder == charset::ByteOrder::BE)
+		{
+			__m128i mid = _mm_set1_epi32( 0xFF00);
+			units = _mm_or_si128(
+					_mm_or_si128( _mm_slli_epi32( units, 24), _mm_srli_epi32( units, 24)),
+					_mm_or_si128( _mm_slli_epi32( _mm_and_si128( units, mid), 8), _mm_and_si128( _mm_srli_epi32( units, 8), mid)));
+		}
+		__m128i ascii = _mm_cmpeq_epi32( _mm_and_si128( units, _mm_set1_epi32( (int)0xFFFFFF80)), _mm_setzero_si128());
+		return _mm_or_si128( _mm_and_si128( ascii, units), _mm_andnot_si128( ascii, _mm_set1_epi32( 0x80)));
+	}
+#endif
+};
+
+/// \class WideCharScanning
+/// \brief WideCharScanner selected for a character set encoding (see TextScanner::copyRun, TextScanner::printRun)
+/// \remark This default is for character set encodings without wide code units. UTF-16, UCS-2 and UCS-4 specialize it
+/// \tparam CharSet character set encoding
+template <class CharSet>
+struct WideCharScanning
+{
+	enum {Enabled=0};				///< 1 if runs of the character set encoding can be processed with Scanner
+	typedef WideCharScanner<2,charset::ByteOrder::LE> Scanner;
+};
+
+template <int encoding>
+struct WideCharScanning<charset::UTF16<encoding> >
+{
+	enum {Enabled=1};
+	typedef WideCharScanner<2,encoding,1> Scanner;
+};
+
+template <int byteorder>
+struct WideCharScanning<charset::UCS2<byteorder> >
+{
+	enum {Enabled=1};
+	typedef WideCharScanner<2,byteorder> Scanner;
+};
+
+template <int byteorder>
+struct WideCharScanning<charset::UCS4<byteorder> >
+{
+	enum {Enabled=1};
+	typedef WideCharScanner<4,byteorder> Scanner;
+};
+
+template <> struct WideCharScanning<charset::UTF16LE> :public WideCharScanning<charset::UTF16<charset::ByteOrder::LE> > {};
+template <> struct WideCharScanning<charset::UTF16BE> :public WideCharScanning<charset::UTF16<charset::ByteOrder::BE> > {};
+template <> struct WideCharScanning<charset::UCS2LE> :public WideCharScanning<charset::UCS2<charset::ByteOrder::LE> > {};
+template <> struct WideCharScanning<charset::UCS2BE> :public WideCharScanning<charset::UCS2<charset::ByteOrder::BE> > {};
+template <> struct WideCharScanning<charset::UCS4LE> :public WideCharScanning<charset::UCS4<charset::ByteOrder::LE> > {};
+template <> struct WideCharScanning<charset::UCS4BE> :public WideCharScanning<charset::UCS4<charset::ByteOrder::BE> > {};
+
+}//namespace
+#endif
@@ -0,0 +1,373 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/xmlbatchprocessor.hpp
+/// \brief Processing of many documents with one XML path select automaton by a pool of threads
+
+#ifndef __TEXTWOLF_XML_BATCH_PROCESSOR_HPP__
+#define __TEXTWOLF_XML_BATCH_PROCESSOR_HPP__
+#include "textwolf/xmlscanner.hpp"
+#include "textwolf/xmlpathselect.hpp"
+#include "textwolf/xmlpathautomaton.hpp"
+#include "textwolf/cstringiterator.hpp"
+#include "textwolf/thread.hpp"
+#include "textwolf/charset.hpp"
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class XMLBatchResults
+/// \brief Results of one worker of a XMLBatchProcessor: the elements selected (document id, type, value) and the documents that could not be processed (document id, error message)
+class XMLBatchResults
+{
+public:
+	/// \brief Constructor
+	XMLBatchResults(){}
+
+	/// \brief Remove all results
+	void clear()
+	{
+		m_results.clear();
+		m_errors.clear();
+		m_arena.clear();
+	}
+
+	/// \brief Add a selected element
+	/// \param [in] docid_ id of the document
+	/// \param [in] type_ type assigned to the path expression in the automaton
+	/// \param [in] value_ pointer to the value of the element
+	/// \param [in] valuesize_ size of the value in bytes
+	void push( std::size_t docid_, int type_, const char* value_, std::size_t valuesize_)
+	{
+		Result rr;
+		rr.docid = docid_;
+		rr.type = type_;
+		rr.offset = m_arena.size();
+		rr.size = valuesize_;
+		m_arena.append( value_, valuesize_);
+		m_results.push_back( rr);
+	}
+
+	/// \brief Add a document that could not be processed
+	/// \param [in] docid_ id of the document
+	/// \param [in] msg_ error message
+	/// \param [in] msgsize_ size of the error message in bytes
+	void pushError( std::size_t docid_, const char* msg_, std::size_t msgsize_)
+	{
+		Error ee;
+		ee.docid = docid_;
+		ee.offset = m_arena.size();
+		ee.size = msgsize_;
+		m_arena.append( msg_, msgsize_);
+		m_errors.push_back( ee);
+	}
+
+	/// \brief Get the number of elements selected
+	std::size_t size() const				{return m_results.size();}
+	/// \brief Get the id of the document of the selected element with index idx
+	std::size_t docid( std::size_t idx) const		{return m_results[ idx].docid;}
+	/// \brief Get the type of the selected element with index idx
+	int type( std::size_t idx) const			{return m_results[ idx].type;}
+	/// \brief Get the value of the selected element with index idx (valid until the next call of push or clear)
+	const char* value( std::size_t idx) const		{return m_arena.data() + m_results[ idx].offset;}
+	/// \brief Get the size of the value in bytes of the selected element with index idx
+	std::size_t valueSize( std::size_t idx) const		{return m_results[ idx].size;}
+
+	/// \brief Get the number of documents that could not be processed
+	std::size_t nofErrors() const				{return m_errors.size();}
+	/// \brief Get the id of the document with the error with index idx
+	std::size_t errorDocid( std::size_t idx) const		{return m_errors[ idx].docid;}
+	/// \brief Get the error message with index idx
+	std::string error( std::size_t idx) const		{return std::string( m_arena.data() + m_errors[ idx].offset, m_errors[ idx].size);}
+
+private:
+	/// \class Result
+	/// \brief Element selected
+	struct Result
+	{
+		std::size_t docid;		///< id of the document
+		int type;			///< type assigned to the path expression in the automaton
+		std::size_t offset;		///< offset of the value in the arena
+		std::size_t size;		///< size of the value in bytes
+	};
+	/// \class Error
+	/// \brief Document that could not be processed
+	struct Error
+	{
+		std::size_t docid;		///< id of the document
+		std::size_t offset;		///< offset of the error message in the arena
+		std::size_t size;		///< size of the error message in bytes
+	};
+	std::vector<Result> m_results;		///< elements selected
+	std::vector<Error> m_errors;		///< documents with errors
+	std::string m_arena;			///< values of the elements selected and error messages
+};
+
+/// \class XMLBatchProcessor
+/// \brief Processor of many documents in memory with the same XML path select automaton by a pool of threads
+/// \remark Each worker thread owns a XMLScanner and a XMLPathSelect reused for all its documents and writes its results into its own XMLBatchResults buffer, so that the workers share nothing but the read only automaton. The queue of documents is split into equal parts, one per worker. A worker that finished its part steals the upper half of the remaining documents of another worker
+/// \tparam InputCharSet_ character set encoding of the documents
+/// \tparam CharSet_ character set encoding of the automaton and of the values selected
+template <class InputCharSet_, class CharSet_=charset::UTF8>
+class XMLBatchProcessor
+{
+public:
+	typedef XMLPathSelectAutomaton<CharSet_> Automaton;
+	typedef XMLScanner<CStringIterator,InputCharSet_,CharSet_,std::string> Scanner;
+	typedef XMLPathSelect<CharSet_> Selector;
+
+	/// \brief Constructor
+	/// \param [in] atm_ automaton completely defined, shared by the workers, must not be modified during processing
+	/// \param [in] nofThreads_ number of worker threads
+	XMLBatchProcessor( const Automaton* atm_, unsigned int nofThreads_)
+	{
+		if (!nofThreads_) nofThreads_ = 1;
+		try
+		{
+			for (unsigned int ii=0; ii<nofThreads_; ++ii)
+			{
+				m_workers.push_back( 0);
+				m_workers.back() = new Worker( this, atm_);
+			}
+		}
+		catch (...)
+		{
+			deleteWorkers();
+			throw;
+		}
+	}
+
+	/// \brief Destructor
+	~XMLBatchProcessor()
+	{
+		deleteWorkers();
+	}
+
+	/// \brief Add a document to the queue of documents to process
+	/// \param [in] docid_ id of the document returned with its results
+	/// \param [in] src_ pointer to the document, must stay valid until run() returned
+	/// \param [in] srcsize_ size of the document in bytes
+	void push( std::size_t docid_, const char* src_, std::size_t srcsize_)
+	{
+		Document doc;
+		doc.docid = docid_;
+		doc.src = src_;
+		doc.srcsize = srcsize_;
+		m_documents.push_back( doc);
+	}
+
+	/// \brief Process all documents of the queue and clear the queue
+	/// \remark The results of previous runs are cleared. Documents with errors are reported with XMLBatchResults::pushError and do not stop the processing of the others
+	void run()
+	{
+		std::size_t nofWorkers_ = m_workers.size();
+		for (std::size_t ii=0; ii<nofWorkers_; ++ii)
+		{
+			Worker* ww = m_workers[ ii];
+			ww->results.clear();
+			ww->next = (m_documents.size() * ii) / nofWorkers_;
+			ww->end = (m_documents.size() * (ii+1)) / nofWorkers_;
+		}
+		std::vector<Thread*> threads;
+		try
+		{
+			for (std::size_t ii=1; ii<nofWorkers_; ++ii)
+			{
+				threads.push_back( new Thread());
+				threads.back()->start( m_workers[ ii]);
+			}
+			// ... the first worker runs in this thread
+			m_workers[ 0]->run();
+		}
+		catch (...)
+		{
+			deleteThreads( threads);
+			m_documents.clear();
+			throw;
+		}
+		deleteThreads( threads);
+		m_documents.clear();
+	}
+
+	/// \brief Get the number of workers (threads)
+	unsigned int nofWorkers() const
+	{
+		return m_workers.size();
+	}
+
+	/// \brief Get the results of a worker of the last run
+	/// \param [in] idx index of the worker
+	const XMLBatchResults& results( unsigned int idx) const
+	{
+		return m_workers[ idx]->results;
+	}
+
+private:
+	/// \class Document
+	/// \brief Document in the queue
+	struct Document
+	{
+		std::size_t docid;		///< id of the document
+		const char* src;		///< pointer to the document
+		std::size_t srcsize;		///< size of the document in bytes
+	};
+
+	/// \class Worker
+	/// \brief Worker processing documents with its own scanner and selector
+	struct Worker :public Thread::Task
+	{
+		XMLBatchProcessor* processor;	///< processor with the queue of documents
+		Scanner scanner;		///< scanner reused for all documents of the worker
+		Selector selector;		///< selector reused for all documents of the worker
+		XMLBatchResults results;	///< results of the worker
+		Mutex mutex;			///< lock for the range of documents [next,end) of the worker
+		std::size_t next;		///< index of the next document to process in the queue
+		std::size_t end;		///< end of the range of documents of the worker in the queue
+
+		Worker( XMLBatchProcessor* processor_, const Automaton* atm_)
+			:processor(processor_),scanner(CStringIterator()),selector(atm_),next(0),end(0)
+		{
+			scanner.setZeroCopy();
+		}
+
+		/// \brief Process documents until there is no document left in the queue
+		virtual void run()
+		{
+			std::size_t docidx;
+			while (processor->fetch( this, docidx))
+			{
+				const Document& doc = processor->m_documents[ docidx];
+				try
+				{
+					process( doc);
+				}
+				catch (const std::exception& err)
+				{
+					results.pushError( doc.docid, err.what(), std::strlen( err.what()));
+				}
+			}
+		}
+
+		/// \brief Process one document
+		void process( const Document& doc)
+		{
+			scanner.restart( CStringIterator( doc.src, doc.srcsize));
+			selector.reset();
+			for (;;)
+			{
+				XMLScannerBase::ElementType et = scanner.nextItem();
+				if (et == XMLScannerBase::Exit) break;
+				if (et == XMLScannerBase::ErrorOccurred)
+				{
+					const char* msg;
+					scanner.getError( &msg);
+					results.pushError( doc.docid, msg, std::strlen( msg));
+					break;
+				}
+				typename Selector::iterator itr = selector.push( et, scanner.getItemPtr(), scanner.getItemSize()), end = selector.end();
+				for (; itr != end; ++itr)
+				{
+					results.push( doc.docid, *itr, scanner.getItemPtr(), scanner.getItemSize());
+				}
+			}
+		}
+	};
+	friend struct Worker;
+
+	/// \brief Fetch the next document to process for a worker, steal documents from other workers if its own range is empty
+	/// \param [in] ww worker
+	/// \param [out] docidx index of the document in the queue
+	/// \return true, if a document was fetched, false if there are no documents left
+	bool fetch( Worker* ww, std::size_t& docidx)
+	{
+		{
+			Mutex::Lock lock( ww->mutex);
+			if (ww->next < ww->end)
+			{
+				docidx = ww->next++;
+				return true;
+			}
+		}
+		std::size_t wi = 0, nofWorkers_ = m_workers.size();
+		for (; wi < nofWorkers_ && m_workers[ wi] != ww; ++wi){}
+		for (std::size_t ii=1; ii<nofWorkers_; ++ii)
+		{
+			Worker* victim = m_workers[ (wi + ii) % nofWorkers_];
+			std::size_t from, to;
+			{
+				Mutex::Lock lock( victim->mutex);
+				if (victim->next >= victim->end) continue;
+				from = victim->next + (victim->end - victim->next) / 2;
+				to = victim->end;
+				victim->end = from;
+			}
+			Mutex::Lock lock( ww->mutex);
+			docidx = from;
+			ww->next = from+1;
+			ww->end = to;
+			return true;
+		}
+		return false;
+	}
+
+	static void deleteThreads( std::vector<Thread*>& threads)
+	{
+		std::vector<Thread*>::iterator ti = threads.begin(), te = threads.end();
+		for (; ti != te; ++ti) delete *ti;	//... joins the thread
+		threads.clear();
+	}
+
+	void deleteWorkers()
+	{
+		typename std::vector<Worker*>::iterator wi = m_workers.begin(), we = m_workers.end();
+		for (; wi != we; ++wi) delete *wi;
+		m_workers.clear();
+	}
+
+private:
+	XMLBatchProcessor( const XMLBatchProcessor&);			///< non copyable
+	XMLBatchProcessor& operator=( const XMLBatchProcessor&);	///< non copyable
+
+	std::vector<Worker*> m_workers;			///< workers, the first one runs in the thread calling run()
+	std::vector<Document> m_documents;		///< queue of documents to process
+};
+
+}//namespace
+#endif
@@ -0,0 +1,249 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this Object refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/xmlparallelscanner.hpp
+/// \brief XML scanner for large documents in memory scanning ranges of the document in parallel
+
+#ifndef __TEXTWOLF_XML_PARALLEL_SCANNER_HPP__
+#define __TEXTWOLF_XML_PARALLEL_SCANNER_HPP__
+#include "textwolf/xmlscanner.hpp"
+#include "textwolf/sourceiterator.hpp"
+#include "textwolf/entitytable.hpp"
+#include "textwolf/thread.hpp"
+#include <vector>
+#include <string>
+#include <cstring>
+#include <cstddef>
+#include <stdexcept>
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class XMLParallelScanner
+/// \brief XML scanner for large documents in memory, that splits the document into ranges and scans them in parallel threads
+/// \remark Each range starts at a '&lt;' and is scanned speculatively as if this was the start of a tag in content. When stitching the results together, a range is accepted if the scan of the range before it ends with the '&lt;' starting the range as start of a tag. Otherwise the range started in a comment, a CDATA section, an attribute string, etc. and it is scanned again as continuation of the range before it. The elements returned are the same as those of a sequential XMLScanner on the document
+/// \tparam InputCharSet_ character set encoding of the input, must be byte oriented (e.g. UTF-8, IsoLatin)
+/// \tparam OutputCharSet_ character set encoding of the output
+template <class InputCharSet_, class OutputCharSet_>
+class XMLParallelScanner
+{
+public:
+	typedef XMLScanner<SrcIterator,InputCharSet_,OutputCharSet_,std::string> Scanner;
+
+	/// \brief Constructor
+	/// \param [in] src pointer to the document, must stay valid during scanning
+	/// \param [in] srcsize size of the document in bytes
+	/// \param [in] nofThreads number of ranges scanned in parallel
+	XMLParallelScanner( const char* src, std::size_t srcsize, unsigned int nofThreads)
+		:m_src(src),m_srcsize(srcsize),m_nofThreads(nofThreads?nofThreads:1),m_entityTable(0),m_nofRescans(0){}
+
+	/// \brief Constructor
+	/// \param [in] src pointer to the document, must stay valid during scanning
+	/// \param [in] srcsize size of the document in bytes
+	/// \param [in] nofThreads number of ranges scanned in parallel
+	/// \param [in] p_entityTable read only table of named entities defined by the user
+	XMLParallelScanner( const char* src, std::size_t srcsize, unsigned int nofThreads, const EntityTable& p_entityTable)
+		:m_src(src),m_srcsize(srcsize),m_nofThreads(nofThreads?nofThreads:1),m_entityTable(&p_entityTable),m_nofRescans(0){}
+
+	/// \brief Scan the document
+	/// \param [out] out buffer for all elements of the document, the last one is Exit or ErrorOccurred
+	void scan( EventBuffer& out)
+	{
+		typedef char InputCharSetMustBeByteOriented[ ((int)InputCharSet_::CodeUnitSize == 1)?1:-1];
+		(void)sizeof(InputCharSetMustBeByteOriented);
+
+		RangeArray ranges;
+		split( ranges);
+		{
+			std::vector<Thread*> threads;
+			try
+			{
+				for (std::size_t ii=1; ii<ranges.size(); ++ii)
+				{
+					threads.push_back( new Thread());
+					threads.back()->start( ranges[ ii]);
+				}
+				// ... the first range is scanned in this thread, an exception is thrown to the caller like in a sequential scan
+				ranges[ 0]->scan();
+			}
+			catch (...)
+			{
+				deleteAll( threads);
+				throw;
+			}
+			deleteAll( threads);
+		}
+		out.clear();
+		m_nofRescans = 0;
+		Range* cur = ranges[ 0];
+		out.append( cur->events);
+		for (std::size_t ii=1; ii<ranges.size() && cur->last == XMLScannerBase::NeedMoreInput; ++ii)
+		{
+			Range* next = ranges[ ii];
+			if (cur->scanner.getStateId() == XMLScannerBase::XMLTAG && !next->failed)
+			{
+				// ... the scan of the range before ended with the '<' starting this range as start of a tag, as assumed
+				out.append( next->events);
+				cur = next;
+			}
+			else
+			{
+				// ... wrong assumption, continue the scan of the range before, that includes the '<' starting this range
+				++m_nofRescans;
+				cur->scanner.putInput( next->chunk + 1, next->chunksize - 1, next->eof);
+				cur->last = collect( cur->scanner, out);
+			}
+		}
+	}
+
+	/// \brief Get the number of ranges that had to be scanned again in the last call of scan(EventBuffer&), because the assumption about the state at their start was wrong
+	std::size_t nofRescans() const
+	{
+		return m_nofRescans;
+	}
+
+private:
+	/// \class Range
+	/// \brief Range of the document scanned in its own thread
+	struct Range :public Thread::Task
+	{
+		const char* chunk;			///< start of the range (a '<' except for the first range)
+		std::size_t chunksize;			///< size of the range in bytes, including the '<' starting the next range
+		bool eof;				///< true, if this is the last range
+		Scanner scanner;			///< scanner of the range
+		EventBuffer events;			///< elements scanned in the range
+		XMLScannerBase::ElementType last;	///< element type that stopped the scan (NeedMoreInput, Exit or ErrorOccurred)
+		bool failed;				///< true, if the scan of the range failed with an exception
+
+		Range( const char* chunk_, std::size_t chunksize_, bool eof_, bool first_, const EntityTable* entityTable_)
+			:chunk(chunk_),chunksize(chunksize_),eof(eof_),scanner(scannerInstance( entityTable_)),last(XMLScannerBase::None),failed(false)
+		{
+			if (!first_) scanner.setState( XMLScannerBase::CONTENT);
+			scanner.setZeroCopy();
+		}
+
+		/// \brief Scan the range
+		void scan()
+		{
+			scanner.putInput( chunk, chunksize, eof);
+			last = collect( scanner, events);
+		}
+
+		/// \brief Scan the range in a thread
+		virtual void run()
+		{
+			try
+			{
+				scan();
+			}
+			catch (const std::exception&)
+			{
+				failed = true;
+			}
+		}
+
+		static Scanner scannerInstance( const EntityTable* entityTable_)
+		{
+			return entityTable_?Scanner( SrcIterator(), *entityTable_):Scanner( SrcIterator());
+		}
+	};
+
+	/// \class RangeArray
+	/// \brief Array of ranges owning them
+	struct RangeArray :public std::vector<Range*>
+	{
+		~RangeArray()
+		{
+			typename std::vector<Range*>::iterator ri = this->begin(), re = this->end();
+			for (; ri != re; ++ri) delete *ri;
+		}
+	};
+
+	static void deleteAll( std::vector<Thread*>& threads)
+	{
+		std::vector<Thread*>::iterator ti = threads.begin(), te = threads.end();
+		for (; ti != te; ++ti) delete *ti;	//... joins the thread
+		threads.clear();
+	}
+
+	/// \brief Scan elements until the scanner consumed the input passed, reached the end of the document or got an error
+	/// \return the element type that stopped the scan (NeedMoreInput, Exit or ErrorOccurred)
+	static XMLScannerBase::ElementType collect( Scanner& scanner, EventBuffer& events)
+	{
+		for (;;)
+		{
+			XMLScannerBase::ElementType type = scanner.nextItem();
+			if (type == XMLScannerBase::NeedMoreInput) return type;
+			events.push( type, scanner.getItemPtr(), scanner.getItemSize());
+			if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return type;
+		}
+	}
+
+	/// \brief Split the document into ranges starting with a '<' of about equal size
+	void split( RangeArray& ranges) const
+	{
+		std::vector<std::size_t> start;
+		start.push_back( 0);
+		for (unsigned int ii=1; ii<m_nofThreads; ++ii)
+		{
+			std::size_t pos = (std::size_t)(((double)m_srcsize * ii) / m_nofThreads);
+			if (pos <= start.back()) pos = start.back() + 1;
+			if (pos >= m_srcsize) break;
+			const char* lt = (const char*)std::memchr( m_src + pos, '<', m_srcsize - pos);
+			if (!lt) break;
+			start.push_back( lt - m_src);
+		}
+		for (std::size_t ii=0; ii<start.size(); ++ii)
+		{
+			bool eof = (ii+1 == start.size());
+			std::size_t end = eof?m_srcsize:(start[ ii+1] + 1);
+			ranges.push_back( 0);
+			ranges.back() = new Range( m_src + start[ ii], end - start[ ii], eof, ii==0, m_entityTable);
+		}
+	}
+
+private:
+	XMLParallelScanner( const XMLParallelScanner&);			///< non copyable
+	XMLParallelScanner& operator=( const XMLParallelScanner&);	///< non copyable
+
+	const char* m_src;			///< document to scan
+	std::size_t m_srcsize;			///< size of the document in bytes
+	unsigned int m_nofThreads;		///< number of ranges scanned in parallel
+	const EntityTable* m_entityTable;	///< table with entities defined by the caller or NULL
+	std::size_t m_nofRescans;		///< number of ranges scanned again in the last scan
+};
+
+}//namespace
+#endif
@@ -55,6 +55,7 @@ namespace textwolf {
 ///\class XMLPathSelectAutomaton
 ///\tparam CharSet_ character set of the token defintions of the automaton
 ///\brief Automaton to define XML path expressions and assign types (int values) to them
+///\remark XMLPathSelect only reads the automaton through a const pointer. An automaton completely defined can be shared by selectors running in different threads without locking, as long as it is not modified anymore
 template <class CharSet_=charset::UTF8>
 class XMLPathSelectAutomaton :public throws_exception
 {
@@ -63,7 +63,7 @@ public:
 
 /// \brief XML path select template
 /// \tparam CharSet_ character set encoding of the automaton elements
-/// \tparam StackType_ stack type used for tokens,triggers and scopes (as back insertion sequence with random access by index)
+/// \tparam StackType_ stack type used for tokens,triggers and scopes (as back insertion sequence with random access by index and clear())
 template <class CharSet_, template <typename> class StackType_=DefaultStackType>
 class XMLPathSelect :public throws_exception
 {
@@ -90,7 +90,7 @@ private:
 		unsigned int scope_iter;		//< position of currently visited token in the active scope
 
 		/// \brief Constructor
-		Context()				:type(XMLScannerBase::Content),key(0),keysize(0) {}
+		Context()				:type(XMLScannerBase::Content),key(0),keysize(0),scope_iter(0) {}
 
 		/// \brief Initialization
 		/// \param [in] p_type type of the current element processed
@@ -361,6 +361,17 @@ public:
 	XMLPathSelect( const XMLPathSelect& o)
 		:atm(o.atm),scopestk(o.scopestk),follows(o.follows),triggers(o.triggers),tokens(o.tokens){}
 
+	/// \brief Reset the selector to the start of a new document, keeping the memory allocated for the stacks
+	void reset()
+	{
+		scopestk.clear();
+		follows.clear();
+		triggers.clear();
+		tokens.clear();
+		context = Context();
+		if (atm->states.size() > 0) expand(0);
+	}
+
 	/// \class iterator
 	/// \brief input iterator for the output of this XMLScanner
 	class iterator
@@ -64,15 +64,24 @@ private:
 	/// \param [out] buf buffer to append result to
 	void printToBuffer( const char* src, std::size_t srcsize, BufferType& buf) const
 	{
+		enum {ChunkSize=128};
+		UChar tmp[ ChunkSize];
+		std::size_t tmpsize = 0;
 		CStringIterator itr( src, srcsize);
 		TextScanner<CStringIterator,AppCharset> ts( itr);
 
 		UChar ch;
 		while ((ch = ts.chr()) != 0)
 		{
-			m_output.print( ch, buf);
+			tmp[ tmpsize++] = ch;
+			if (tmpsize == ChunkSize)
+			{
+				m_output.print( tmp, tmp + tmpsize, buf);
+				tmpsize = 0;
+			}
 			++ts;
 		}
+		m_output.print( tmp, tmp + tmpsize, buf);
 	}
 
 	/// \brief print a character substitute or the character itself
@@ -105,22 +114,34 @@ private:
 	/// \param [in] estr ASCII strings to substitute with (array parallel to echr)
 	void printToBufferSubstChr( const char* src, std::size_t srcsize, BufferType& buf, unsigned int nof_echr, const char* echr, const char** estr) const
 	{
+		enum {ChunkSize=128};
+		UChar tmp[ ChunkSize];
+		std::size_t tmpsize = 0;
 		CStringIterator itr( src, srcsize);
 		textwolf::TextScanner<CStringIterator,AppCharset> ts( itr);
 
 		textwolf::UChar ch;
 		while ((ch = ts.chr()) != 0)
 		{
-			if (ch < 128)
+			if (ch < 128 && memchr( echr, (char)ch, nof_echr))
 			{
+				// ... the characters collected are printed before the substitute
+				m_output.print( tmp, tmp + tmpsize, buf);
+				tmpsize = 0;
 				printEsc( (char)ch, buf, nof_echr, echr, estr);
 			}
 			else
 			{
-				m_output.print( ch, buf);
+				tmp[ tmpsize++] = ch;
+				if (tmpsize == ChunkSize)
+				{
+					m_output.print( tmp, tmp + tmpsize, buf);
+					tmpsize = 0;
+				}
 			}
 			++ts;
 		}
+		m_output.print( tmp, tmp + tmpsize, buf);
 	}
 
 	/// \brief print attribute value string
@@ -41,8 +41,15 @@
 #include "textwolf/charset_interface.hpp"
 #include "textwolf/exception.hpp"
 #include "textwolf/textscanner.hpp"
+#include "textwolf/sourceiterator.hpp"
 #include "textwolf/traits.hpp"
+#include "textwolf/entitytable.hpp"
+#include "textwolf/utf8validator.hpp"
 #include <map>
+#include <string>
+#include <functional>
+#include <vector>
+#include <cstring>
 #include <cstddef>
 
 namespace textwolf {
@@ -213,11 +220,12 @@ public:
 		CloseTag,				///< [11] close tag (e.g. "bla" for "&lt;/bla&gt;")
 		CloseTagIm,				///< [12] immediate close tag (e.g. "bla" for "&lt;bla /&gt;")
 		Content,				///< [13] content element string (separated by spaces or end of line)
-		Exit					///< [14] end of document
+		Exit,					///< [14] end of document
+		NeedMoreInput				///< [15] end of the input chunk passed in push mode reached (see XMLScanner::putInput(const char*,std::size_t,bool)). Only returned in push mode, but a switch over all element types needs a case for it
 	};
 	enum
 	{
-		NofElementTypes=Exit+1			///< number of XML element types defined
+		NofElementTypes=NeedMoreInput+1		///< number of XML element types defined
 	};
 
 	/// \brief Get the XML element type as string
@@ -225,7 +233,7 @@ public:
 	/// \return XML element type as string
 	static const char* getElementTypeName( ElementType ee)
 	{
-		static const char* names[ NofElementTypes] = {"None","ErrorOccurred","HeaderStart","HeaderAttribName","HeaderAttribValue","HeaderEnd", "DocAttribValue", "DocAttribEnd", "TagAttribName","TagAttribValue","OpenTag","CloseTag","CloseTagIm","Content","Exit"};
+		static const char* names[ NofElementTypes] = {"None","ErrorOccurred","HeaderStart","HeaderAttribName","HeaderAttribValue","HeaderEnd", "DocAttribValue", "DocAttribEnd", "TagAttribName","TagAttribValue","OpenTag","CloseTag","CloseTagIm","Content","Exit","NeedMoreInput"};
 		return names[ (unsigned int)ee];
 	}
 
@@ -248,7 +256,8 @@ public:
 		ErrInternal,				///< internal error (textwolf implementation error)
 		ErrUnexpectedEndOfInput,		///< unexpected end of input stream
 		ErrExpectedEndOfLine,			///< expected mandatory end of line (after XML header)
-		ErrExpectedDash2			///< expected second '-' after '<!-' to start an XML comment as '<!-- ... -->'
+		ErrExpectedDash2,			///< expected second '-' after '<!-' to start an XML comment as '<!-- ... -->'
+		ErrInvalidUTF8				///< invalid UTF-8 sequence in the input (strict UTF-8 mode, see XMLScanner::setStrictUTF8(bool))
 	};
 
 	/// \brief Get the error code as string
@@ -256,7 +265,7 @@ public:
 	/// \return the error code as string
 	static const char* getErrorString( Error ee)
 	{
-		enum {NofErrors=16};
+		enum {NofErrors=17};
 		static const char* sError[NofErrors]
 			= {0,"illegal document attribute definition",
 				"expected open tag",
@@ -272,7 +281,8 @@ public:
 				"internal (illegal state)",
 				"unexpected end of input",
 				"expected end of line",
-				"expected 2nd '-' to complete marker for start of comment '<!--'"
+				"expected 2nd '-' to complete marker for start of comment '<!--'",
+				"invalid UTF-8 sequence"
 		};
 		return sError[(unsigned int)ee];
 	}
@@ -439,8 +449,426 @@ public:
 			(*this)(Dq,false)(Space,true);
 		}
 	};
+
+	/// \class TokenRunSet
+	/// \brief Set of source bytes that terminate a run of token characters that can be copied without processing (see TextScanner::copyRun)
+	/// \remark The sets of the actions are constant data in XMLScannerTables::tokenRun, this is the definition they are checked against in tests/test_XMLScannerTables.cpp
+	struct TokenRunSet :public ByteScanSet
+	{
+		/// \brief Constructor
+		/// \param [in] isTok set of valid token characters indexed by ControlCharacter
+		explicit TokenRunSet( const bool* isTok)
+		{
+			for (unsigned int ii=0; ii<256; ++ii)
+			{
+				if (!isTok[ ControlCharTable<>::ar[ ii]]) (*this)( (unsigned char)ii);
+			}
+			// ... end of text, entities and end of line translation are handled by the character wise parsing
+			(*this)( 0)( '&')( '\r');
+		}
+	};
 };
 
+/// \class EventBuffer
+/// \brief Buffer for a batch of XML elements scanned with XMLScanner::nextItems(EventBuffer&,std::size_t,unsigned short)
+/// \remark The values of all elements of a batch are stored in one arena, the elements refer to their value with offset and size
+class EventBuffer
+{
+public:
+	/// \class Event
+	/// \brief XML element scanned
+	struct Event
+	{
+		XMLScannerBase::ElementType type;	///< type of the element
+		std::size_t offset;			///< offset of the element value in the arena
+		std::size_t size;			///< size of the element value in bytes
+	};
+
+	/// \brief Constructor
+	EventBuffer() {}
+
+	/// \brief Reserve memory for a batch
+	/// \param [in] nofEvents number of elements to reserve memory for
+	/// \param [in] arenaSize size of the arena to reserve in bytes
+	void reserve( std::size_t nofEvents, std::size_t arenaSize)
+	{
+		m_events.reserve( nofEvents);
+		m_arena.reserve( arenaSize);
+	}
+
+	/// \brief Remove all elements (start a new batch)
+	void clear()
+	{
+		m_events.clear();
+		m_arena.clear();
+	}
+
+	/// \brief Append an element
+	/// \param [in] type_ type of the element
+	/// \param [in] content_ pointer to the value of the element
+	/// \param [in] size_ size of the value of the element in bytes
+	void push( XMLScannerBase::ElementType type_, const char* content_, std::size_t size_)
+	{
+		Event ev;
+		ev.type = type_;
+		ev.offset = m_arena.size();
+		ev.size = size_;
+		m_arena.append( content_, size_);
+		m_events.push_back( ev);
+	}
+
+	/// \brief Append the elements of another batch
+	/// \param [in] o batch to append
+	void append( const EventBuffer& o)
+	{
+		std::size_t ofs = m_arena.size();
+		m_arena.append( o.m_arena);
+		std::vector<Event>::const_iterator ei = o.m_events.begin(), ee = o.m_events.end();
+		for (; ei != ee; ++ei)
+		{
+			m_events.push_back( *ei);
+			m_events.back().offset += ofs;
+		}
+	}
+
+	/// \brief Get the number of elements in the batch
+	std::size_t size() const			{return m_events.size();}
+	/// \brief Evaluate if the batch is empty
+	bool empty() const				{return m_events.empty();}
+	/// \brief Get an element of the batch
+	/// \param [in] idx index of the element starting with 0
+	const Event& operator[]( std::size_t idx) const	{return m_events[ idx];}
+	/// \brief Get the type of an element of the batch
+	/// \param [in] idx index of the element starting with 0
+	XMLScannerBase::ElementType type( std::size_t idx) const	{return m_events[ idx].type;}
+	/// \brief Get the value of an element of the batch (not null terminated)
+	/// \param [in] idx index of the element starting with 0
+	const char* content( std::size_t idx) const	{return m_arena.data() + m_events[ idx].offset;}
+	/// \brief Get the size of the value of an element of the batch in bytes
+	/// \param [in] idx index of the element starting with 0
+	std::size_t contentSize( std::size_t idx) const	{return m_events[ idx].size;}
+	/// \brief Get the type of the last element of the batch or None, if the batch is empty
+	XMLScannerBase::ElementType lastType() const	{return m_events.empty()?XMLScannerBase::None:m_events.back().type;}
+	/// \brief Get the arena with the values of all elements of the batch
+	const std::string& arena() const		{return m_arena;}
+
+private:
+	std::vector<Event> m_events;			///< elements of the batch
+	std::string m_arena;				///< values of the elements of the batch
+};
+
+/// \class XMLScannerInstrumentation
+/// \brief Definitions common for the instrumentation policies of the XML scanner (template parameter Instrumentation_ of XMLScanner)
+/// \remark An instrumentation policy implements the hooks enterState, entity, tokenParsed and tokenSkipped called by the scanner. The hooks of XMLScannerNoInstrumentation are empty and compiled away
+struct XMLScannerInstrumentation
+{
+	/// \enum EntityKind
+	/// \brief Kinds of entities decoded
+	enum EntityKind
+	{
+		DecimalEntity,				///< numeric entity with decimal value (e.g. "&amp;#65;")
+		HexEntity,				///< numeric entity with hexadecimal value (e.g. "&amp;#x41;")
+		NamedEntity,				///< named entity (e.g. "&amp;amp;")
+		InvalidEntity,				///< malformed entity copied as text to the output
+		NofEntityKinds				///< number of entity kinds
+	};
+};
+
+/// \class XMLScannerNoInstrumentation
+/// \brief Instrumentation policy of the XML scanner that counts nothing (default)
+struct XMLScannerNoInstrumentation :public XMLScannerInstrumentation
+{
+	template <class InputReader>
+	void enterState( XMLScannerBase::STMState, XMLScannerBase::STMState, const InputReader&){}
+	void entity( EntityKind){}
+	void tokenParsed( std::size_t){}
+	void tokenSkipped(){}
+};
+
+/// \class XMLScannerCounters
+/// \brief Instrumentation policy of the XML scanner counting the bytes consumed per state, the state transitions, the entities decoded per kind, the tokens parsed and skipped and the maximum size of the output buffer
+/// \remark The bytes are counted with the position of the source iterator (TextScanner::getPosition()), so the iterator must implement operator-. When the source is replaced (setSource, putInput, restart), counting continues with the start of the new source. A snapshot of the counters is a copy of this object (see XMLScanner::getInstrumentation())
+class XMLScannerCounters :public XMLScannerInstrumentation
+{
+public:
+	enum
+	{
+		NofStates=XMLScannerBase::EXIT+1	///< number of states of the scanner state machine
+	};
+
+	/// \brief Constructor
+	XMLScannerCounters()
+	{
+		clear();
+	}
+
+	/// \brief Reset all counters to 0
+	void clear()
+	{
+		std::memset( m_bytes, 0, sizeof(m_bytes));
+		std::memset( m_transitions, 0, sizeof(m_transitions));
+		std::memset( m_entities, 0, sizeof(m_entities));
+		m_tokensParsed = 0;
+		m_tokensSkipped = 0;
+		m_maxOutputSize = 0;
+		m_mark = 0;
+	}
+
+	/// \brief Hook called by the scanner for a state transition
+	template <class InputReader>
+	void enterState( XMLScannerBase::STMState from, XMLScannerBase::STMState to, const InputReader& src)
+	{
+		std::size_t pos = src.getPosition();
+		m_bytes[ from] += (pos >= m_mark)?(pos - m_mark):pos;
+		m_mark = pos;
+		++m_transitions[ from][ to];
+	}
+
+	/// \brief Hook called by the scanner for an entity decoded
+	void entity( EntityKind kind)
+	{
+		++m_entities[ kind];
+	}
+
+	/// \brief Hook called by the scanner for a token parsed into the output buffer
+	/// \param [in] outputsize size of the output buffer after parsing the token
+	void tokenParsed( std::size_t outputsize)
+	{
+		++m_tokensParsed;
+		if (outputsize > m_maxOutputSize) m_maxOutputSize = outputsize;
+	}
+
+	/// \brief Hook called by the scanner for a token skipped because its type is masked out
+	void tokenSkipped()
+	{
+		++m_tokensSkipped;
+	}
+
+	/// \brief Get the number of bytes consumed in a state (counted when leaving the state)
+	std::size_t bytes( XMLScannerBase::STMState state) const					{return m_bytes[ state];}
+	/// \brief Get the number of transitions from one state to another
+	std::size_t transitions( XMLScannerBase::STMState from, XMLScannerBase::STMState to) const	{return m_transitions[ from][ to];}
+	/// \brief Get the number of entities decoded of a kind
+	std::size_t entities( EntityKind kind) const							{return m_entities[ kind];}
+	/// \brief Get the number of tokens parsed into the output buffer
+	std::size_t tokensParsed() const								{return m_tokensParsed;}
+	/// \brief Get the number of tokens skipped because their type was masked out
+	std::size_t tokensSkipped() const								{return m_tokensSkipped;}
+	/// \brief Get the maximum size of the output buffer in bytes (tokens returned as spans in zero copy mode are not counted)
+	std::size_t maxOutputSize() const								{return m_maxOutputSize;}
+
+private:
+	std::size_t m_bytes[ NofStates];			///< bytes consumed per state
+	std::size_t m_transitions[ NofStates][ NofStates];	///< number of transitions per source and target state
+	std::size_t m_entities[ NofEntityKinds];		///< number of entities decoded per kind
+	std::size_t m_tokensParsed;				///< number of tokens parsed into the output buffer
+	std::size_t m_tokensSkipped;				///< number of tokens skipped
+	std::size_t m_maxOutputSize;				///< maximum size of the output buffer
+	std::size_t m_mark;					///< source position of the last state transition
+};
+
+#if defined(__GNUC__)
+#define TEXTWOLF_CACHELINE_ALIGNED __attribute__((aligned(64)))
+#elif defined(_MSC_VER)
+#define TEXTWOLF_CACHELINE_ALIGNED __declspec(align(64))
+#else
+#define TEXTWOLF_CACHELINE_ALIGNED
+#endif
+
+/// \class XMLScannerTables
+/// \brief Tables of the XML scanner state machine resolved from XMLScannerBase::Statemachine for the dispatch in XMLScanner::nextItem(unsigned short)
+/// \remark All tables are constant initialized data, so there is no initialization on first use. tests/test_XMLScannerTables.cpp checks them against XMLScannerBase::Statemachine and XMLScannerBase::TokenRunSet and prints them on a mismatch
+/// \tparam Dummy_ dummy template parameter for having the definition of the tables in the header
+template <int Dummy_=0>
+struct XMLScannerTables :public XMLScannerBase
+{
+	enum
+	{
+		NofStates=EXIT+1,			///< number of states of the state machine
+		RowSize=32,				///< size of a row of the transition table (NofControlCharacter aligned to a half cache line)
+		FallbackTransition=64,			///< flag of a transition table entry for a follow state without consuming the current character
+		ErrorTransition=128,			///< flag of a transition table entry for an error (error code in the lower bits)
+		NoAction=-1,				///< StateDef::actionOp of a state without action
+		NoReturn=-1				///< StateDef::returnState of a state that does not return after its action
+	};
+
+	/// \class StateDef
+	/// \brief Action of a state of the state machine
+	struct StateDef
+	{
+		signed char actionOp;			///< action executed when entering the state (STMAction) or NoAction
+		signed char actionArg;			///< element type (ElementType) returned by the action
+		signed char returnState;		///< state to continue with in the next call after returning the action (no transition defined in this state) or NoReturn
+	};
+
+	/// \brief State transitions with pre-resolved fallback and miss handling: [state][control character] -> follow state (consuming the current character) or follow state|FallbackTransition or error|ErrorTransition
+	TEXTWOLF_CACHELINE_ALIGNED static const unsigned char transition[ NofStates][ RowSize];
+	/// \brief Actions of the states
+	static const StateDef state[ NofStates];
+	/// \brief Sets of valid token characters of the actions parsing a token (indexed by ControlCharacter)
+	static const bool tokenChar[ NofSTMActions][ NofControlCharacter];
+	/// \brief Sets of bytes terminating a run of token characters of the actions parsing a token (TokenRunSet of tokenChar)
+	static const ByteScanTable tokenRun[ NofSTMActions];
+	/// \brief Values of the hexadecimal digits indexed by byte, 0xFF for bytes that are not a hexadecimal digit
+	static const unsigned char hexDigit[ 256];
+};
+
+template <int Dummy_>
+const unsigned char XMLScannerTables<Dummy_>::transition[ NofStates][ RowSize] =
+{
+		{130,47,0,0,0,130,1,130,130,130,130,130,130,130,130,130,130,130,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// START
+		{84,84,1,1,1,84,84,84,84,84,84,32,2,84,84,84,84,84,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// STARTTAG
+		{131,131,7,7,7,131,131,131,131,131,131,131,5,131,131,131,131,131,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAG
+		{3,3,3,3,3,3,3,3,3,3,3,3,4,3,3,3,3,3,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// PITAG
+		{136,136,136,136,136,136,136,136,16,136,136,136,136,136,136,136,136,136,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// PITAGEND
+		{136,136,5,5,5,136,136,136,6,136,136,136,136,136,136,136,136,136,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGEND
+		{79,79,79,79,79,79,79,79,79,79,79,79,79,79,79,79,79,79,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGDONE
+		{72,72,7,7,7,72,72,72,72,72,72,72,5,72,72,72,72,72,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGAISK
+		{137,137,9,9,9,137,137,10,137,137,137,137,137,137,137,137,137,137,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGANAM
+		{137,137,9,9,9,137,137,10,137,137,137,137,137,137,137,137,137,137,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGAESK
+		{75,75,10,10,10,75,75,75,75,75,75,75,75,12,13,75,75,75,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGAVSK
+		{138,138,7,7,7,138,138,138,138,138,138,138,5,138,138,138,138,138,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGAVID
+		{134,134,134,134,134,134,134,134,134,134,134,134,134,14,134,134,134,134,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGAVSQ
+		{134,134,134,134,134,134,134,134,134,134,134,134,134,134,14,134,134,134,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGAVDQ
+		{138,138,7,7,7,138,138,138,138,138,138,138,5,138,138,138,138,138,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XTAGAVQE
+		{81,47,15,15,15,81,19,81,81,81,81,81,81,81,81,81,81,81,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// DOCSTART
+		{81,47,81,81,81,81,19,81,81,81,81,81,81,81,81,81,81,81,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// CONTENT
+		{80,47,16,16,16,80,19,80,80,80,80,80,80,80,80,80,80,80,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TOKEN
+		{81,47,18,18,18,81,19,81,81,81,81,81,81,81,81,81,81,81,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// SEEKTOK
+		{84,84,19,19,19,84,84,84,84,21,84,32,3,84,84,84,84,84,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// XMLTAG
+		{138,138,23,23,23,138,138,138,16,31,138,138,138,138,138,138,138,138,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// OPENTAG
+		{136,136,22,22,22,136,136,136,16,136,136,136,136,136,136,136,136,136,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// CLOSETAG
+		{136,136,22,22,22,136,136,136,16,136,136,136,136,136,136,136,136,136,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGCLSK
+		{88,88,23,23,23,88,88,88,16,31,88,88,88,88,88,88,88,88,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGAISK
+		{137,137,25,25,25,137,137,26,137,137,137,137,137,137,137,137,137,137,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGANAM
+		{137,137,25,25,25,137,137,26,137,137,137,137,137,137,137,137,137,137,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGAESK
+		{91,91,26,26,26,91,91,91,91,91,91,91,91,28,29,91,91,91,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGAVSK
+		{138,138,23,23,23,138,138,138,16,31,138,138,138,138,138,138,138,138,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGAVID
+		{134,134,134,134,134,134,134,134,134,134,134,134,134,30,134,134,134,134,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGAVSQ
+		{134,134,134,134,134,134,134,134,134,134,134,134,134,134,30,134,134,134,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGAVDQ
+		{138,138,23,23,23,138,138,138,16,31,138,138,138,138,138,138,138,138,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGAVQE
+		{136,136,31,31,31,136,136,136,16,136,136,136,136,136,136,136,136,136,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// TAGCLIM
+		{97,97,97,97,97,97,97,97,97,97,39,97,97,97,97,43,97,97,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ENTITYSL
+		{99,99,33,33,33,99,99,99,34,99,99,99,99,36,37,38,99,99,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ENTITY
+		{82,82,82,82,82,82,82,82,82,82,82,82,82,82,82,82,82,82,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ENTITYE
+		{129,129,33,33,33,129,129,129,34,129,129,129,129,129,129,129,129,129,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ENTITYID
+		{134,134,134,134,134,134,134,134,134,134,134,134,134,33,134,134,134,134,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ENTITYSQ
+		{134,134,134,134,134,134,134,134,134,134,134,134,134,134,33,134,134,134,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ENTITYDQ
+		{38,38,38,38,38,38,38,38,38,38,38,38,38,38,38,38,33,38,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ENTITYLC
+		{143,143,143,143,143,143,143,143,143,143,40,143,143,143,143,143,143,143,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// COMDASH2
+		{40,40,40,40,40,40,40,40,40,40,41,40,40,40,40,40,40,40,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// COMSEEKE
+		{40,40,40,40,40,40,40,40,40,40,42,40,40,40,40,40,40,40,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// COMENDD2
+		{40,40,40,40,40,40,40,40,18,40,41,40,40,40,40,40,40,40,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// COMENDCL
+		{139,139,139,139,139,139,139,139,139,139,139,139,139,139,139,44,139,139,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// CDATA
+		{44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,45,44,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// CDATA1
+		{44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,44,46,44,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// CDATA2
+		{44,44,44,44,44,44,44,44,16,44,44,44,44,44,44,44,44,44,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// CDATA3
+		{140,132,140,140,140,140,140,140,140,140,140,140,140,140,140,140,140,140,0,0,0,0,0,0,0,0,0,0,0,0,0,0}	// EXIT
+};
+
+template <int Dummy_>
+const typename XMLScannerTables<Dummy_>::StateDef XMLScannerTables<Dummy_>::state[ NofStates] =
+{
+	{NoAction,None,NoReturn},	// START
+	{NoAction,None,NoReturn},	// STARTTAG
+	{ExpectIdentifierXML,None,NoReturn},	// XTAG
+	{NoAction,None,NoReturn},	// PITAG
+	{NoAction,None,NoReturn},	// PITAGEND
+	{NoAction,None,NoReturn},	// XTAGEND
+	{Return,HeaderEnd,DOCSTART},	// XTAGDONE
+	{NoAction,None,NoReturn},	// XTAGAISK
+	{ReturnIdentifier,HeaderAttribName,NoReturn},	// XTAGANAM
+	{NoAction,None,NoReturn},	// XTAGAESK
+	{NoAction,None,NoReturn},	// XTAGAVSK
+	{ReturnIdentifier,HeaderAttribValue,NoReturn},	// XTAGAVID
+	{ReturnSQString,HeaderAttribValue,NoReturn},	// XTAGAVSQ
+	{ReturnDQString,HeaderAttribValue,NoReturn},	// XTAGAVDQ
+	{NoAction,None,NoReturn},	// XTAGAVQE
+	{NoAction,None,NoReturn},	// DOCSTART
+	{NoAction,None,NoReturn},	// CONTENT
+	{ReturnContent,Content,NoReturn},	// TOKEN
+	{NoAction,None,NoReturn},	// SEEKTOK
+	{NoAction,None,NoReturn},	// XMLTAG
+	{ReturnIdentifier,OpenTag,NoReturn},	// OPENTAG
+	{ReturnIdentifier,CloseTag,NoReturn},	// CLOSETAG
+	{NoAction,None,NoReturn},	// TAGCLSK
+	{NoAction,None,NoReturn},	// TAGAISK
+	{ReturnIdentifier,TagAttribName,NoReturn},	// TAGANAM
+	{NoAction,None,NoReturn},	// TAGAESK
+	{NoAction,None,NoReturn},	// TAGAVSK
+	{ReturnIdentifier,TagAttribValue,NoReturn},	// TAGAVID
+	{ReturnSQString,TagAttribValue,NoReturn},	// TAGAVSQ
+	{ReturnDQString,TagAttribValue,NoReturn},	// TAGAVDQ
+	{NoAction,None,NoReturn},	// TAGAVQE
+	{Return,CloseTagIm,NoReturn},	// TAGCLIM
+	{NoAction,None,NoReturn},	// ENTITYSL
+	{NoAction,None,NoReturn},	// ENTITY
+	{Return,DocAttribEnd,SEEKTOK},	// ENTITYE
+	{ReturnIdentifier,DocAttribValue,NoReturn},	// ENTITYID
+	{ReturnSQString,DocAttribValue,NoReturn},	// ENTITYSQ
+	{ReturnDQString,DocAttribValue,NoReturn},	// ENTITYDQ
+	{NoAction,None,NoReturn},	// ENTITYLC
+	{NoAction,None,NoReturn},	// COMDASH2
+	{NoAction,None,NoReturn},	// COMSEEKE
+	{NoAction,None,NoReturn},	// COMENDD2
+	{NoAction,None,NoReturn},	// COMENDCL
+	{ExpectIdentifierCDATA,None,NoReturn},	// CDATA
+	{NoAction,None,NoReturn},	// CDATA1
+	{NoAction,None,NoReturn},	// CDATA2
+	{NoAction,None,NoReturn},	// CDATA3
+	{Return,Exit,EXIT}	// EXIT
+};
+
+template <int Dummy_>
+const bool XMLScannerTables<Dummy_>::tokenChar[ NofSTMActions][ NofControlCharacter] =
+{
+	//Undef,EndOfText,EndOfLine,Cntrl,Space,Amp,Lt,Equal,Gt,Slash,Dash,Exclam,Questm,Sq,Dq,Osb,Csb,Any
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// Return
+	{1,0,0,0,0,0,0,1,1,1,1,1,1,1,1,1,1,1},	// ReturnWord
+	{1,0,1,1,1,0,0,1,1,1,1,1,1,1,1,1,1,1},	// ReturnContent
+	{1,0,0,0,0,0,0,0,0,0,1,0,0,0,0,0,0,1},	// ReturnIdentifier
+	{1,0,1,1,1,0,0,1,1,1,1,1,1,0,1,1,1,1},	// ReturnSQString
+	{1,0,1,1,1,0,0,1,1,1,1,1,1,1,0,1,1,1},	// ReturnDQString
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ExpectIdentifierXML
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0},	// ExpectIdentifierCDATA
+	{0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0}	// ReturnEOF
+};
+
+template <int Dummy_>
+const ByteScanTable XMLScannerTables<Dummy_>::tokenRun[ NofSTMActions] =
+{
+	//map (bit set per byte),chr (delimiters compared in the vectorized search),nofchr,low,high,vectorize
+	{{0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF},{33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48},16,1,1,0},	// Return
+	{{0xFFFFFFDF,0x10000041,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000},{38,60,0,0,0,0,0,0,0,0,0,0,0,0,0,0},2,1,0,1},	// ReturnWord
+	{{0x00002001,0x10000040,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000},{0,13,38,60,0,0,0,0,0,0,0,0,0,0,0,0},4,0,0,1},	// ReturnContent
+	{{0xFFFFFFDF,0xF00080C7,0x28000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000},{33,34,38,39,47,60,61,62,63,91,93,0,0,0,0,0},11,1,0,1},	// ReturnIdentifier
+	{{0x00002001,0x100000C0,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000},{0,13,38,39,60,0,0,0,0,0,0,0,0,0,0,0},5,0,0,1},	// ReturnSQString
+	{{0x00002001,0x10000044,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000,0x00000000},{0,13,34,38,60,0,0,0,0,0,0,0,0,0,0,0},5,0,0,1},	// ReturnDQString
+	{{0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF},{33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48},16,1,1,0},	// ExpectIdentifierXML
+	{{0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF},{33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48},16,1,1,0},	// ExpectIdentifierCDATA
+	{{0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF,0xFFFFFFFF},{33,34,35,36,37,38,39,40,41,42,43,44,45,46,47,48},16,1,1,0}	// ReturnEOF
+};
+
+template <int Dummy_>
+const unsigned char XMLScannerTables<Dummy_>::hexDigit[ 256] =
+{
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x00..0x0F
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x10..0x1F
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x20..0x2F
+	0,1,2,3,4,5,6,7,8,9,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x30..0x3F
+	0xFF,10,11,12,13,14,15,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x40..0x4F
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x50..0x5F
+	0xFF,10,11,12,13,14,15,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x60..0x6F
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x70..0x7F
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x80..0x8F
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0x90..0x9F
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0xA0..0xAF
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0xB0..0xBF
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0xC0..0xCF
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0xD0..0xDF
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,	// 0xE0..0xEF
+	0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF,0xFF	// 0xF0..0xFF
+};
 
 /// \class XMLScanner
 /// \brief XML scanner template that adds the functionality to the statemachine base definition
@@ -448,12 +876,16 @@ public:
 /// \tparam InputCharSet_ character set encoding of the input, read as stream of bytes
 /// \tparam OutputCharSet_ character set encoding of the output, printed as string of the item type of the character set,
 /// \tparam OutputBuffer_ buffer for output with STL back insertion sequence interface (e.g. std::string,std::vector<char>,textwolf::StaticBuffer)
+/// \tparam Instrumentation_ instrumentation policy (XMLScannerNoInstrumentation without any cost or XMLScannerCounters)
+/// \tparam InputReader_ reader of the input characters (TextScanner reading character by character or LookaheadTextScanner decoding the characters ahead a block at a time)
 template
 <
 		class InputIterator,
 		class InputCharSet_,
 		class OutputCharSet_,
-		class OutputBuffer_
+		class OutputBuffer_,
+		class Instrumentation_=XMLScannerNoInstrumentation,
+		class InputReader_=TextScanner<InputIterator,InputCharSet_>
 >
 class XMLScanner :public XMLScannerBase
 {
@@ -487,7 +919,7 @@ private:
 		unsigned int pos;			///< entity buffer position (buf)
 		unsigned int base;			///< numeric entity base (10 for decimal/16 for hexadecimal)
 		EChar value;				///< parsed entity value
-		char buf[ 16];				///< parsed entity buffer
+		char buf[ 16];				///< parsed entity buffer (a named entity with a name longer than 15 bytes is not recognized, it is passed through as text)
 		UChar curchr_saved;			///< save current character parsed for the case we cannot print it (output buffer too small)
 
 		/// \brief Constructor
@@ -503,14 +935,49 @@ private:
 	};
 	TokState tokstate;				///< the entity parsing state of this XML scanner
 
+	/// \class PushState
+	/// \brief State of the push mode, where the input is fed chunk by chunk with putInput(const char*,std::size_t,bool)
+	struct PushState
+	{
+		bool enabled;				///< true, if the scanner is in push mode
+		bool eof;				///< true, if the last chunk passed is the end of input
+		bool needMoreInput;			///< true, if the scanner stopped because it consumed the input passed
+		const char* rest;			///< rest of the last chunk passed, scanned after the character completed in 'scan'
+		std::size_t restsize;			///< size of 'rest' in bytes
+		const char* tail;			///< incomplete character at the end of the last chunk passed, held back for the next chunk
+		std::size_t tailsize;			///< size of 'tail' in bytes
+		char carry[ 16];			///< bytes of the incomplete character held back
+		std::size_t carrysize;			///< number of bytes in 'carry'
+		char scan[ 16 + traits::ChunkSource<InputIterator>::PaddingSize];	///< character held back and completed with the first bytes of the last chunk passed, followed by the padding required by the source iterator (see traits::ChunkSource)
+
+		/// \brief Constructor
+		PushState()				:enabled(false),eof(false),needMoreInput(false),rest(0),restsize(0),tail(0),tailsize(0),carrysize(0) {}
+	};
+	PushState m_push;				///< the push mode state of this XML scanner
+
+	/// \class ValidationState
+	/// \brief State of the strict UTF-8 validation of the input (see setStrictUTF8(bool))
+	struct ValidationState
+	{
+		bool enabled;				///< true, if the input is validated
+		bool pending;				///< true, if the block of the source assigned last has not been validated yet
+		UTF8Validator validator;		///< validator of the input passed
+
+		/// \brief Constructor
+		ValidationState()			:enabled(false),pending(true) {}
+	};
+	ValidationState m_validation;			///< the strict UTF-8 validation state of this XML scanner
+
 public:
 	typedef InputCharSet_ InputCharSet;
 	typedef OutputCharSet_ OutputCharSet;
 	class iterator;
 
 public:
-	typedef TextScanner<InputIterator,InputCharSet_> InputReader;
-	typedef XMLScanner<InputIterator,InputCharSet_,OutputCharSet_,OutputBuffer_> ThisXMLScanner;
+	typedef InputReader_ InputReader;
+	typedef XMLScanner<InputIterator,InputCharSet_,OutputCharSet_,OutputBuffer_,Instrumentation_,InputReader_> ThisXMLScanner;
+	typedef Instrumentation_ Instrumentation;
+	/// \remark Lookups in this map compare all names, EntityTable provides a constant time lookup
 	typedef std::map<const char*,UChar> EntityMap;
 	typedef OutputBuffer_ OutputBuffer;
 
@@ -537,21 +1004,153 @@ private:
 		copychar_impl( traits::TypeCheck::is_same<InputCharSet,OutputCharSet>::type());
 	}
 
-	/// \brief Map a hexadecimal digit to its value
-	/// \param [in] ch hexadecimal digit to map to its decimal value
-	static unsigned char HEX( unsigned char ch)
+	void copyRun_impl( const ByteScanTable& runDelim, const traits::TypeCheck::YES&)
 	{
-		struct HexCharMap :public CharMap<unsigned char, 0xFF>
+		m_src.copyRun( runDelim, m_output, m_outputBuf);
+	}
+
+	void copyRun_impl( const ByteScanTable& runDelim, const traits::TypeCheck::NO&)
+	{
+		m_src.printRun( runDelim, m_output, m_outputBuf);
+	}
+
+	bool parseTokenSpan_impl( const ByteScanTable& runDelim, const traits::TypeCheck::YES&)
+	{
+		const char* ptr;
+		std::size_t size;
+		if (!m_src.getRun( runDelim, m_output, ptr, size)) return false;
+		if (ptr[ size] != '&' && ptr[ size] != '\r')
 		{
-			HexCharMap()
+			m_src.skipRun( size);
+			if (size)
 			{
-				(*this)
-					('0',0) ('1', 1)('2', 2)('3', 3)('4', 4)('5', 5)('6', 6)('7', 7)('8', 8)('9', 9)
-					('A',10)('B',11)('C',12)('D',13)('E',14)('F',15)('a',10)('b',11)('c',12)('d',13)('e',14)('f',15);
+				m_span = ptr;
+				m_spanSize = size;
 			}
-		};
-		static HexCharMap hexCharMap;
-		return hexCharMap[ch];
+			tokstate.init( TokState::ParsingDone);
+			return true;
+		}
+		// ... the token needs rewriting: copy the part up to the rewrite and continue character wise
+		appendBytes( m_outputBuf, ptr, size);
+		m_src.skipRun( size);
+		return false;
+	}
+
+	bool parseTokenSpan_impl( const ByteScanTable&, const traits::TypeCheck::NO&)
+	{
+		return false;
+	}
+
+	/// \brief Get the token as span in the source without copying it, if it needs no rewriting (zero copy mode)
+	/// \param [in] runDelim set of source bytes terminating a run of token characters
+	/// \return true, if the token has been parsed completely
+	bool parseTokenSpan( const ByteScanTable& runDelim)
+	{
+		return parseTokenSpan_impl( runDelim, traits::TypeCheck::is_same<InputCharSet,OutputCharSet>::type());
+	}
+
+	void putChunk_impl( const char* chunk, std::size_t chunksize, const traits::TypeCheck::YES&)
+	{
+		m_src.getIterator().putInput( chunk, chunksize);
+	}
+
+	void putChunk_impl( const char*, std::size_t, const traits::TypeCheck::NO&)
+	{
+		throw exception( throws_exception::NotAllowedOperation);
+	}
+
+	void relocatePushState( const XMLScanner&, const traits::TypeCheck::NO&) {}
+
+	/// \brief Make a copy scanning a character completed across two chunks refer to its own buffer of the character instead of the one of the scanner copied
+	/// \param [in] o scanner copied
+	void relocatePushState( const XMLScanner& o, const traits::TypeCheck::YES&)
+	{
+		m_src.getIterator().relocate( o.m_push.scan, m_push.scan);
+		std::less<const char*> before;
+		if (m_span && !before( m_span, o.m_push.scan) && before( m_span, o.m_push.scan + sizeof(o.m_push.scan)))
+		{
+			m_span = m_push.scan + (m_span - o.m_push.scan);
+		}
+	}
+
+	/// \brief Pass a piece of a chunk of input to the source iterator in push mode
+	/// \param [in] chunk pointer to the piece
+	/// \param [in] chunksize size of the piece in bytes
+	void putChunk( const char* chunk, std::size_t chunksize)
+	{
+		putChunk_impl( chunk, chunksize, traits::TypeCheck::is_true<((int)traits::ChunkSource<InputIterator>::Feedable == 1)>::type());
+	}
+
+	bool needMoreInput_impl( const traits::TypeCheck::NO&)
+	{
+		return false;
+	}
+
+	bool needMoreInput_impl( const traits::TypeCheck::YES&)
+	{
+		if (!m_push.enabled || !m_src.endOfBlock()) return false;
+		if (m_push.rest)
+		{
+			putChunk( m_push.rest, m_push.restsize);
+			m_push.rest = 0;
+			m_push.restsize = 0;
+			if (!m_src.endOfBlock()) return false;
+		}
+		if (m_push.eof) return false;
+		if (m_push.tail)
+		{
+			std::memcpy( m_push.carry + m_push.carrysize, m_push.tail, m_push.tailsize);
+			m_push.carrysize += m_push.tailsize;
+			m_push.tail = 0;
+			m_push.tailsize = 0;
+		}
+		m_push.needMoreInput = true;
+		return true;
+	}
+
+	/// \brief Check in push mode at the start of a character, if the scanner has to stop because it consumed all input passed
+	/// \remark Switches to the rest of the chunk after the character completed from the last chunk has been scanned. Holds back the incomplete character at the end of the chunk when stopping
+	/// \remark Compiled out for source iterators that cannot be fed chunk by chunk (see traits::ChunkSource)
+	/// \return true, if the scanner has to stop and return NeedMoreInput
+	bool needMoreInput()
+	{
+		return needMoreInput_impl( traits::TypeCheck::is_true<((int)traits::ChunkSource<InputIterator>::Feedable == 1)>::type());
+	}
+
+	/// \brief Validate the block of the source assigned last, if not done yet (strict UTF-8 mode)
+	/// \return false, if an invalid UTF-8 sequence has been found in the input
+	bool validateSource()
+	{
+		if (m_validation.pending)
+		{
+			m_validation.pending = false;
+			std::size_t blksize;
+			const char* blk = traits::ContiguousSource<InputIterator>::block( m_src.getIterator(), blksize);
+			if (blk)
+			{
+				if (blksize == (std::size_t)-1) blksize = std::strlen( blk);
+				m_validation.validator.check( blk, blksize);
+			}
+		}
+		return !m_validation.validator.failed();
+	}
+
+	static bool isUTF8Input( const traits::TypeCheck::YES&)	{return true;}
+	static bool isUTF8Input( const traits::TypeCheck::NO&)		{return false;}
+
+	/// \brief Copy a run of token characters without delimiters directly from input to output if possible, for different character sets of input and output print the run if possible (see TextScanner::printRun)
+	/// \param [in] runDelim set of source bytes that terminate the run
+	void copyRun( const ByteScanTable& runDelim)
+	{
+		copyRun_impl( runDelim, traits::TypeCheck::is_same<InputCharSet,OutputCharSet>::type());
+	}
+
+	/// \brief Map a hexadecimal digit to its value
+	/// \param [in] ch hexadecimal digit to map to its decimal value
+	/// \return the value of the digit or 0xFF, if 'ch' is not a hexadecimal digit
+	static unsigned char HEX( unsigned char ch)
+	{
+		return XMLScannerTables<>::hexDigit[ ch];
 	}
 
 	/// \brief Parse a numeric entity value for a table definition (map it to the target character set)
@@ -591,6 +1190,7 @@ private:
 	/// \return true on success
 	void fallbackEntity()
 	{
+		m_instrumentation.entity( XMLScannerInstrumentation::InvalidEntity);
 		switch (tokstate.id)
 		{
 			case TokState::Start:
@@ -623,6 +1223,7 @@ private:
 	{
 		unsigned char ch;
 		tokstate.id = TokState::ParsingEntity;
+		if (needMoreInput()) return false;
 		ch = m_src.ascii();
 		if (ch == '#')
 		{
@@ -641,6 +1242,7 @@ private:
 	{
 		unsigned char ch;
 		tokstate.id = TokState::ParsingNumericEntity;
+		if (needMoreInput()) return false;
 		ch = m_src.ascii();
 		if (ch == 'x')
 		{
@@ -664,6 +1266,7 @@ private:
 
 		while (tokstate.pos < sizeof(tokstate.buf))
 		{
+			if (needMoreInput()) return false;
 			ch = m_src.ascii();
 			if (ch == ';')
 			{
@@ -674,6 +1277,7 @@ private:
 					return true;
 				}
 				push( (UChar)tokstate.value);
+				m_instrumentation.entity( (tokstate.base == 16)?XMLScannerInstrumentation::HexEntity:XMLScannerInstrumentation::DecimalEntity);
 				tokstate.init( TokState::ParsingToken);
 				m_src.skip();
 				return true;
@@ -701,18 +1305,21 @@ private:
 	{
 		unsigned char ch;
 		tokstate.id = TokState::ParsingNamedEntity;
+		if (needMoreInput()) return false;
 		ch = m_src.ascii();
 		while (tokstate.pos < sizeof(tokstate.buf)-1 && ch != ';' && m_src.control() == Any)
 		{
 			tokstate.buf[ tokstate.pos] = ch;
 			m_src.skip();
 			tokstate.pos++;
+			if (needMoreInput()) return false;
 			ch = m_src.ascii();
 		}
 		if (ch == ';')
 		{
 			tokstate.buf[ tokstate.pos] = '\0';
-			if (!pushEntity( tokstate.buf)) return false;
+			if (!pushEntity( tokstate.buf, tokstate.pos)) return false;
+			m_instrumentation.entity( XMLScannerInstrumentation::NamedEntity);
 			tokstate.init( TokState::ParsingToken);
 			m_src.skip();
 			return true;
@@ -747,36 +1354,39 @@ private:
 			case TokState::ParsingNumericBaseEntity: rt = parseNumericBaseEntity(); break;
 			case TokState::ParsingNamedEntity: rt = parseNamedEntity(); break;
 		}
+		if (m_push.needMoreInput) return false;
 		tokstate.init( TokState::ParsingToken);
 		return rt;
 	}
 
 	/// \brief Parse a token defined by the set of valid token characters
-	/// \param [in] isTok set of valid token characters
+	/// \param [in] isTok set of valid token characters indexed by ControlCharacter
+	/// \param [in] runDelim set of source bytes terminating a run of token characters that can be copied as block
 	/// \return true on success
-	bool parseToken( const IsTokenCharMap& isTok)
+	bool parseToken( const bool* isTok, const ByteScanTable& runDelim)
 	{
 		if (tokstate.id == TokState::Start)
 		{
 			tokstate.id = TokState::ParsingToken;
 			m_outputBuf.clear();
+			if (m_zeroCopy && parseTokenSpan( runDelim)) return true;
 		}
 		else if (tokstate.id != TokState::ParsingToken)
 		{
 			if (!parseTokenRecover())
 			{
+				if (m_push.needMoreInput) return false;
 				tokstate.init();
 				return false;
 			}
 		}
 		for (;;)
 		{
-			/// \todo When source and dest encoding are equal, then do not decode
-			///	the value in parsing and encode it when printing. Use some sort
-			///	of enable_if do redirect to a simple buffer copy.
 			ControlCharacter ch;
-			while (isTok[ (unsigned char)(ch=m_src.control())])
+			for (;;)
 			{
+				if (needMoreInput()) return false;
+				if (!isTok[ (unsigned char)(ch=m_src.control())]) break;
 				unsigned char aa = m_src.ascii();
 				if (aa <= 0xD)
 				{
@@ -806,11 +1416,19 @@ private:
 					tokstate.eolnState = TokState::SRC;
 				}
 				m_src.skip();
+				if (tokstate.eolnState == TokState::SRC)
+				{
+					copyRun( runDelim);
+				}
 			}
 			if (ch == Amp)
 			{
 				m_src.skip();
-				if (!parseEntity()) break;
+				if (!parseEntity())
+				{
+					if (m_push.needMoreInput) return false;
+					break;
+				}
 				tokstate.init( TokState::ParsingToken);
 				continue;
 			}
@@ -835,6 +1453,9 @@ public:
 	static bool parseStaticToken( const IsTokenCharMap& isTok, InputReader ir, OutputBufferType& buf)
 	{
 		static OutputCharSet output;
+		enum {ChunkSize=64};
+		UChar tmp[ ChunkSize];
+		std::size_t tmpsize = 0;
 		buf.clear();
 		for (;;)
 		{
@@ -852,9 +1473,15 @@ public:
 				}
 				else
 				{
+					output.print( tmp, tmp + tmpsize, buf);
 					return true;
 				}
-				output.print( pc, buf);
+				tmp[ tmpsize++] = pc;
+				if (tmpsize == ChunkSize)
+				{
+					output.print( tmp, tmp + tmpsize, buf);
+					tmpsize = 0;
+				}
 				ir.skip();
 			}
 		}
@@ -862,15 +1489,17 @@ public:
 
 private:
 	/// \brief Skip a token defined by the set of valid token characters (same as parseToken but nothing written to the output buffer)
-	/// \param [in] isTok set of valid token characters
+	/// \param [in] isTok set of valid token characters indexed by ControlCharacter
 	/// \return true on success
-	bool skipToken( const IsTokenCharMap& isTok)
+	bool skipToken( const bool* isTok)
 	{
 		do
 		{
 			ControlCharacter ch;
-			while (isTok[ (unsigned char)(ch=m_src.control())] || ch == Amp)
+			for (;;)
 			{
+				if (needMoreInput()) return false;
+				if (!isTok[ (unsigned char)(ch=m_src.control())] && ch != Amp) break;
 				m_src.skip();
 			}
 		}
@@ -887,6 +1516,7 @@ private:
 		tokstate.id = TokState::ParsingKey;
 		for (; str[tokstate.pos] != '\0'; m_src.skip(),tokstate.pos++)
 		{
+			if (needMoreInput()) return false;
 			if (m_src.ascii() == str[ tokstate.pos]) continue;
 			ControlCharacter ch = m_src.control();
 			if (ch == EndOfText)
@@ -967,27 +1597,39 @@ private:
 
 	/// \brief Parse an entity defined by name (predefined or in defined in entity table)
 	/// \param [in] str pointer to the buffer with the entity name
+	/// \param [in] strsize length of the entity name in bytes
 	/// \return true on success
-	bool pushEntity( const char* str)
+	bool pushEntity( const char* str, std::size_t strsize)
 	{
+		UChar ch;
 		if (pushPredefinedEntity( str))
 		{
 			return true;
 		}
-		else if (m_entityMap)
+		else if (m_entityTable)
 		{
-			EntityMap::const_iterator itr = m_entityMap->find( str);
-			if (itr == m_entityMap->end())
+			if (!m_entityTable->find( str, strsize, ch))
 			{
 				error = ErrUndefinedCharacterEntity;
 				return false;
 			}
-			else
+			push( ch);
+			return true;
+		}
+		else if (m_entityMap)
+		{
+			// ... the map is ordered by pointers and not by the names, so we have to compare the names
+			EntityMap::const_iterator itr = m_entityMap->begin(), end = m_entityMap->end();
+			for (; itr != end; ++itr)
 			{
-				UChar ch = itr->second;
-				push( ch);
-				return true;
+				if (std::strcmp( itr->first, str) == 0)
+				{
+					push( itr->second);
+					return true;
+				}
 			}
+			error = ErrUndefinedCharacterEntity;
+			return false;
 		}
 		else
 		{
@@ -1001,53 +1643,104 @@ private:
 	Error error;			///< last error code
 	InputReader m_src;		///< source input iterator
 	const EntityMap* m_entityMap;	///< map with entities defined by the caller
-	OutputBuffer m_outputBuf;	///< buffer to use for output
+	const EntityTable* m_entityTable;	///< table with entities defined by the caller
+	mutable OutputBuffer m_outputBuf;	///< buffer to use for output
 	OutputCharSet m_output;
+	bool m_zeroCopy;		///< true, if items that need no rewriting are returned as spans in the source (see setZeroCopy(bool))
+	mutable const char* m_span;	///< the current item as span in the source or NULL, if the item is in m_outputBuf
+	mutable std::size_t m_spanSize;	///< size of m_span in bytes
+	Instrumentation m_instrumentation;	///< instrumentation policy object (counters)
 
 public:
 	/// \brief Constructor
 	/// \param [in] p_src source iterator
 	/// \param [in] p_entityMap read only map of named entities defined by the user
 	XMLScanner( const InputIterator& p_src, const EntityMap& p_entityMap)
-			:state(START),error(Ok),m_src(InputCharSet(),p_src),m_entityMap(&p_entityMap),m_output(OutputCharSet())
+			:state(START),error(Ok),m_src(InputCharSet(),p_src),m_entityMap(&p_entityMap),m_entityTable(0),m_output(OutputCharSet()),m_zeroCopy(false),m_span(0),m_spanSize(0)
+	{}
+	/// \brief Constructor
+	/// \param [in] p_src source iterator
+	/// \param [in] p_entityTable read only table of named entities defined by the user (not copied, it must live as long as the scanner)
+	XMLScanner( const InputIterator& p_src, const EntityTable& p_entityTable)
+			:state(START),error(Ok),m_src(InputCharSet(),p_src),m_entityMap(0),m_entityTable(&p_entityTable),m_output(OutputCharSet()),m_zeroCopy(false),m_span(0),m_spanSize(0)
 	{}
 	/// \brief Constructor
 	/// \param [in] p_src source iterator
 	explicit XMLScanner( const InputIterator& p_src)
-			:state(START),error(Ok),m_src(InputCharSet(),p_src),m_entityMap(0),m_output(OutputCharSet())
+			:state(START),error(Ok),m_src(InputCharSet(),p_src),m_entityMap(0),m_entityTable(0),m_output(OutputCharSet()),m_zeroCopy(false),m_span(0),m_spanSize(0)
 	{}
 	/// \brief Constructor
 	/// \param [in] p_charset character set encoding of input in case of non default settings (code page) needed
 	/// \param [in] p_src source iterator
 	/// \param [in] p_entityMap read only map of named entities defined by the user
 	XMLScanner( const InputCharSet& p_charset, const InputIterator& p_src, const EntityMap& p_entityMap)
-			:state(START),error(Ok),m_src(p_charset,p_src),m_entityMap(&p_entityMap),m_output(OutputCharSet())
+			:state(START),error(Ok),m_src(p_charset,p_src),m_entityMap(&p_entityMap),m_entityTable(0),m_output(OutputCharSet()),m_zeroCopy(false),m_span(0),m_spanSize(0)
+	{}
+	/// \brief Constructor
+	/// \param [in] p_charset character set encoding of input in case of non default settings (code page) needed
+	/// \param [in] p_src source iterator
+	/// \param [in] p_entityTable read only table of named entities defined by the user (not copied, it must live as long as the scanner)
+	XMLScanner( const InputCharSet& p_charset, const InputIterator& p_src, const EntityTable& p_entityTable)
+			:state(START),error(Ok),m_src(p_charset,p_src),m_entityMap(0),m_entityTable(&p_entityTable),m_output(OutputCharSet()),m_zeroCopy(false),m_span(0),m_spanSize(0)
 	{}
 	/// \brief Constructor
 	/// \param [in] p_charset character set encoding of input in case of non default settings (code page) needed
 	/// \param [in] p_src source iterator
 	XMLScanner( const InputCharSet& p_charset, const InputIterator& p_src)
-			:state(START),error(Ok),m_src(p_charset,p_src),m_entityMap(0),m_output(OutputCharSet())
+			:state(START),error(Ok),m_src(p_charset,p_src),m_entityMap(0),m_entityTable(0),m_output(OutputCharSet()),m_zeroCopy(false),m_span(0),m_spanSize(0)
 	{}
 	/// \brief Constructor
 	/// \param [in] p_charset character set encoding of input in case of non default settings (code page) needed
 	explicit XMLScanner( const InputCharSet& p_charset)
-			:state(START),error(Ok),m_src(p_charset),m_entityMap(0)
+			:state(START),error(Ok),m_src(p_charset),m_entityMap(0),m_entityTable(0),m_zeroCopy(false),m_span(0),m_spanSize(0)
 	{}
 	/// \brief Default constructor
 	XMLScanner()
-			:state(START),error(Ok),m_src(InputCharSet()),m_entityMap(0)
+			:state(START),error(Ok),m_src(InputCharSet()),m_entityMap(0),m_entityTable(0),m_zeroCopy(false),m_span(0),m_spanSize(0)
 	{}
 
 	/// \brief Copy constructor
+	/// \remark The copy is independent of the scanner copied also in push mode, while scanning a character completed across two chunks. The chunks passed with putInput(const char*,std::size_t,bool) are shared
 	/// \param [in] o scanner to copy
 	XMLScanner( const XMLScanner& o)
-		:state(o.state)
+		:tokstate(o.tokstate)
+		,m_push(o.m_push)
+		,m_validation(o.m_validation)
+		,state(o.state)
 		,error(o.error)
 		,m_src(o.m_src)
 		,m_entityMap(o.m_entityMap)
+		,m_entityTable(o.m_entityTable)
 		,m_outputBuf(o.m_outputBuf)
-	{}
+		,m_output(o.m_output)
+		,m_zeroCopy(o.m_zeroCopy)
+		,m_span(o.m_span)
+		,m_spanSize(o.m_spanSize)
+		,m_instrumentation(o.m_instrumentation)
+	{
+		relocatePushState( o, traits::TypeCheck::is_true<((int)traits::ChunkSource<InputIterator>::Feedable == 1)>::type());
+	}
+
+	/// \brief Enable or disable the zero copy mode
+	/// \remark In zero copy mode items that need no rewriting (no entities, no end of line translation) are returned by getItemPtr() and getItemSize() as spans in the source without copying them to the output buffer. This is only possible if the input and the output character set are equal and byte oriented and if the source iterator iterates on a memory block (char*, CStringIterator, PaddedBufferIterator, MmapFileIterator, SrcIterator, PaddedSrcIterator, IStreamIterator, ReadAheadIterator). A span is valid as long as the source memory block it points to. getItem() copies a span to the output buffer, so it returns the item also in zero copy mode, but at the cost of the copy
+	/// \param [in] enable_ true to enable, false to disable
+	void setZeroCopy( bool enable_=true)
+	{
+		m_zeroCopy = enable_;
+	}
+
+	/// \brief Enable or disable the strict validation of UTF-8 input
+	/// \remark In strict mode every block of input is validated with UTF8Validator before it is scanned, the character decoding itself stays as lax as before. If a block contains an invalid sequence (overlong form, surrogate, character beyond 0x10FFFF or 5/6 byte sequence), nextItem(unsigned short) returns ErrorOccurred with the error ErrInvalidUTF8 without returning any element of the block. An incomplete character at the end of input is reported instead of Exit. getErrorPosition() returns the offset of the sequence from the start of the input
+	/// \remark Only available for UTF-8 input with a source iterator on a memory block that covers all input assigned, i.e. char*, CStringIterator, PaddedBufferIterator, MmapFileIterator, SrcIterator or PaddedSrcIterator (also in push mode), see traits::ContiguousSource::FixedBlock. Throws NotAllowedOperation otherwise
+	/// \param [in] enable_ true to enable, false to disable
+	void setStrictUTF8( bool enable_=true)
+	{
+		if (enable_ && (!isUTF8Input( traits::TypeCheck::is_same<InputCharSet,charset::UTF8>::type()) || !(int)traits::ContiguousSource<InputIterator>::FixedBlock))
+		{
+			throw exception( throws_exception::NotAllowedOperation);
+		}
+		m_validation.enabled = enable_;
+	}
 
 	/// \brief Assign something to the source iterator while keeping the state
 	/// \param [in] a source iterator assignment
@@ -1055,6 +1748,78 @@ public:
 	void setSource( const IteratorAssignment& a)
 	{
 		m_src.setSource( a);
+		m_validation.pending = true;
+	}
+
+	/// \brief Restart the scanner at the start of a new document, keeping the character sets, the entity definitions, the zero copy mode and the memory allocated for the output buffer
+	/// \param [in] a source iterator assignment
+	template <class IteratorAssignment>
+	void restart( const IteratorAssignment& a)
+	{
+		m_push = PushState();
+		m_validation.validator.reset();
+		m_validation.pending = true;
+		state = START;
+		error = Ok;
+		tokstate.init();
+		m_src.restart( a);
+		m_outputBuf.clear();
+		m_span = 0;
+		m_spanSize = 0;
+	}
+
+	/// \brief Feed the next chunk of input in push mode
+	/// \remark Only available with SrcIterator or PaddedSrcIterator as source iterator (see traits::ChunkSource). With PaddedSrcIterator every chunk passed has to be followed by PaddedSrcIterator::PaddingSize null bytes. In push mode nextItem(unsigned short) returns NeedMoreInput when it consumed all input passed, instead of jumping out with longjmp. The scanner keeps its state, so that the next call of nextItem(unsigned short) continues where it stopped with the next chunk passed. A character split between two chunks is held back and completed with the first bytes of the next chunk
+	/// \param [in] chunk pointer to the chunk of input. The scanner does not copy it, the chunk must stay valid until nextItem(unsigned short) returned NeedMoreInput and the items returned before have been processed
+	/// \param [in] chunksize size of the chunk in bytes
+	/// \param [in] eof true, if the chunk passed is the last one (end of input)
+	void putInput( const char* chunk, std::size_t chunksize, bool eof)
+	{
+		std::size_t ofs = 0;
+		std::size_t scansize = 0;
+		if (m_validation.enabled)
+		{
+			m_validation.validator.check( chunk, chunksize);
+			m_validation.pending = false;
+		}
+		m_push.enabled = true;
+		m_push.eof = eof;
+		m_push.needMoreInput = false;
+		m_push.rest = 0;
+		m_push.restsize = 0;
+		m_push.tail = 0;
+		m_push.tailsize = 0;
+		if (m_push.carrysize)
+		{
+			// ... complete the character held back with the first bytes of the chunk
+			while (ofs < chunksize && m_push.carrysize < sizeof(m_push.carry)
+				&& InputCharSet::completeSize( m_push.carry, m_push.carrysize) < m_push.carrysize)
+			{
+				m_push.carry[ m_push.carrysize++] = chunk[ ofs++];
+			}
+			if (!eof && InputCharSet::completeSize( m_push.carry, m_push.carrysize) < m_push.carrysize)
+			{
+				// ... chunk too small to complete the character, wait for the next one
+				putChunk( m_push.scan, 0);
+				return;
+			}
+			std::memcpy( m_push.scan, m_push.carry, scansize = m_push.carrysize);
+			std::memset( m_push.scan + scansize, 0, sizeof(m_push.scan) - scansize);
+			m_push.carrysize = 0;
+		}
+		std::size_t restsize = eof ? (chunksize - ofs) : InputCharSet::completeSize( chunk + ofs, chunksize - ofs);
+		m_push.tail = chunk + ofs + restsize;
+		m_push.tailsize = chunksize - ofs - restsize;
+		if (scansize)
+		{
+			m_push.rest = chunk + ofs;
+			m_push.restsize = restsize;
+			putChunk( m_push.scan, scansize);
+		}
+		else
+		{
+			putChunk( chunk + ofs, restsize);
+		}
 	}
 
 	/// \brief Get the current source iterator position
@@ -1066,20 +1831,28 @@ public:
 
 	/// \brief Get the current parsed XML element pointer, if it was not masked out, see nextItem(unsigned short)
 	/// \return the item string
-	const char* getItemPtr() const {return m_outputBuf.size()?&m_outputBuf.at(0):"\0\0\0\0";}
+	const char* getItemPtr() const {return m_span?m_span:m_outputBuf.size()?&m_outputBuf.at(0):"\0\0\0\0";}
 
 	/// \brief Get the size of the current parsed XML element in bytes
 	/// \return the item string
-	std::size_t getItemSize() const {return m_outputBuf.size();}
+	std::size_t getItemSize() const {return m_span?m_spanSize:m_outputBuf.size();}
 
 	/// \brief Get the current parsed XML element, if it was not masked out, see nextItem(unsigned short)
+	/// \remark In zero copy mode an item returned as span in the source is copied to the output buffer on the first call (see setZeroCopy(bool))
 	/// \return the item string
 	const OutputBuffer& getItem() const
 	{
+		if (m_span)
+		{
+			appendBytes( m_outputBuf, m_span, m_spanSize);
+			m_span = 0;
+			m_spanSize = 0;
+		}
 		return m_outputBuf;
 	}
 
 	/// \brief Get the current XML scanner state machine state
+	/// \remark For debugging only. The scanner dispatches on the constant tables of XMLScannerTables, this builds the descriptive state machine XMLScannerBase::Statemachine on the first call
 	/// \return pointer to the state variables
 	ScannerStatemachine::Element* getState()
 	{
@@ -1087,6 +1860,22 @@ public:
 		return stm.get( state);
 	}
 
+	/// \brief Get the current XML scanner state machine state
+	/// \return the state
+	STMState getStateId() const
+	{
+		return state;
+	}
+
+	/// \brief Set the XML scanner state machine state
+	/// \remark Used to start scanning in the middle of a document (e.g. with CONTENT at a '&lt;'). Resets the token parsing state
+	/// \param [in] state_ the new state
+	void setState( STMState state_)
+	{
+		state = state_;
+		tokstate.init();
+	}
+
 	/// \brief Get the last error
 	/// \param [out] str the error as string
 	/// \return the error code
@@ -1098,6 +1887,13 @@ public:
 		return rt;
 	}
 
+	/// \brief Get the position of the invalid sequence reported with the error ErrInvalidUTF8 in strict UTF-8 mode (see setStrictUTF8(bool))
+	/// \return offset of the first byte of the sequence in bytes from the start of the input (since construction or restart)
+	std::size_t getErrorPosition() const
+	{
+		return m_validation.validator.errorPosition();
+	}
+
 	/// \brief Get the iterator pointing to the current source position
 	const InputIterator& getIterator() const
 	{
@@ -1110,47 +1906,74 @@ public:
 		return m_src.getIterator();
 	}
 
+	/// \brief Get the instrumentation policy object, e.g. for reading the counters of XMLScannerCounters (a copy is a snapshot)
+	const Instrumentation& getInstrumentation() const
+	{
+		return m_instrumentation;
+	}
+
+	/// \brief Get the instrumentation policy object, e.g. for clearing the counters of XMLScannerCounters
+	Instrumentation& getInstrumentation()
+	{
+		return m_instrumentation;
+	}
+
 	/// \brief Scan the next XML element
 	/// \param [in] mask element types that should be printed to the output buffer (1 -> print, 0 -> mask out, just return the element as event)
 	/// \return the type of the XML element
 	ElementType nextItem( unsigned short mask=0xFFFF)
 	{
-		static const IsWordCharMap wordC;
-		static const IsContentCharMap contentC;
-		static const IsTagCharMap tagC;
-		static const IsSQStringCharMap sqC;
-		static const IsDQStringCharMap dqC;
-		static const IsTokenCharMap* tokenDefs[ NofSTMActions] = {0,&wordC,&contentC,&tagC,&sqC,&dqC,0,0,0};
+		if (!m_validation.enabled) return scanItem( mask);
+		if (validateSource())
+		{
+			ElementType rt = scanItem( mask);
+			if (rt != Exit || m_validation.validator.finish()) return rt;
+		}
+		error = ErrInvalidUTF8;
+		return ErrorOccurred;
+	}
+
+private:
+	/// \brief Scan the next XML element without validating the input
+	/// \param [in] mask element types that should be printed to the output buffer (1 -> print, 0 -> mask out, just return the element as event)
+	/// \return the type of the XML element
+	ElementType scanItem( unsigned short mask)
+	{
+		typedef XMLScannerTables<> Tables;
 		static const char* stringDefs[ NofSTMActions] = {0,0,0,0,0,0,"xml","CDATA",0};
 
 		ElementType rt = None;
 		ControlCharacter ch;
+		m_span = 0;
 		do
 		{
-			ScannerStatemachine::Element* sd = getState();
-			if (sd->action.op != -1)
+			const typename Tables::StateDef& sd = Tables::state[ state];
+			if (sd.actionOp != Tables::NoAction)
 			{
-				if (tokenDefs[sd->action.op])
+				if (sd.actionOp >= ReturnWord && sd.actionOp <= ReturnDQString)
 				{
+					const bool* isTok = Tables::tokenChar[ sd.actionOp];
 					if (tokstate.id != TokState::ParsingDone)
 					{
-						if ((mask&(1<<sd->action.arg)) != 0)
+						if ((mask&(1<<sd.actionArg)) != 0)
 						{
-							if (!parseToken( *tokenDefs[ sd->action.op])) return ErrorOccurred;
+							if (!parseToken( isTok, Tables::tokenRun[ sd.actionOp])) return m_push.needMoreInput?NeedMoreInput:ErrorOccurred;
+							m_instrumentation.tokenParsed( m_outputBuf.size());
 						}
 						else
 						{
-							if (!skipToken( *tokenDefs[ sd->action.op])) return ErrorOccurred;
+							if (!skipToken( isTok)) return m_push.needMoreInput?NeedMoreInput:ErrorOccurred;
+							m_instrumentation.tokenSkipped();
 						}
 					}
-					rt = (ElementType)sd->action.arg;
+					rt = (ElementType)sd.actionArg;
 				}
-				else if (stringDefs[sd->action.op])
+				else if (stringDefs[sd.actionOp])
 				{
 					if (tokstate.id != TokState::ParsingDone)
 					{
-						if (!expectStr( stringDefs[sd->action.op])) return ErrorOccurred;
-						if (sd->action.op == ExpectIdentifierXML)
+						if (!expectStr( stringDefs[sd.actionOp])) return m_push.needMoreInput?NeedMoreInput:ErrorOccurred;
+						if (sd.actionOp == ExpectIdentifierXML)
 						{
 							//... special treatement for xml header for not
 							//    enforcing the model too much just for this case
@@ -1158,7 +1981,7 @@ public:
 							rt = HeaderStart;
 						}
 					}
-					else if (sd->action.op == ExpectIdentifierXML)
+					else if (sd.actionOp == ExpectIdentifierXML)
 					{
 						//... special treatement for xml header for not
 						//    enforcing the model too much just for this case
@@ -1168,42 +1991,34 @@ public:
 				else
 				{
 					m_outputBuf.clear();
-					rt = (ElementType)sd->action.arg;
+					rt = (ElementType)sd.actionArg;
 				}
-				if (sd->nofnext == 0)
+				if (sd.returnState != Tables::NoReturn)
 				{
-					if (sd->fallbackState != -1)
-					{
-						state = (STMState)sd->fallbackState;
-					}
+					m_instrumentation.enterState( state, (STMState)sd.returnState, m_src);
+					state = (STMState)sd.returnState;
 					return rt;
 				}
 			}
+			if (needMoreInput()) return NeedMoreInput;
 			ch = m_src.control();
 			tokstate.id = TokState::Start;
 
-			if (sd->next[ ch] != -1)
+			unsigned char next = Tables::transition[ state][ ch];
+			if (next < Tables::FallbackTransition)
 			{
-				state = (STMState)sd->next[ ch];
+				m_instrumentation.enterState( state, (STMState)next, m_src);
+				state = (STMState)next;
 				m_src.skip();
 			}
-			else if (sd->fallbackState != -1)
+			else if (next < Tables::ErrorTransition)
 			{
-				state = (STMState)sd->fallbackState;
-			}
-			else if (sd->missError != -1)
-			{
-				error = (Error)sd->missError;
-				return ErrorOccurred;
-			}
-			else if (ch == EndOfText)
-			{
-				error = ErrUnexpectedEndOfText;
-				return ErrorOccurred;
+				m_instrumentation.enterState( state, (STMState)(next - Tables::FallbackTransition), m_src);
+				state = (STMState)(next - Tables::FallbackTransition);
 			}
 			else
 			{
-				error = ErrInternal;
+				error = (Error)(next - Tables::ErrorTransition);
 				return ErrorOccurred;
 			}
 		}
@@ -1211,6 +2026,41 @@ public:
 		return rt;
 	}
 
+public:
+	/// \brief Scan the next batch of XML elements
+	/// \remark Clears the buffer passed and scans until the batch contains 'max' elements or until it got Exit, ErrorOccurred or (in push mode) NeedMoreInput, that are also put into the batch as last element
+	/// \remark The decision about the strict UTF-8 validation is taken once per batch, without validation the elements are scanned without the indirection of nextItem(unsigned short). The values of the elements are still copied one by one into the arena of the buffer
+	/// \param [out] buf buffer for the elements scanned
+	/// \param [in] max maximum number of elements to scan
+	/// \param [in] mask element types that should be printed to the output buffer (1 -> print, 0 -> mask out, just return the element as event)
+	/// \return the number of elements in the batch
+	std::size_t nextItems( EventBuffer& buf, std::size_t max, unsigned short mask=0xFFFF)
+	{
+		buf.clear();
+		if (m_validation.enabled)
+		{
+			while (buf.size() < max && pushItem( buf, nextItem( mask))){}
+		}
+		else
+		{
+			while (buf.size() < max && pushItem( buf, scanItem( mask))){}
+		}
+		return buf.size();
+	}
+
+private:
+	/// \brief Append the current element to a batch
+	/// \param [out] buf batch to append the element to
+	/// \param [in] type type of the element
+	/// \return false, if the element ends the batch (Exit, ErrorOccurred or NeedMoreInput)
+	bool pushItem( EventBuffer& buf, ElementType type) const
+	{
+		buf.push( type, getItemPtr(), getItemSize());
+		return type != Exit && type != ErrorOccurred && type != NeedMoreInput;
+	}
+
+public:
+
 	/// \class End
 	/// \brief end of input tag
 	struct End {};
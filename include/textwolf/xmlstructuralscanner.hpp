@@ -0,0 +1,343 @@
+/*
+---------------------------------------------------------------------
+    The template library textwolf implements an input iterator on
+    a set of XML path expressions without backward references on an
+    STL conforming input iterator as source. It does no buffering
+    or read ahead and is dedicated for stream processing of XML
+    for a small set of XML queries.
+    Stream processing in this context refers to processing the
+    document without buffering anything but the current result token
+    processed with its tag hierarchy information.
+
+    Copyright (C) 2010,2011,2012,2013,2014 Patrick Frey
+
+    This library is free software; you can redistribute it and/or
+    modify it under the terms of the GNU Lesser General Public
+    License as published by the Free Software Foundation; either
+    version 3.0 of the License, or (at your option) any later version.
+
+    This library is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+    Lesser General Public License for more details.
+
+    You should have received a copy of the GNU Lesser General Public
+    License along with this library; if not, write to the Free Software
+    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+
+--------------------------------------------------------------------
+
+	The latest version of textwolf can be found at 'http://github.com/patrickfrey/textwolf'
+	For documentation see 'http://patrickfrey.github.com/textwolf'
+
+--------------------------------------------------------------------
+*/
+/// \file textwolf/xmlstructuralscanner.hpp
+/// \brief XML scanner for UTF-8 documents in memory scanning in two stages: indexing the structural bytes, then running the state machine on the structural bytes only
+
+#ifndef __TEXTWOLF_XML_STRUCTURAL_SCANNER_HPP__
+#define __TEXTWOLF_XML_STRUCTURAL_SCANNER_HPP__
+#include "textwolf/xmlscanner.hpp"
+#include "textwolf/structuralindex.hpp"
+#include "textwolf/sourceiterator.hpp"
+#include "textwolf/charset_utf8.hpp"
+#include "textwolf/entitytable.hpp"
+#include <string>
+#include <cstddef>
+
+/// \namespace textwolf
+/// \brief Toplevel namespace of the library
+namespace textwolf {
+
+/// \class XMLStructuralScanner
+/// \brief XML scanner for UTF-8 documents in memory scanning in two stages
+/// \remark Stage one builds the index of the structural bytes and of the quoted regions of the document (see XMLStructuralIndex). Stage two runs the state machine of XMLScanner (XMLScannerTables) on the structural bytes only: a token ends at the next structural byte found in the index and a byte not indexed is classified as a name or content character without reading it
+/// \remark Tags, attributes and content without entities and carriage returns are scanned along the index. An element needing more (the XML header, comments, processing instructions, CDATA sections, DTD declarations, tokens with entities or end of line translation, errors) is scanned again from its start by an XMLScanner. Scanning continues along the index at the next element, after which the XMLScanner is in a state of markup or content entered by consuming a character. A document containing an incomplete UTF-8 character is scanned by the XMLScanner from the window of the index containing it to the end
+/// \remark The elements returned are the same as those of XMLScanner<SrcIterator,charset::UTF8,charset::UTF8,OutputBuffer_> in zero copy mode on the document, except for elements masked out, that are returned empty, and the value of ErrorOccurred, that is not defined. The items are spans in the document where possible, they are valid as long as the document
+/// \tparam OutputBuffer_ buffer for output with STL back insertion sequence interface (e.g. std::string,std::vector<char>,textwolf::StaticBuffer) for the elements that need rewriting
+template <class OutputBuffer_=std::string>
+class XMLStructuralScanner
+	:public XMLScannerBase
+{
+public:
+	typedef OutputBuffer_ OutputBuffer;
+	typedef XMLScanner<SrcIterator,charset::UTF8,charset::UTF8,OutputBuffer_> Scanner;
+
+	/// \brief Constructor
+	/// \param [in] src pointer to the document, must stay valid during scanning
+	/// \param [in] srcsize size of the document in bytes
+	XMLStructuralScanner( const char* src, std::size_t srcsize)
+		:m_src(src),m_srcsize(srcsize),m_index(src,srcsize),m_scanner(SrcIterator(src,srcsize)),m_state(START),m_pos(0),m_scannerActive(false),m_irregular(false),m_itemPtr(0),m_itemSize(0),m_scannerStart(0),m_nofScannerItems(0)
+	{
+		m_scanner.setZeroCopy();
+	}
+
+	/// \brief Constructor
+	/// \param [in] src pointer to the document, must stay valid during scanning
+	/// \param [in] srcsize size of the document in bytes
+	/// \param [in] p_entityTable read only table of named entities defined by the user
+	XMLStructuralScanner( const char* src, std::size_t srcsize, const EntityTable& p_entityTable)
+		:m_src(src),m_srcsize(srcsize),m_index(src,srcsize),m_scanner(SrcIterator(src,srcsize),p_entityTable),m_state(START),m_pos(0),m_scannerActive(false),m_irregular(false),m_itemPtr(0),m_itemSize(0),m_scannerStart(0),m_nofScannerItems(0)
+	{
+		m_scanner.setZeroCopy();
+	}
+
+	/// \brief Scan the next XML element
+	/// \param [in] mask element types that should be returned with their value (1 -> return value, 0 -> mask out, just return the element as event)
+	/// \return the type of the XML element
+	ElementType nextItem( unsigned short mask=0xFFFF)
+	{
+		if (!m_scannerActive)
+		{
+			ElementType rt = scanIndexed( mask);
+			if (rt != None) return rt;
+			// ... scan the element again from its start with the XMLScanner
+			m_scanner.restart( SrcIterator( m_src + m_pos, m_srcsize - m_pos));
+			m_scanner.setState( m_state);
+			m_scannerStart = m_pos;
+			m_scannerActive = true;
+		}
+		return scanDelegated( mask);
+	}
+
+	/// \brief Get the current parsed XML element pointer, if it was not masked out, see nextItem(unsigned short)
+	/// \return the item string
+	const char* getItemPtr() const {return m_scannerActive?m_scanner.getItemPtr():m_itemSize?m_itemPtr:"\0\0\0\0";}
+
+	/// \brief Get the size of the current parsed XML element in bytes
+	/// \return the item string
+	std::size_t getItemSize() const {return m_scannerActive?m_scanner.getItemSize():m_itemSize;}
+
+	/// \brief Get the last error
+	/// \param [out] str the error as string
+	/// \return the error code
+	Error getError( const char** str=0)
+	{
+		return m_scanner.getError( str);
+	}
+
+	/// \brief Get the number of elements scanned by the XMLScanner instead of along the index
+	std::size_t nofScannerItems() const
+	{
+		return m_nofScannerItems;
+	}
+
+private:
+	/// \brief Get the region of the document a state of the state machine scanned along the index is in
+	/// \param [in] state_ the state
+	/// \param [out] region the region
+	/// \return true, if the state is scanned along the index
+	static bool indexedState( STMState state_, XMLStructuralIndex::Region& region)
+	{
+		switch (state_)
+		{
+			case CONTENT: case TOKEN: case EXIT:
+				region = XMLStructuralIndex::Content;
+				return true;
+			case XMLTAG: case OPENTAG: case CLOSETAG: case TAGCLSK: case TAGAISK: case TAGANAM:
+			case TAGAESK: case TAGAVSK: case TAGAVID: case TAGAVQE: case TAGCLIM:
+				region = XMLStructuralIndex::Markup;
+				return true;
+			case TAGAVSQ: case TAGAVDQ:
+				region = XMLStructuralIndex::Quoted;
+				return true;
+			default:
+				return false;
+		}
+	}
+
+	/// \brief Make the index cover a position
+	/// \param [in] pos position in the document, at most the end of the window indexed
+	/// \return false, if the window built contains an incomplete UTF-8 character
+	bool cover( std::size_t pos)
+	{
+		while (pos >= m_index.end() && m_index.end() < m_srcsize)
+		{
+			m_index.buildNext();
+			if (m_index.irregular())
+			{
+				m_irregular = true;
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/// \brief Get the control character of the byte at a position in a region scanned along the index
+	/// \remark Bytes that are not structural are not read. They are name characters in markup and content characters in content and all of them have the same transitions as Any in the states scanned along the index
+	/// \param [in] pos position in the document
+	/// \param [out] ch the control character
+	/// \return false, if the window built contains an incomplete UTF-8 character
+	bool control( std::size_t pos, ControlCharacter& ch)
+	{
+		if (pos >= m_srcsize)
+		{
+			ch = EndOfText;
+			return true;
+		}
+		if (!cover( pos)) return false;
+		ch = m_index.structural( pos)?ControlCharTable<>::ar[ (unsigned char)m_src[ pos]]:Any;
+		return true;
+	}
+
+	/// \brief Find the next structural byte
+	/// \param [in] pos position in the document to start the search at, at most the end of the window indexed
+	/// \param [out] rt the position of the next structural byte or the size of the document
+	/// \return false, if a window built contains an incomplete UTF-8 character
+	bool nextStructural( std::size_t pos, std::size_t& rt)
+	{
+		for (;;)
+		{
+			if (pos >= m_srcsize)
+			{
+				rt = m_srcsize;
+				return true;
+			}
+			if (!cover( pos)) return false;
+			rt = m_index.next( pos);
+			if (rt < m_index.end()) return true;
+			pos = rt;
+		}
+	}
+
+	/// \brief Scan the next XML element along the index
+	/// \param [in] mask element types that should be returned with their value
+	/// \return the type of the XML element or None, if the element has to be scanned by the XMLScanner
+	ElementType scanIndexed( unsigned short mask)
+	{
+		typedef XMLScannerTables<> Tables;
+		XMLStructuralIndex::Region region;
+		STMState state = m_state;
+		std::size_t pos = m_pos;
+		const char* itemPtr = 0;
+		std::size_t itemSize = 0;
+		ElementType rt = None;
+		do
+		{
+			if (!indexedState( state, region)) return None;
+			const typename Tables::StateDef& sd = Tables::state[ state];
+			if (sd.actionOp != Tables::NoAction)
+			{
+				if (sd.actionOp == Return)
+				{
+					itemSize = 0;
+					rt = (ElementType)sd.actionArg;
+					if (sd.returnState != Tables::NoReturn)
+					{
+						state = (STMState)sd.returnState;
+						break;
+					}
+				}
+				else
+				{
+					std::size_t end;
+					if (!nextStructural( pos, end)) return None;
+					unsigned char delim = (end < m_srcsize)?(unsigned char)m_src[ end]:0;
+					// ... entities and end of line translation need rewriting, a carriage return terminating a name does not
+					if (delim == '&' || (delim == '\r' && sd.actionOp != ReturnIdentifier)) return None;
+					if ((mask&(1<<sd.actionArg)) != 0)
+					{
+						itemPtr = m_src + pos;
+						itemSize = end - pos;
+					}
+					pos = end;
+					rt = (ElementType)sd.actionArg;
+				}
+			}
+			ControlCharacter ch;
+			if (!control( pos, ch)) return None;
+
+			unsigned char next = Tables::transition[ state][ ch];
+			if (next < Tables::FallbackTransition)
+			{
+				state = (STMState)next;
+				++pos;
+			}
+			else if (next < Tables::ErrorTransition)
+			{
+				state = (STMState)(next - Tables::FallbackTransition);
+			}
+			else
+			{
+				return None;
+			}
+		}
+		while (rt == None);
+		m_state = state;
+		m_pos = (pos < m_srcsize)?pos:m_srcsize;
+		m_itemPtr = itemPtr;
+		m_itemSize = itemSize;
+		return rt;
+	}
+
+	/// \brief Scan the next XML element with the XMLScanner and switch back to scanning along the index, if possible
+	/// \param [in] mask element types that should be returned with their value
+	/// \return the type of the XML element
+	ElementType scanDelegated( unsigned short mask)
+	{
+		ElementType rt = m_scanner.nextItem( mask);
+		++m_nofScannerItems;
+		if (rt == ErrorOccurred || m_irregular) return rt;
+
+		STMState state = m_scanner.getStateId();
+		std::size_t pos = m_scannerStart + m_scanner.getPosition();
+		if (state == EXIT)
+		{
+			pos = m_srcsize;
+		}
+		else
+		{
+			XMLStructuralIndex::Region region;
+			switch (state)
+			{
+				case CONTENT:
+					// ... entered by consuming '>', otherwise the current character may be fetched already
+					if (pos == 0 || m_src[ pos-1] != '>') return rt;
+					region = XMLStructuralIndex::Content;
+					break;
+				case XMLTAG: case TAGCLSK: case TAGAISK: case TAGAESK: case TAGAVSK: case TAGAVQE:
+					// ... states entered only by consuming a character
+					region = XMLStructuralIndex::Markup;
+					break;
+				default:
+					return rt;
+			}
+			if (!m_index.covers( pos) || m_index.region( pos) != region)
+			{
+				m_index.build( pos, region);
+				if (m_index.irregular())
+				{
+					m_irregular = true;
+					return rt;
+				}
+			}
+		}
+		m_state = state;
+		m_pos = pos;
+		m_scannerActive = false;
+		// ... the item returned by the XMLScanner stays valid until the next call
+		m_itemPtr = m_scanner.getItemPtr();
+		m_itemSize = m_scanner.getItemSize();
+		return rt;
+	}
+
+private:
+	XMLStructuralScanner( const XMLStructuralScanner&);			///< non copyable (the item of the XMLScanner may refer to its buffer)
+	XMLStructuralScanner& operator=( const XMLStructuralScanner&);		///< non copyable
+
+	const char* m_src;			///< pointer to the document
+	std::size_t m_srcsize;			///< size of the document in bytes
+	XMLStructuralIndex m_index;		///< index of the window of the document scanned
+	Scanner m_scanner;			///< scanner for the elements that are not scanned along the index
+	STMState m_state;			///< state of the state machine when scanning along the index
+	std::size_t m_pos;			///< position in the document when scanning along the index
+	bool m_scannerActive;			///< true, if the elements are scanned by m_scanner
+	bool m_irregular;			///< true, if the document contains an incomplete UTF-8 character, all elements after are scanned by m_scanner
+	const char* m_itemPtr;			///< pointer to the current item, if not scanned by m_scanner
+	std::size_t m_itemSize;			///< size of the current item, if not scanned by m_scanner
+	std::size_t m_scannerStart;		///< position in the document m_scanner has been started at
+	std::size_t m_nofScannerItems;		///< number of elements scanned by m_scanner
+};
+
+}//namespace
+#endif
@@ -0,0 +1,221 @@
+#include "textwolf.hpp"
+#include "textwolf/bytescan.hpp"
+#include "textwolf/istreamiterator.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstring>
+
+//build gcc
+//compile: g++ -c -o test_ByteScanSet.o -g -I../include/ -pedantic -Wall -O4 test_ByteScanSet.cpp
+//link: g++ -lc -o test_ByteScanSet test_ByteScanSet.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_ByteScanSet.obj" test_ByteScanSet.cpp
+//link: link.exe /out:.\test_ByteScanSet test_ByteScanSet.obj
+
+// Checks the search of ByteScanSet (find, findz) against a byte by byte search for sets taking the
+// different paths of the vectorized search, at all start offsets and block sizes around the vector size,
+// and that TextScanner::copyRun stops exactly at the delimiters and at the end of blocks of an IStreamIterator
+// without splitting a character.
+
+using namespace textwolf;
+
+/// \brief Pseudo random byte sequence, deterministic for reproducible test runs
+static std::string randomBytes( std::size_t size, const char* alphabet, unsigned int seed)
+{
+	std::size_t alphabetsize = std::strlen( alphabet);
+	std::string rt;
+	for (std::size_t ii=0; ii<size; ++ii)
+	{
+		seed = seed * 1103515245 + 12345;
+		std::size_t idx = (seed >> 16) % (alphabetsize + 1);
+		// ... one of (alphabetsize + 1) bytes is an arbitrary byte
+		rt.push_back( (idx < alphabetsize) ? alphabet[ idx] : (char)((seed >> 8) & 0xFF));
+	}
+	return rt;
+}
+
+static const char* findReference( const ByteScanSet& set, const char* src, const char* end)
+{
+	for (; src < end && !set[ (unsigned char)*src]; ++src){}
+	return src;
+}
+
+static unsigned int testSet( const ByteScanSet& set, const char* name, const char* alphabet)
+{
+	unsigned int errors = 0;
+	for (unsigned int seed=1; seed<=4; ++seed)
+	{
+		std::string data = randomBytes( 256, alphabet, seed);
+		for (std::size_t start=0; start<64; ++start)
+		{
+			for (std::size_t size=0; size<=130; ++size)
+			{
+				const char* src = data.c_str() + start;
+				const char* found = set.find( src, src + size);
+				const char* expected = findReference( set, src, src + size);
+				if (found != expected)
+				{
+					std::cerr << name << ": find from " << start << " size " << size << " returns " << (found - src) << " instead of " << (expected - src) << std::endl;
+					++errors;
+				}
+				if (set[ 0])
+				{
+					// ... null terminated copy for findz
+					std::string zdata( data.c_str() + start, size);
+					const char* zsrc = zdata.c_str();
+					const char* zfound = set.findz( zsrc);
+					const char* zexpected = findReference( set, zsrc, zsrc + size);
+					if (zfound != zexpected)
+					{
+						std::cerr << name << ": findz from " << start << " size " << size << " returns " << (zfound - zsrc) << " instead of " << (zexpected - zsrc) << std::endl;
+						++errors;
+					}
+				}
+			}
+		}
+	}
+	return errors;
+}
+
+/// \brief Scan a UTF-8 document with copyRun for the runs and character by character for the rest and return it with the runs marked
+/// \param[in] checkMaximal true, if the runs must reach the next delimiter (source in one block)
+template <class Iterator>
+static std::string copyRuns( Iterator itr, const ByteScanSet& delim, bool checkMaximal, unsigned int& errors)
+{
+	charset::UTF8 utf8;
+	TextScanner<Iterator,charset::UTF8> ts( itr);
+	std::string rt;
+	for (;;)
+	{
+		std::string run;
+		std::size_t nn = ts.copyRun( delim, utf8, run);
+		if (nn != run.size())
+		{
+			std::cerr << "copyRun returns " << nn << " for a run of " << run.size() << " bytes" << std::endl;
+			++errors;
+		}
+		if (findReference( delim, run.c_str(), run.c_str() + run.size()) != run.c_str() + run.size())
+		{
+			std::cerr << "run copied contains a delimiter: '" << run << "'" << std::endl;
+			++errors;
+		}
+		if (nn)
+		{
+			rt.append( "[");
+			rt.append( run);
+			rt.append( "]");
+		}
+		UChar ch = *ts;
+		if (!ch) break;
+		bool isdelim = (ch < 0x80 && delim[ (unsigned char)ch]);
+		if (checkMaximal && nn && !isdelim)
+		{
+			std::cerr << "run copied '" << run << "' does not end at a delimiter" << std::endl;
+			++errors;
+		}
+		utf8.print( ch, rt);
+		++ts;
+	}
+	return rt;
+}
+
+/// \brief Remove the run markers of copyRuns(..)
+static std::string stripRuns( const std::string& str)
+{
+	std::string rt;
+	for (std::string::const_iterator si = str.begin(); si != str.end(); ++si)
+	{
+		if (*si != '[' && *si != ']') rt.push_back( *si);
+	}
+	return rt;
+}
+
+static unsigned int testCopyRun()
+{
+	unsigned int errors = 0;
+	ByteScanSet delim;
+	delim(0)('<')('&')('\r');
+	static const char* pieces[] = {"a","bcdefgh","\xC3\xA4","\xE2\x82\xAC","\xF0\x90\x80\x80","<","&","\r\n"," ",0};
+	for (unsigned int seed=1; seed<=40; ++seed)
+	{
+		// ... document of pieces with runs of varying length
+		std::string doc;
+		unsigned int rnd = seed;
+		while (doc.size() < 200)
+		{
+			rnd = rnd * 1103515245 + 12345;
+			unsigned int pi = (rnd >> 16) % 9;
+			unsigned int repeat = (pi < 5) ? ((rnd >> 8) % 40) : 1;
+			for (unsigned int ri=0; ri<repeat; ++ri) doc.append( pieces[ pi]);
+		}
+		std::string expected = copyRuns( CStringIterator( doc.c_str(), doc.size()), delim, true, errors);
+		if (stripRuns( expected) != doc)
+		{
+			std::cerr << "runs copied from a CStringIterator differ from the document:" << std::endl << expected << std::endl;
+			++errors;
+		}
+		std::string expectedz = copyRuns( doc.c_str(), delim, true, errors);
+		if (expectedz != expected)
+		{
+			std::cerr << "runs copied from a null terminated string differ:" << std::endl << expectedz << std::endl << "expected:" << std::endl << expected << std::endl;
+			++errors;
+		}
+		for (std::size_t bufsize=1; bufsize<=70; ++bufsize)
+		{
+			std::istringstream input( doc);
+			StdInputStream stream( input);
+			std::string result = copyRuns( IStreamIterator( &stream, bufsize), delim, false, errors);
+			if (stripRuns( result) != doc)
+			{
+				std::cerr << "runs copied from an IStreamIterator with buffer size " << bufsize << " differ from the document:" << std::endl << result << std::endl;
+				++errors;
+			}
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	{
+		ByteScanSet set;
+		set(0)('<')('&');
+		errors += testSet( set, "single bytes", "abc<&\n");
+	}
+	{
+		ByteScanSet set;
+		set(0,0x20)('<')('>')('=')('/')('?')('!')('"')('\'');
+		errors += testSet( set, "control range", "ab< \t\n=/'\"x");
+	}
+	{
+		ByteScanSet set;
+		set(0)('\n')('\r')('\t')('a','m');
+		errors += testSet( set, "control range with gaps", "ahsz\n\r \x01\t");
+	}
+	{
+		ByteScanSet set;
+		set(0)('<')(0x80,0xFF);
+		errors += testSet( set, "high range", "ab<\xC3\xA4\xE2\x82\xAC");
+	}
+	{
+		ByteScanSet set;
+		set(0)(0xC3);
+		errors += testSet( set, "high byte", "ab\xC3\xA4\xE2\x82\xAC");
+	}
+	{
+		ByteScanSet set;
+		set(0)('A','Z');
+		errors += testSet( set, "too many for the vectorized search", "abcXYZ<");
+	}
+	errors += testCopyRun();
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,81 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+
+//build gcc
+//compile: g++ -c -o test_CharSetPrint.o -g -I../include/ -pedantic -Wall -O4 test_CharSetPrint.cpp
+//link: g++ -lc -o test_CharSetPrint test_CharSetPrint.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_CharSetPrint.obj" test_CharSetPrint.cpp
+//link: link.exe /out:.\test_CharSetPrint test_CharSetPrint.obj
+
+// Checks that printing an array of characters in bulk with print(const UChar*,const UChar*,Buffer&) results in the same
+// output as printing the characters one by one with print(UChar,Buffer&) for all character set encodings, for all characters
+// of the Unicode range, characters beyond and arrays longer than the chunks the bulk print is encoding to.
+
+using namespace textwolf;
+
+template <class CharSet>
+static unsigned int testPrint( const char* what, const CharSet& charset, const std::vector<UChar>& chars)
+{
+	std::string expected;
+	for (std::size_t ii=0; ii<chars.size(); ++ii) charset.print( chars[ ii], expected);
+
+	std::string bulk;
+	charset.print( &chars[0], &chars[0] + chars.size(), bulk);
+
+	// ... bulk print to a buffer with the back insertion sequence interface only
+	std::vector<char> vbulk;
+	charset.print( &chars[0], &chars[0] + chars.size(), vbulk);
+
+	if (bulk == expected && std::string( vbulk.begin(), vbulk.end()) == expected) return 0;
+	std::size_t pos = 0;
+	const std::string& result = (bulk == expected) ? std::string( vbulk.begin(), vbulk.end()) : bulk;
+	while (pos < result.size() && pos < expected.size() && result[ pos] == expected[ pos]) ++pos;
+	std::cerr << "bulk print of " << what << " differs at byte " << pos << " of " << expected.size() << std::endl;
+	return 1;
+}
+
+template <class CharSet>
+static unsigned int test( const char* what, const CharSet& charset)
+{
+	unsigned int errors = 0;
+	std::vector<UChar> chars;
+	for (UChar ch=1; ch<=0x110000; ++ch) chars.push_back( ch);
+	static const UChar beyond[] = {0x1FFFFF, 0x200000, 0x3FFFFFF, 0x4000000, 0x7FFFFFFF, 0x80000000, 0xFFFFFFFF, 0};
+	for (unsigned int ii=0; beyond[ ii]; ++ii) chars.push_back( beyond[ ii]);
+	errors += testPrint( what, charset, chars);
+
+	// ... short arrays around the surrogates
+	for (std::size_t size=0; size<8; ++size)
+	{
+		std::vector<UChar> part( chars.begin() + 0xD7F0, chars.begin() + 0xD7F0 + size);
+		part.push_back( 0);
+		errors += testPrint( what, charset, part);
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += test( "UTF-8", charset::UTF8());
+	errors += test( "UTF-16LE", charset::UTF16LE());
+	errors += test( "UTF-16BE", charset::UTF16BE());
+	errors += test( "UCS-2LE", charset::UCS2LE());
+	errors += test( "UCS-2BE", charset::UCS2BE());
+	errors += test( "UCS-4LE", charset::UCS4LE());
+	errors += test( "UCS-4BE", charset::UCS4BE());
+	errors += test( "ISO-8859-1", charset::IsoLatin( 1));
+	errors += test( "ISO-8859-9", charset::IsoLatin( 9));
+	errors += test( "Windows-1251", charset::Windows125x( 1251));
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,189 @@
+#include "textwolf.hpp"
+#include "textwolf/entitytable.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <map>
+
+//build gcc
+//compile: g++ -c -o test_EntityTable.o -g -I../include/ -pedantic -Wall -O4 test_EntityTable.cpp
+//link: g++ -lc -o test_EntityTable test_EntityTable.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_EntityTable.obj" test_EntityTable.cpp
+//link: link.exe /out:.\test_EntityTable test_EntityTable.obj
+
+// Checks the lookup of the EntityTable for tables of different sizes (with many names colliding in the buckets of the hash),
+// for names not defined, duplicate definitions and the tables built from user maps, and the XMLScanner with an entity table,
+// including entity names at the length limit of the scanner.
+
+using namespace textwolf;
+
+static std::string entityName( unsigned int idx)
+{
+	std::ostringstream rt;
+	rt << "e" << idx;
+	return rt.str();
+}
+
+static unsigned int checkFind( const EntityTable& table, const std::string& name, bool defined, UChar expected, const char* what)
+{
+	UChar value = 0;
+	bool found = table.find( name.c_str(), name.size(), value);
+	if (found != defined || (defined && value != expected))
+	{
+		std::cerr << what << ": lookup of '" << name << "' " << (found?"found":"did not find") << " the entity";
+		if (found) std::cerr << " with value " << value;
+		std::cerr << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+/// \brief Tables of N generated names, all names defined have to be found, similar names not
+static unsigned int testSizes()
+{
+	unsigned int errors = 0;
+	static const unsigned int sizes[] = {1,2,3,7,8,9,100,1000,5000,0};
+	for (unsigned int si=0; sizes[ si]; ++si)
+	{
+		std::map<std::string,UChar> defs;
+		for (unsigned int ii=0; ii<sizes[ si]; ++ii) defs[ entityName( ii)] = 0x100 + ii;
+		EntityTable table( defs);
+		if (table.size() != sizes[ si])
+		{
+			std::cerr << "table of " << sizes[ si] << " entities has size " << table.size() << std::endl;
+			++errors;
+		}
+		for (unsigned int ii=0; ii<sizes[ si]; ++ii)
+		{
+			errors += checkFind( table, entityName( ii), true, 0x100 + ii, "generated names");
+		}
+		for (unsigned int ii=sizes[ si]; ii<sizes[ si]*2+10; ++ii)
+		{
+			errors += checkFind( table, entityName( ii), false, 0, "generated names");
+		}
+		errors += checkFind( table, "", false, 0, "empty name");
+		errors += checkFind( table, "e", false, 0, "prefix");
+		errors += checkFind( table, entityName( 0) + "0", false, 0, "longer name");
+		errors += checkFind( table, entityName( 0).substr( 0, 1), false, 0, "shorter name");
+	}
+	return errors;
+}
+
+static unsigned int testDefinitions()
+{
+	unsigned int errors = 0;
+	{
+		EntityTable table;
+		errors += checkFind( table, "amp", false, 0, "empty table");
+		errors += checkFind( table, "", false, 0, "empty table");
+	}
+	{
+		// ... the last one of duplicate definitions is valid
+		static const EntityTable::Entity ar[] = {{"auml",0xE4},{"ouml",0xF6},{"auml",0xC4},{"euro",0x20AC},{"a",0x61}};
+		EntityTable table( ar, sizeof(ar)/sizeof(ar[0]));
+		if (table.size() != 4)
+		{
+			std::cerr << "table with a duplicate definition has size " << table.size() << std::endl;
+			++errors;
+		}
+		errors += checkFind( table, "auml", true, 0xC4, "duplicate definition");
+		errors += checkFind( table, "ouml", true, 0xF6, "array");
+		errors += checkFind( table, "euro", true, 0x20AC, "array");
+		errors += checkFind( table, "a", true, 0x61, "array");
+		errors += checkFind( table, "uml", false, 0, "array");
+		errors += checkFind( table, "aum", false, 0, "array");
+		UChar value = 0;
+		if (!table.find( "euro", value) || value != 0x20AC)
+		{
+			std::cerr << "lookup of a null terminated name failed" << std::endl;
+			++errors;
+		}
+	}
+	{
+		std::map<const char*,UChar> defs;
+		defs[ "copy"] = 0xA9;
+		defs[ "reg"] = 0xAE;
+		EntityTable table( defs);
+		errors += checkFind( table, "copy", true, 0xA9, "map of const char*");
+		errors += checkFind( table, "reg", true, 0xAE, "map of const char*");
+		errors += checkFind( table, "regx", false, 0, "map of const char*");
+	}
+	return errors;
+}
+
+static std::string scan( const std::string& doc, const EntityTable& table)
+{
+	typedef XMLScanner<CStringIterator,charset::UTF8,charset::UTF8,std::string> Scanner;
+	Scanner scanner( CStringIterator( doc.c_str(), doc.size()), table);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		if (type == XMLScannerBase::ErrorOccurred)
+		{
+			rt.append( XMLScannerBase::getErrorString( scanner.getError()));
+		}
+		else
+		{
+			rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		}
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+static unsigned int testScanner()
+{
+	struct TestCase
+	{
+		const char* doc;
+		const char* expected;
+	};
+	static const TestCase tests[] =
+	{
+		{"<a x='&auml;&amp;'>&euro;&lt;&abcdefghijklmno;</a>",
+			"OpenTag a\nTagAttribName x\nTagAttribValue \xC3\xA4&\nContent \xE2\x82\xAC<!\nCloseTag a\nExit \n"},
+		// ... entity name longer than 15 bytes is passed through as text
+		{"<a>&abcdefghijklmnop;</a>",
+			"OpenTag a\nContent &abcdefghijklmnop;\nCloseTag a\nExit \n"},
+		{"<a>&undefined;</a>",
+			"OpenTag a\nErrorOccurred undefined character entity\n"},
+		{0,0}
+	};
+	unsigned int errors = 0;
+	std::map<std::string,UChar> defs;
+	defs[ "auml"] = 0xE4;
+	defs[ "euro"] = 0x20AC;
+	defs[ "abcdefghijklmno"] = '!';
+	defs[ "abcdefghijklmnop"] = '?';
+	EntityTable table( defs);
+	for (unsigned int ti=0; tests[ ti].doc; ++ti)
+	{
+		std::string result = scan( tests[ ti].doc, table);
+		if (result != tests[ ti].expected)
+		{
+			std::cerr << "scanning '" << tests[ ti].doc << "' with an entity table returns:" << std::endl << result << "expected:" << std::endl << tests[ ti].expected;
+			++errors;
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += testSizes();
+	errors += testDefinitions();
+	errors += testScanner();
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,203 @@
+#include "textwolf.hpp"
+#include "textwolf/gzipinputstream.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cerrno>
+
+//build gcc
+//compile: g++ -c -o test_GzipInputStream.o -g -I../include/ -pedantic -Wall -O4 -DTEXTWOLF_WITH_ZLIB test_GzipInputStream.cpp
+//link: g++ -lc -o test_GzipInputStream test_GzipInputStream.o -lz
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_GzipInputStream.obj" test_GzipInputStream.cpp
+//link: link.exe /out:.\test_GzipInputStream test_GzipInputStream.obj
+
+// Checks that the XMLScanner on an IStreamIterator reading from a GzipInputStream returns the same elements as on a CStringIterator for uncompressed input passed through
+// and, if built with zlib (TEXTWOLF_WITH_ZLIB), for input compressed in gzip and zlib format and concatenated gzip members, with buffers smaller than a character.
+// Checks a document compressed with the gzip program, that is read if built with zlib and reported as error otherwise, and the errors for corrupt and truncated input.
+
+using namespace textwolf;
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml version='1.0'?>\n<!-- comment -->\r\n<doc a='x&amp;y' b=\"\xC3\xA4\xE2\x82\xAC\">text \xC3\xA4\r\nline&#x20AC;&lt;<![CDATA[<raw>]]><e/>\xF0\x90\x80\x80 tail</doc>",
+	"<doc><item id='1'>first</item><item id='2'>second\r\rthird</item><empty/></doc>",
+	"<doc a=>error</doc>",
+	"<doc/>",
+	0
+};
+
+static const std::size_t bufferSizes[] = {1,3,64,8192,0};
+static const std::size_t inputBufferSizes[] = {1,5,65536,0};
+
+// Document "<?xml version='1.0'?>\n<doc a='x'>gzip \xC3\xA4</doc>" compressed with 'gzip -9n'
+static const char gzipDocument[] =
+	"\x1F\x8B\x08\x00\x00\x00\x00\x00\x02\x03\xB3\xB1\xAF\xC8\xCD\x51\x28\x4B\x2D\x2A\xCE\xCC\xCF\xB3\x55\x37\xD4\x33\x50\xB7\xB7\xE3\xB2\x49\xC9\x4F\x56\x48\xB4\x55\xAF\x50\xB7\x4B\xAF\xCA\x2C\x50\x38\xBC\xC4\x46\x1F\x28\x64\x07\x00\x45\xBD\xA6\xC5\x2E\x00\x00\x00";
+static const std::size_t gzipDocumentSize = 65;
+static const char* gzipDocumentContent = "<?xml version='1.0'?>\n<doc a='x'>gzip \xC3\xA4</doc>";
+
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static std::string scan( const Iterator& itr)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Scanner scanner( itr);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Encode a UTF-8 document in the character set encoding of the input
+template <class CharSet>
+static std::string encode( const char* doc)
+{
+	CharSet charset;
+	std::string rt;
+	TextScanner<CStringIterator,charset::UTF8> ts( (CStringIterator( doc)));
+	for (; *ts; ++ts) charset.print( *ts, rt);
+	return rt;
+}
+
+/// \brief Scan an input through a GzipInputStream
+/// \return the elements scanned or the error reading the input
+template <class InputCharSet, class OutputCharSet>
+static std::string scanInflated( const std::string& input, std::size_t bufsize, std::size_t inbufsize, int& errorcode)
+{
+	std::istringstream src( input);
+	StdInputStream source( src);
+	GzipInputStream stream( &source, inbufsize);
+	errorcode = 0;
+	try
+	{
+		return scan<IStreamIterator,InputCharSet,OutputCharSet>( IStreamIterator( &stream, bufsize));
+	}
+	catch (const exception& err)
+	{
+		errorcode = stream.errorcode();
+		return std::string( "error ") + err.what() + "\n";
+	}
+}
+
+#if defined(TEXTWOLF_WITH_ZLIB)
+/// \brief Compress data
+/// \param [in] windowBits 15 + 16 for gzip format, 15 for zlib format
+static std::string compress( const std::string& data, int windowBits)
+{
+	z_stream zs;
+	std::memset( &zs, 0, sizeof(zs));
+	if (::deflateInit2( &zs, Z_BEST_COMPRESSION, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) throw std::runtime_error( "deflateInit2 failed");
+	std::string rt;
+	char buf[ 256];
+	zs.next_in = (Bytef*)const_cast<char*>( data.c_str());
+	zs.avail_in = (uInt)data.size();
+	int rc = Z_OK;
+	while (rc != Z_STREAM_END)
+	{
+		zs.next_out = (Bytef*)buf;
+		zs.avail_out = sizeof(buf);
+		rc = ::deflate( &zs, Z_FINISH);
+		if (rc != Z_OK && rc != Z_STREAM_END && rc != Z_BUF_ERROR) throw std::runtime_error( "deflate failed");
+		rt.append( buf, sizeof(buf) - zs.avail_out);
+	}
+	::deflateEnd( &zs);
+	return rt;
+}
+#endif
+
+template <class InputCharSet, class OutputCharSet>
+static unsigned int test( const char* what)
+{
+	unsigned int errors = 0;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		std::string doc = encode<InputCharSet>( testDocuments[ di]);
+		std::string expected = scan<CStringIterator,InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size()));
+		std::string inputs[ 4];
+		const char* modes[ 4] = {"uncompressed", "gzip", "zlib", "gzip members"};
+		unsigned int nofInputs = 1;
+		inputs[ 0] = doc;
+#if defined(TEXTWOLF_WITH_ZLIB)
+		inputs[ nofInputs++] = compress( doc, 15 + 16);
+		inputs[ nofInputs++] = compress( doc, 15);
+		inputs[ nofInputs++] = compress( doc.substr( 0, doc.size() / 2), 15 + 16) + compress( doc.substr( doc.size() / 2), 15 + 16);
+#endif
+		for (unsigned int ii=0; ii<nofInputs; ++ii)
+		{
+			for (unsigned int bi=0; bufferSizes[ bi]; ++bi)
+			{
+				for (unsigned int ni=0; inputBufferSizes[ ni]; ++ni)
+				{
+					int errorcode;
+					std::string result = scanInflated<InputCharSet,OutputCharSet>( inputs[ ii], bufferSizes[ bi], inputBufferSizes[ ni], errorcode);
+					if (result == expected) continue;
+					std::cerr << what << " " << modes[ ii] << " with buffer size " << bufferSizes[ bi] << " and input buffer size " << inputBufferSizes[ ni] << " differs:" << std::endl
+						<< result << "expected:" << std::endl << expected;
+					++errors;
+				}
+			}
+		}
+	}
+	return errors;
+}
+
+static unsigned int checkError( const char* what, const std::string& input, int expectedError)
+{
+	int errorcode;
+	std::string result = scanInflated<charset::UTF8,charset::UTF8>( input, 64, 16, errorcode);
+	if (errorcode == expectedError) return 0;
+	std::cerr << what << " returns error code " << errorcode << " instead of " << expectedError << ":" << std::endl << result;
+	return 1;
+}
+
+/// \brief Check the document compressed with the gzip program and the errors for corrupt and truncated input
+static unsigned int testGzipDocument()
+{
+	unsigned int errors = 0;
+	std::string input( gzipDocument, gzipDocumentSize);
+	std::string content( gzipDocumentContent);
+#if defined(TEXTWOLF_WITH_ZLIB)
+	int errorcode;
+	std::string expected = scan<CStringIterator,charset::UTF8,charset::UTF8>( CStringIterator( content.c_str(), content.size()));
+	std::string result = scanInflated<charset::UTF8,charset::UTF8>( input, 8192, 65536, errorcode);
+	if (result != expected)
+	{
+		std::cerr << "document compressed with gzip differs:" << std::endl << result << "expected:" << std::endl << expected;
+		++errors;
+	}
+	std::string corrupt( input);
+	corrupt[ 20] ^= 0x55;
+	errors += checkError( "corrupt compressed data", corrupt, EILSEQ);
+	errors += checkError( "truncated compressed data", input.substr( 0, input.size() - 12), EILSEQ);
+	errors += checkError( "compressed data followed by garbage", input + "garbage", EILSEQ);
+#else
+	errors += checkError( "compressed data without zlib", input, ENOSYS);
+#endif
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += testGzipDocument();
+	errors += test<charset::UTF8,charset::UTF8>( "UTF-8>UTF-8");
+	errors += test<charset::UTF8,charset::UTF16LE>( "UTF-8>UTF-16LE");
+	errors += test<charset::UTF16LE,charset::UTF8>( "UTF-16LE>UTF-8");
+	errors += test<charset::UTF16BE,charset::UTF8>( "UTF-16BE>UTF-8");
+	errors += test<charset::UCS4BE,charset::UTF8>( "UCS-4BE>UTF-8");
+	errors += test<charset::IsoLatin,charset::UTF8>( "ISO-8859-1>UTF-8");
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,217 @@
+#include "textwolf.hpp"
+#include "textwolf/istreamiterator.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+
+//build gcc
+//compile: g++ -c -o test_IStreamIterator.o -g -I../include/ -pedantic -Wall -O4 test_IStreamIterator.cpp
+//link: g++ -lc -o test_IStreamIterator test_IStreamIterator.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_IStreamIterator.obj" test_IStreamIterator.cpp
+//link: link.exe /out:.\test_IStreamIterator test_IStreamIterator.obj
+
+// Checks the IStreamIterator reading the next block when reaching the end of the data read, with buffers smaller than a character:
+// The bytes and positions iterated, incrementing the iterator over bytes without reading them as the scanner does when skipping a character,
+// and that the XMLScanner returns the same elements on an IStreamIterator as on a CStringIterator for all character set encodings.
+// Checks that a copy of an iterator reading the next block does not change the data of the block the original iterator is reading, and the iterator constructed empty.
+
+using namespace textwolf;
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml version='1.0'?>\n<!-- comment -->\r\n<doc a='x&amp;y' b=\"\xC3\xA4\xE2\x82\xAC\">text \xC3\xA4\r\nline&#x20AC;&lt;<![CDATA[<raw>]]><e/>\xF0\x90\x80\x80 tail</doc>",
+	"<doc><item id='1'>first</item><item id='2'>second\r\rthird</item><empty/></doc>",
+	"<doc a=\"\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\">&#65;&quot;&unknown;</doc>",
+	"<doc a=>error</doc>",
+	"<doc>incomplete \xE2\x82",
+	0
+};
+
+static const std::size_t bufferSizes[] = {1,2,3,5,7,64,8192,0};
+
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static std::string scan( const Iterator& itr, bool zeroCopy)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Scanner scanner( itr);
+	scanner.setZeroCopy( zeroCopy);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		std::string item( scanner.getItemPtr(), scanner.getItemSize());
+		if (scanner.getItem() != item || std::string( scanner.getItemPtr(), scanner.getItemSize()) != item)
+		{
+			// ... getItem() has to copy an item returned as span in zero copy mode
+			rt.append( "getItem() differs ");
+		}
+		rt.append( item);
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Encode a UTF-8 document in the character set encoding of the input
+template <class CharSet>
+static std::string encode( const char* doc)
+{
+	CharSet charset;
+	std::string rt;
+	TextScanner<CStringIterator,charset::UTF8> ts( (CStringIterator( doc)));
+	for (; *ts; ++ts) charset.print( *ts, rt);
+	return rt;
+}
+
+/// \brief Iterate on the bytes of a document, reading only every 'step'th byte
+static unsigned int testBytes( const std::string& doc, std::size_t bufsize, std::size_t step)
+{
+	std::istringstream input( doc);
+	StdInputStream stream( input);
+	IStreamIterator itr( &stream, bufsize);
+	std::size_t pos = 0;
+	for (; pos < doc.size(); pos += step)
+	{
+		if (itr.position() != pos || *itr != doc[ pos])
+		{
+			std::cerr << "iterating with buffer size " << bufsize << " and step " << step << " differs at byte " << pos << std::endl;
+			return 1;
+		}
+		for (std::size_t si=0; si<step; ++si) ++itr;
+	}
+	for (unsigned int ii=0; ii<3; ++ii)
+	{
+		if (*itr != 0)
+		{
+			std::cerr << "iterating with buffer size " << bufsize << " and step " << step << " got no end of data" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/// \brief Read ahead to the end of data with copies of an iterator and check that the original still reads the rest of its block
+static unsigned int testCopies( const std::string& doc, std::size_t bufsize, std::size_t startpos)
+{
+	std::istringstream input( doc);
+	StdInputStream stream( input);
+	IStreamIterator itr( &stream, bufsize);
+	// ... read up to the start position, so that the block of the start position is read before copying
+	std::size_t pos = 0;
+	for (; pos < startpos; ++pos,++itr) *itr;
+	*itr;
+	IStreamIterator assigned;
+	assigned = itr;
+	IStreamIterator copied( itr);
+	for (pos = startpos; pos < doc.size(); ++pos,++assigned)
+	{
+		if (*assigned != doc[ pos])
+		{
+			std::cerr << "copy of iterator with buffer size " << bufsize << " from byte " << startpos << " differs at byte " << pos << std::endl;
+			return 1;
+		}
+	}
+	std::size_t blockend = (startpos / bufsize + 1) * bufsize;
+	for (pos = startpos; pos < doc.size() && pos < blockend; ++pos,++itr,++copied)
+	{
+		if (*itr != doc[ pos] || *copied != doc[ pos])
+		{
+			std::cerr << "iterator with buffer size " << bufsize << " copied at byte " << startpos << " differs at byte " << pos << " after reading ahead with the copy" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/// \brief Check the iterator constructed empty, copies and assignments of it
+static unsigned int testEmpty( const std::string& doc)
+{
+	IStreamIterator empty;
+	IStreamIterator copied( empty);
+	++copied;
+	if (*empty != 0 || *copied != 0 || copied.position() != 0)
+	{
+		std::cerr << "iterator constructed empty returns data" << std::endl;
+		return 1;
+	}
+	std::istringstream input( doc);
+	StdInputStream stream( input);
+	IStreamIterator itr( &stream, 16);
+	copied = itr;
+	itr = empty;
+	itr = copied;
+	for (std::size_t pos=0; pos < doc.size(); ++pos,++itr)
+	{
+		if (*itr != doc[ pos])
+		{
+			std::cerr << "iterator assigned differs at byte " << pos << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+template <class InputCharSet, class OutputCharSet>
+static unsigned int test( const char* what)
+{
+	unsigned int errors = 0;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		std::string doc = encode<InputCharSet>( testDocuments[ di]);
+		for (unsigned int zi=0; zi<2; ++zi)
+		{
+			bool zeroCopy = (zi == 1);
+			std::string expected = scan<CStringIterator,InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size()), zeroCopy);
+			for (unsigned int bi=0; bufferSizes[ bi]; ++bi)
+			{
+				std::istringstream input( doc);
+				StdInputStream stream( input);
+				std::string result = scan<IStreamIterator,InputCharSet,OutputCharSet>( IStreamIterator( &stream, bufferSizes[ bi]), zeroCopy);
+				if (result == expected) continue;
+				std::cerr << what << " with buffer size " << bufferSizes[ bi] << (zeroCopy ? " in zero copy mode" : "") << " differs:" << std::endl
+					<< result << "expected:" << std::endl << expected;
+				++errors;
+			}
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	std::string doc = encode<charset::UCS4LE>( testDocuments[ 0]);
+	for (unsigned int bi=0; bufferSizes[ bi]; ++bi)
+	{
+		for (std::size_t step=1; step<=4; ++step)
+		{
+			errors += testBytes( doc, bufferSizes[ bi], step);
+		}
+	}
+	for (unsigned int bi=0; bufferSizes[ bi]; ++bi)
+	{
+		for (std::size_t startpos=0; startpos < doc.size(); ++startpos)
+		{
+			errors += testCopies( doc, bufferSizes[ bi], startpos);
+		}
+	}
+	errors += testEmpty( doc);
+	errors += test<charset::UTF8,charset::UTF8>( "UTF-8>UTF-8");
+	errors += test<charset::UTF8,charset::UTF16LE>( "UTF-8>UTF-16LE");
+	errors += test<charset::UTF16LE,charset::UTF16LE>( "UTF-16LE>UTF-16LE");
+	errors += test<charset::UTF16BE,charset::UTF8>( "UTF-16BE>UTF-8");
+	errors += test<charset::UCS2LE,charset::UTF8>( "UCS-2LE>UTF-8");
+	errors += test<charset::UCS4BE,charset::UTF8>( "UCS-4BE>UTF-8");
+	errors += test<charset::IsoLatin,charset::UTF8>( "ISO-8859-1>UTF-8");
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,73 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+
+//build gcc
+//compile: g++ -c -o test_IsoLatinCodePages.o -g -I../include/ -pedantic -Wall -O4 test_IsoLatinCodePages.cpp
+//link: g++ -lc -o test_IsoLatinCodePages test_IsoLatinCodePages.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_IsoLatinCodePages.obj" test_IsoLatinCodePages.cpp
+//link: link.exe /out:.\test_IsoLatinCodePages test_IsoLatinCodePages.obj
+
+// Checks that every character of the IsoLatin code pages is printed as the byte it is read from,
+// also the characters beyond 0xFF, and that characters not in a code page are printed as character references.
+
+using namespace textwolf;
+
+struct PrintTest
+{
+	unsigned int codepage;
+	UChar chr;
+	const char* output;
+};
+
+static const PrintTest printTests[] =
+{
+	{1, 0xE4, "\xE4"},
+	{2, 0x141, "\xA3"},		// L with stroke
+	{2, 0x2DD, "\xBD"},		// double acute accent
+	{9, 0x20AC, "\xA4"},		// euro sign
+	{9, 0x152, "\xBC"},		// ligature OE
+	{9, 0xA4, "&#xa4;"},		// currency sign, replaced by the euro sign
+	{1, 0x20AC, "&#x20ac;"},
+	{2, 0x10000, "&#x10000;"},
+	{0, 0, 0}
+};
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	for (unsigned int cp=1; cp<=9; ++cp)
+	{
+		charset::IsoLatin charset( cp);
+		for (unsigned int ch=0; ch<256; ++ch)
+		{
+			UChar uc = charset.ucharcode( (char)(unsigned char)ch);
+			if (uc == 0 && ch != 0) continue;
+			unsigned char inv = (unsigned char)charset.invcode( uc);
+			if (inv != ch)
+			{
+				std::cerr << "code page " << cp << ": character " << uc << " of byte " << ch << " maps back to " << (unsigned int)inv << std::endl;
+				++errors;
+			}
+		}
+	}
+	for (unsigned int ti=0; printTests[ ti].output; ++ti)
+	{
+		charset::IsoLatin charset( printTests[ ti].codepage);
+		std::string out;
+		charset.print( printTests[ ti].chr, out);
+		if (out != printTests[ ti].output)
+		{
+			std::cerr << "code page " << printTests[ ti].codepage << ": character " << printTests[ ti].chr << " printed as '" << out << "' instead of '" << printTests[ ti].output << "'" << std::endl;
+			++errors;
+		}
+	}
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,167 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+
+//build gcc
+//compile: g++ -c -o test_LookaheadTextScanner.o -g -I../include/ -pedantic -Wall -O4 test_LookaheadTextScanner.cpp
+//link: g++ -lc -o test_LookaheadTextScanner test_LookaheadTextScanner.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_LookaheadTextScanner.obj" test_LookaheadTextScanner.cpp
+//link: link.exe /out:.\test_LookaheadTextScanner test_LookaheadTextScanner.obj
+
+// Checks that the XMLScanner with the LookaheadTextScanner as input reader returns the same elements as with the TextScanner
+// for all character set encodings, for a null terminated source, a source of known size and the push mode with small chunks.
+// The small lookahead size checks the decoding ahead across the boundaries of the characters decoded.
+
+using namespace textwolf;
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml version='1.0'?>\n<!-- comment -->\r\n<doc a='x&amp;y' b=\"\xC3\xA4\xE2\x82\xAC\">text \xC3\xA4\r\nline&#x20AC;&lt;<![CDATA[<raw>]]><e/>\xF0\x90\x80\x80 tail</doc>",
+	"<doc><item id='1'>first</item><item id='2'>second\r\rthird</item><empty/></doc>",
+	"<doc a=\"\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\">&#65;&quot;&unknown;</doc>",
+	"<doc a=>error</doc>",
+	0
+};
+
+template <class InputReader, class InputCharSet, class OutputCharSet, class Iterator>
+static std::string scan( const Iterator& itr, bool zeroCopy)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string,XMLScannerNoInstrumentation,InputReader> Scanner;
+	Scanner scanner( itr);
+	scanner.setZeroCopy( zeroCopy);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+template <class InputReader, class InputCharSet, class OutputCharSet>
+static std::string scanPushed( const std::string& doc, std::size_t chunksize)
+{
+	typedef XMLScanner<SrcIterator,InputCharSet,OutputCharSet,std::string,XMLScannerNoInstrumentation,InputReader> Scanner;
+	Scanner scanner;
+	std::string rt;
+	std::size_t pos = 0;
+	scanner.putInput( doc.c_str(), chunksize < doc.size() ? chunksize : doc.size(), chunksize >= doc.size());
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		if (type == XMLScannerBase::NeedMoreInput)
+		{
+			pos += chunksize;
+			std::size_t size = (doc.size() - pos > chunksize) ? chunksize : (doc.size() - pos);
+			scanner.putInput( doc.c_str() + pos, size, pos + size == doc.size());
+			continue;
+		}
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Encode a UTF-8 document in the character set encoding of the input
+template <class CharSet>
+static std::string encode( const char* doc)
+{
+	CharSet charset;
+	std::string rt;
+	TextScanner<CStringIterator,charset::UTF8> ts( (CStringIterator( doc)));
+	for (; *ts; ++ts) charset.print( *ts, rt);
+	return rt;
+}
+
+template <class InputCharSet, class OutputCharSet, class Readers>
+static unsigned int compare( const char* what, const std::string& doc, const Readers&)
+{
+	typedef TextScanner<char*,InputCharSet> CharReader;
+	typedef TextScanner<CStringIterator,InputCharSet> CStringReader;
+	typedef TextScanner<SrcIterator,InputCharSet> SrcReader;
+	typedef typename Readers::template Reader<char*>::Type LookaheadCharReader;
+	typedef typename Readers::template Reader<CStringIterator>::Type LookaheadCStringReader;
+	typedef typename Readers::template Reader<SrcIterator>::Type LookaheadSrcReader;
+
+	// ... terminating 0 for the null terminated source
+	std::string zdoc( doc);
+	zdoc.append( 4, '\0');
+	char* src = const_cast<char*>( zdoc.c_str());
+	unsigned int errors = 0;
+	for (unsigned int zi=0; zi<2; ++zi)
+	{
+		bool zeroCopy = (zi == 1);
+		std::string expected = scan<CharReader,InputCharSet,OutputCharSet>( src, zeroCopy);
+		std::string result[ 4];
+		result[ 0] = scan<LookaheadCharReader,InputCharSet,OutputCharSet>( src, zeroCopy);
+		std::string expectedSized = scan<CStringReader,InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size()), zeroCopy);
+		result[ 1] = scan<LookaheadCStringReader,InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size()), zeroCopy);
+		std::string expectedPushed = scanPushed<SrcReader,InputCharSet,OutputCharSet>( doc, 7);
+		result[ 2] = scanPushed<LookaheadSrcReader,InputCharSet,OutputCharSet>( doc, 7);
+		result[ 3] = scanPushed<LookaheadSrcReader,InputCharSet,OutputCharSet>( doc, 64);
+		const std::string* expectedar[ 4] = {&expected, &expectedSized, &expectedPushed, &expectedPushed};
+		const char* modear[ 4] = {"null terminated", "known size", "pushed in chunks of 7 bytes", "pushed in chunks of 64 bytes"};
+		for (unsigned int ri=0; ri<4; ++ri)
+		{
+			if (result[ ri] == *expectedar[ ri]) continue;
+			std::cerr << what << " " << modear[ ri] << (zeroCopy ? " in zero copy mode" : "") << " differs:" << std::endl
+				<< result[ ri] << "expected:" << std::endl << *expectedar[ ri];
+			++errors;
+		}
+	}
+	return errors;
+}
+
+/// \brief Selects the LookaheadTextScanner type with a lookahead size for an iterator type
+template <class CharSet, unsigned int LookaheadSize>
+struct LookaheadReaders
+{
+	template <class Iterator>
+	struct Reader
+	{
+		typedef LookaheadTextScanner<Iterator,CharSet,LookaheadSize> Type;
+	};
+};
+
+template <class InputCharSet, class OutputCharSet>
+static unsigned int test( const char* what)
+{
+	unsigned int errors = 0;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		std::string doc = encode<InputCharSet>( testDocuments[ di]);
+		errors += compare<InputCharSet,OutputCharSet>( what, doc, LookaheadReaders<InputCharSet,64>());
+		errors += compare<InputCharSet,OutputCharSet>( what, doc, LookaheadReaders<InputCharSet,3>());
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += test<charset::UTF8,charset::UTF8>( "UTF-8>UTF-8");
+	errors += test<charset::UTF8,charset::UTF16LE>( "UTF-8>UTF-16LE");
+	errors += test<charset::UTF16LE,charset::UTF16LE>( "UTF-16LE>UTF-16LE");
+	errors += test<charset::UTF16BE,charset::UTF8>( "UTF-16BE>UTF-8");
+	errors += test<charset::UCS2BE,charset::UTF8>( "UCS-2BE>UTF-8");
+	errors += test<charset::UCS4LE,charset::UCS4LE>( "UCS-4LE>UCS-4LE");
+	errors += test<charset::UCS4BE,charset::UTF8>( "UCS-4BE>UTF-8");
+	errors += test<charset::IsoLatin,charset::IsoLatin>( "ISO-8859-1>ISO-8859-1");
+	errors += test<charset::IsoLatin,charset::UTF8>( "ISO-8859-1>UTF-8");
+	errors += test<charset::Windows125x,charset::UTF8>( "Windows-1252>UTF-8");
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
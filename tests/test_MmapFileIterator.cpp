@@ -0,0 +1,174 @@
+#include "textwolf.hpp"
+#include "textwolf/mmapfileiterator.hpp"
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <cstdio>
+
+//build gcc
+//compile: g++ -c -o test_MmapFileIterator.o -g -I../include/ -pedantic -Wall -O4 test_MmapFileIterator.cpp
+//link: g++ -lc -o test_MmapFileIterator test_MmapFileIterator.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_MmapFileIterator.obj" test_MmapFileIterator.cpp
+//link: link.exe /out:.\test_MmapFileIterator test_MmapFileIterator.obj
+
+// Checks that the XMLScanner on a MmapFileIterator returns the same elements as on a CStringIterator for all character set encodings,
+// also for files filling the last page of the memory mapped completely, so that the padding is not part of the pages of the file.
+// Checks the absolute positions iterated, the padding of an empty file and the error for a file that does not exist.
+
+using namespace textwolf;
+
+static const char* testFile = "test_MmapFileIterator.tmp";
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml version='1.0'?>\n<!-- comment -->\r\n<doc a='x&amp;y' b=\"\xC3\xA4\xE2\x82\xAC\">text \xC3\xA4\r\nline&#x20AC;&lt;<![CDATA[<raw>]]><e/>\xF0\x90\x80\x80 tail</doc>",
+	"<doc><item id='1'>first</item><item id='2'>second\r\rthird</item><empty/></doc>",
+	"<doc a=\"\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\">&#65;&quot;&unknown;</doc>",
+	"<doc a=>error</doc>",
+	"<doc>incomplete \xE2\x82",
+	0
+};
+
+// Sizes of the files written: the size of the document and multiples of usual page sizes
+static const std::size_t fileSizes[] = {0,4096,8192,65536,(std::size_t)-1};
+
+static void writeFile( const std::string& content)
+{
+	std::ofstream out( testFile, std::ios::out | std::ios::binary | std::ios::trunc);
+	out.write( content.c_str(), content.size());
+}
+
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static std::string scan( const Iterator& itr, bool zeroCopy)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Scanner scanner( itr);
+	scanner.setZeroCopy( zeroCopy);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Encode a UTF-8 document in the character set encoding of the input
+template <class CharSet>
+static std::string encode( const char* doc)
+{
+	CharSet charset;
+	std::string rt;
+	TextScanner<CStringIterator,charset::UTF8> ts( (CStringIterator( doc)));
+	for (; *ts; ++ts) charset.print( *ts, rt);
+	return rt;
+}
+
+/// \brief Iterate on the bytes of a file mapped, checking the absolute position and the padding at the end
+static unsigned int testBytes( const std::string& doc)
+{
+	writeFile( doc);
+	MmapFile file( testFile);
+	if (file.size() != doc.size())
+	{
+		std::cerr << "size of file mapped " << file.size() << " differs from " << doc.size() << std::endl;
+		return 1;
+	}
+	MmapFileIterator itr( file);
+	std::size_t pos = 0;
+	for (; pos < doc.size(); ++pos,++itr)
+	{
+		if (itr.position() != pos || *itr != doc[ pos])
+		{
+			std::cerr << "iterating on file mapped of size " << doc.size() << " differs at byte " << pos << std::endl;
+			return 1;
+		}
+	}
+	for (unsigned int ii=0; ii<MmapFile::PaddingSize; ++ii,++itr)
+	{
+		if (*itr != 0)
+		{
+			std::cerr << "file mapped of size " << doc.size() << " has no padding" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+template <class InputCharSet, class OutputCharSet>
+static unsigned int test( const char* what)
+{
+	unsigned int errors = 0;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		for (unsigned int si=0; fileSizes[ si] != (std::size_t)-1; ++si)
+		{
+			std::string doc = encode<InputCharSet>( testDocuments[ di]);
+			if (fileSizes[ si])
+			{
+				// ... fill the file with spaces before the document
+				std::string space = encode<InputCharSet>( " ");
+				if (doc.size() + space.size() > fileSizes[ si] || (fileSizes[ si] - doc.size()) % space.size() != 0) continue;
+				std::string filler;
+				while (filler.size() + doc.size() < fileSizes[ si]) filler.append( space);
+				doc.insert( 0, filler);
+			}
+			writeFile( doc);
+			MmapFile file( testFile);
+			for (unsigned int zi=0; zi<2; ++zi)
+			{
+				bool zeroCopy = (zi == 1);
+				std::string expected = scan<CStringIterator,InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size()), zeroCopy);
+				std::string result = scan<MmapFileIterator,InputCharSet,OutputCharSet>( MmapFileIterator( file), zeroCopy);
+				if (result == expected) continue;
+				std::cerr << what << " for file of size " << doc.size() << (zeroCopy ? " in zero copy mode" : "") << " differs:" << std::endl
+					<< result << "expected:" << std::endl << expected;
+				++errors;
+			}
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += testBytes( encode<charset::UTF8>( testDocuments[ 0]));
+	errors += testBytes( std::string( 4096, 'x'));
+	errors += testBytes( std::string());
+	errors += test<charset::UTF8,charset::UTF8>( "UTF-8>UTF-8");
+	errors += test<charset::UTF8,charset::UTF16LE>( "UTF-8>UTF-16LE");
+	errors += test<charset::UTF16LE,charset::UTF16LE>( "UTF-16LE>UTF-16LE");
+	errors += test<charset::UTF16BE,charset::UTF8>( "UTF-16BE>UTF-8");
+	errors += test<charset::UCS2LE,charset::UTF8>( "UCS-2LE>UTF-8");
+	errors += test<charset::UCS4BE,charset::UTF8>( "UCS-4BE>UTF-8");
+	errors += test<charset::IsoLatin,charset::UTF8>( "ISO-8859-1>UTF-8");
+	std::remove( testFile);
+	try
+	{
+		MmapFile file( testFile);
+		std::cerr << "no error mapping a file that does not exist" << std::endl;
+		++errors;
+	}
+	catch (const exception& err)
+	{
+		if (err.cause != throws_exception::FileReadError)
+		{
+			std::cerr << "unexpected error mapping a file that does not exist: " << err.what() << std::endl;
+			++errors;
+		}
+	}
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,123 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+//build gcc
+//compile: g++ -c -o test_PaddedBufferIterator.o -g -I../include/ -pedantic -Wall -O4 test_PaddedBufferIterator.cpp
+//link: g++ -lc -o test_PaddedBufferIterator test_PaddedBufferIterator.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_PaddedBufferIterator.obj" test_PaddedBufferIterator.cpp
+//link: link.exe /out:.\test_PaddedBufferIterator test_PaddedBufferIterator.obj
+
+// Checks that the XMLScanner on a PaddedBufferIterator returns the same elements as on a CStringIterator for all character
+// set encodings, also for documents ending with an incomplete character, and that the iterator never leaves the padding,
+// also not when the scanner is called again after the end of input.
+
+using namespace textwolf;
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml version='1.0'?>\n<!-- comment -->\r\n<doc a='x&amp;y' b=\"\xC3\xA4\xE2\x82\xAC\">text \xC3\xA4\r\nline&#x20AC;&lt;<![CDATA[<raw>]]><e/>\xF0\x90\x80\x80 tail</doc>",
+	"<doc><item id='1'>first</item><item id='2'>second\r\rthird</item><empty/></doc>",
+	"<doc a=>error</doc>",
+	"<doc>text without end",
+	0
+};
+
+// Incomplete characters appended to the encoded documents
+struct Tail
+{
+	const char* bytes;
+	unsigned int size;
+};
+
+static const Tail testTails[] =
+{
+	{"", 0},
+	{"\xC3", 1},
+	{"\xF0\x90", 2},
+	{"\xFC", 1},			// lead of a 6 byte sequence
+	{"\xFF", 1},
+	{"\xD8", 1},
+	{"\x00\xD8", 2},		// high surrogate in UTF-16LE
+	{"\xD8\x00\x00", 3},
+	{0, 0}
+};
+
+template <class CharSet, class Iterator>
+static std::string scan( const Iterator& itr, std::size_t maxpos)
+{
+	typedef XMLScanner<Iterator,CharSet,charset::UTF8,std::string> Scanner;
+	Scanner scanner( itr);
+	std::string rt;
+	for (unsigned int exitcnt=0; exitcnt<4;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (scanner.getPosition() > maxpos)
+		{
+			rt.append( "position beyond the padding\n");
+			return rt;
+		}
+		if (type == XMLScannerBase::ErrorOccurred) return rt;
+		// ... call the scanner again after the end of input
+		if (type == XMLScannerBase::Exit) ++exitcnt;
+	}
+	return rt;
+}
+
+template <class CharSet>
+static unsigned int test( const char* what)
+{
+	unsigned int errors = 0;
+	CharSet charset;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		for (unsigned int ti=0; testTails[ ti].bytes; ++ti)
+		{
+			std::string doc;
+			TextScanner<CStringIterator,charset::UTF8> ts( (CStringIterator( testDocuments[ di])));
+			for (; *ts; ++ts) charset.print( *ts, doc);
+			doc.append( testTails[ ti].bytes, testTails[ ti].size);
+
+			std::string expected = scan<CharSet>( CStringIterator( doc.c_str(), doc.size()), (std::size_t)-1);
+			std::string buf( doc);
+			PaddedBufferIterator::appendPadding( buf);
+			// ... copy to a block of exactly the size of the padded input, so that a memory checker finds reads beyond
+			char* padded = new char[ buf.size()];
+			std::memcpy( padded, buf.c_str(), buf.size());
+			std::string result = scan<CharSet>( PaddedBufferIterator( padded, doc.size()), doc.size() + PaddedBufferIterator::PaddingSize);
+			delete [] padded;
+			if (result != expected)
+			{
+				std::cerr << what << " document " << di << " with tail " << ti << " differs:" << std::endl << result << "expected:" << std::endl << expected;
+				++errors;
+			}
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += test<charset::UTF8>( "UTF-8");
+	errors += test<charset::UTF16LE>( "UTF-16LE");
+	errors += test<charset::UTF16BE>( "UTF-16BE");
+	errors += test<charset::UCS2LE>( "UCS-2LE");
+	errors += test<charset::UCS4BE>( "UCS-4BE");
+	errors += test<charset::IsoLatin>( "ISO-8859-1");
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,200 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <setjmp.h>
+#ifdef _WIN32
+#pragma warning (disable:4611)
+#endif
+
+//build gcc
+//compile: g++ -c -o test_PaddedSrcIterator.o -g -I../include/ -pedantic -Wall -O4 test_PaddedSrcIterator.cpp
+//link: g++ -lc -o test_PaddedSrcIterator test_PaddedSrcIterator.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_PaddedSrcIterator.obj" test_PaddedSrcIterator.cpp
+//link: link.exe /out:.\test_PaddedSrcIterator test_PaddedSrcIterator.obj
+
+// Checks that the XMLScanner on a PaddedSrcIterator fed chunk by chunk returns the same elements as on a SrcIterator,
+// in push mode and in the mode jumping out with longjmp at the end of a chunk, for all character set encodings and chunk sizes.
+// Every chunk is copied to a buffer of exactly its size plus the padding required, so that reading beyond the padding is detected by memory checkers.
+
+using namespace textwolf;
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml version='1.0'?>\n<!-- comment -->\r\n<doc a='x&amp;y' b=\"\xC3\xA4\xE2\x82\xAC\">text \xC3\xA4\r\nline&#x20AC;&lt;<![CDATA[<raw>]]><e/>\xF0\x90\x80\x80 tail</doc>",
+	"<doc><item id='1'>first</item><item id='2'>second\r\rthird</item><empty/></doc>",
+	"<doc a=\"\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\">&#65;&quot;&unknown;</doc>",
+	"<doc a=>error</doc>",
+	"<doc>incomplete \xE2\x82",
+	0
+};
+
+static const std::size_t chunkSizes[] = {1,2,3,5,7,64,0};
+
+/// \brief Chunks of a document, each in a buffer of exactly its size plus the padding required by the source iterator
+class Chunks
+{
+public:
+	Chunks( const std::string& doc, std::size_t chunksize, std::size_t paddingsize)
+	{
+		std::size_t pos = 0;
+		do
+		{
+			std::size_t size = (doc.size() - pos > chunksize) ? chunksize : (doc.size() - pos);
+			char* chunk = new char[ size + paddingsize];
+			std::memcpy( chunk, doc.c_str() + pos, size);
+			std::memset( chunk + size, 0, paddingsize);
+			m_ar.push_back( chunk);
+			m_sizear.push_back( size);
+			pos += size;
+		}
+		while (pos < doc.size());
+	}
+	~Chunks()
+	{
+		for (std::size_t ii=0; ii<m_ar.size(); ++ii) delete [] m_ar[ ii];
+	}
+	std::size_t size() const			{return m_ar.size();}
+	const char* chunk( std::size_t idx) const	{return m_ar[ idx];}
+	std::size_t chunksize( std::size_t idx) const	{return m_sizear[ idx];}
+
+private:
+	std::vector<char*> m_ar;
+	std::vector<std::size_t> m_sizear;
+};
+
+static void appendItem( std::string& rt, XMLScannerBase::ElementType type, const char* ptr, std::size_t size)
+{
+	rt.append( XMLScannerBase::getElementTypeName( type));
+	rt.append( " ");
+	rt.append( ptr, size);
+	rt.append( "\n");
+}
+
+/// \brief Scan a chunk until the iterator jumps out at the end of the chunk
+/// \return true, if the scanner returned Exit or ErrorOccurred
+template <class Iterator, class Scanner>
+static bool scanChunk( Scanner& scanner, const char* chunk, std::size_t chunksize, bool last, std::string& rt)
+{
+	jmp_buf eom;
+	scanner.setSource( Iterator( chunk, chunksize, last?0:&eom));
+	if (setjmp( eom) != 0)
+	{
+		rt.append( "EOM\n");
+		return false;
+	}
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		appendItem( rt, type, scanner.getItemPtr(), scanner.getItemSize());
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return true;
+	}
+}
+
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static std::string scanJumping( const std::string& doc, std::size_t chunksize)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Chunks chunks( doc, chunksize, traits::ChunkSource<Iterator>::PaddingSize);
+	Scanner scanner;
+	std::string rt;
+	for (std::size_t ci=0; ci<chunks.size(); ++ci)
+	{
+		if (scanChunk<Iterator>( scanner, chunks.chunk( ci), chunks.chunksize( ci), ci+1 == chunks.size(), rt)) break;
+	}
+	return rt;
+}
+
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static std::string scanPushed( const std::string& doc, std::size_t chunksize, bool zeroCopy)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Chunks chunks( doc, chunksize, traits::ChunkSource<Iterator>::PaddingSize);
+	Scanner scanner;
+	scanner.setZeroCopy( zeroCopy);
+	std::string rt;
+	std::size_t ci = 0;
+	scanner.putInput( chunks.chunk( ci), chunks.chunksize( ci), ci+1 == chunks.size());
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		if (type == XMLScannerBase::NeedMoreInput)
+		{
+			if (++ci == chunks.size())
+			{
+				rt.append( "input exhausted\n");
+				return rt;
+			}
+			scanner.putInput( chunks.chunk( ci), chunks.chunksize( ci), ci+1 == chunks.size());
+			continue;
+		}
+		appendItem( rt, type, scanner.getItemPtr(), scanner.getItemSize());
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Encode a UTF-8 document in the character set encoding of the input
+template <class CharSet>
+static std::string encode( const char* doc)
+{
+	CharSet charset;
+	std::string rt;
+	TextScanner<CStringIterator,charset::UTF8> ts( (CStringIterator( doc)));
+	for (; *ts; ++ts) charset.print( *ts, rt);
+	return rt;
+}
+
+static unsigned int check( const char* what, const char* mode, std::size_t chunksize, const std::string& result, const std::string& expected)
+{
+	if (result == expected) return 0;
+	std::cerr << what << " " << mode << " in chunks of " << chunksize << " bytes differs:" << std::endl
+		<< result << "expected:" << std::endl << expected;
+	return 1;
+}
+
+template <class InputCharSet, class OutputCharSet>
+static unsigned int test( const char* what)
+{
+	unsigned int errors = 0;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		std::string doc = encode<InputCharSet>( testDocuments[ di]);
+		for (unsigned int si=0; chunkSizes[ si]; ++si)
+		{
+			std::size_t chunksize = chunkSizes[ si];
+			errors += check( what, "jumping out", chunksize,
+					scanJumping<PaddedSrcIterator,InputCharSet,OutputCharSet>( doc, chunksize),
+					scanJumping<SrcIterator,InputCharSet,OutputCharSet>( doc, chunksize));
+			errors += check( what, "pushed", chunksize,
+					scanPushed<PaddedSrcIterator,InputCharSet,OutputCharSet>( doc, chunksize, false),
+					scanPushed<SrcIterator,InputCharSet,OutputCharSet>( doc, chunksize, false));
+			errors += check( what, "pushed in zero copy mode", chunksize,
+					scanPushed<PaddedSrcIterator,InputCharSet,OutputCharSet>( doc, chunksize, true),
+					scanPushed<SrcIterator,InputCharSet,OutputCharSet>( doc, chunksize, true));
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += test<charset::UTF8,charset::UTF8>( "UTF-8>UTF-8");
+	errors += test<charset::UTF8,charset::UTF16LE>( "UTF-8>UTF-16LE");
+	errors += test<charset::UTF16LE,charset::UTF16LE>( "UTF-16LE>UTF-16LE");
+	errors += test<charset::UTF16BE,charset::UTF8>( "UTF-16BE>UTF-8");
+	errors += test<charset::UCS2LE,charset::UTF8>( "UCS-2LE>UTF-8");
+	errors += test<charset::UCS4BE,charset::UTF8>( "UCS-4BE>UTF-8");
+	errors += test<charset::IsoLatin,charset::UTF8>( "ISO-8859-1>UTF-8");
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
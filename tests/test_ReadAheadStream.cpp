@@ -0,0 +1,274 @@
+#include "textwolf.hpp"
+#include "textwolf/readaheadstream.hpp"
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <cstdio>
+#include <fcntl.h>
+#if defined(_WIN32)
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+//build gcc
+//compile: g++ -c -o test_ReadAheadStream.o -g -I../include/ -pedantic -Wall -O4 test_ReadAheadStream.cpp
+//link: g++ -lc -o test_ReadAheadStream test_ReadAheadStream.o -lpthread
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_ReadAheadStream.obj" test_ReadAheadStream.cpp
+//link: link.exe /out:.\test_ReadAheadStream test_ReadAheadStream.obj
+
+// Checks the ReadAheadStream with buffers smaller than a character and rings of one or more buffers, on a source returning the data in pieces of varying size:
+// The bytes and positions iterated with a ReadAheadIterator, that the XMLScanner returns the same elements on a ReadAheadIterator and on an IStreamIterator
+// reading from a ReadAheadStream as on a CStringIterator for all character set encodings, the error of the source passed to the consumer,
+// destroying a stream not read to the end and reading a file through a file descriptor.
+
+using namespace textwolf;
+
+static const char* testFile = "test_ReadAheadStream.tmp";
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml version='1.0'?>\n<!-- comment -->\r\n<doc a='x&amp;y' b=\"\xC3\xA4\xE2\x82\xAC\">text \xC3\xA4\r\nline&#x20AC;&lt;<![CDATA[<raw>]]><e/>\xF0\x90\x80\x80 tail</doc>",
+	"<doc><item id='1'>first</item><item id='2'>second\r\rthird</item><empty/></doc>",
+	"<doc a=\"\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\">&#65;&quot;&unknown;</doc>",
+	"<doc a=>error</doc>",
+	"<doc>incomplete \xE2\x82",
+	0
+};
+
+static const std::size_t bufferSizes[] = {1,2,3,5,7,64,8192,0};
+static const std::size_t nofBuffers[] = {1,2,4,0};
+
+/// \brief Input stream returning the data in pieces of 1 to 5 bytes, failing with an error code after a number of bytes, if specified
+class PieceStream
+	:public IStream
+{
+public:
+	PieceStream( const std::string& data_, std::size_t failpos_=(std::size_t)-1)
+		:m_data(data_),m_pos(0),m_failpos(failpos_),m_piece(0),m_errno(0){}
+
+	virtual std::size_t read( void* buf, std::size_t bufsize)
+	{
+		if (m_pos >= m_failpos)
+		{
+			m_errno = EIO;
+			return 0;
+		}
+		std::size_t size = (m_piece++ % 5) + 1;
+		if (size > bufsize) size = bufsize;
+		if (size > m_data.size() - m_pos) size = m_data.size() - m_pos;
+		if (size > m_failpos - m_pos) size = m_failpos - m_pos;
+		std::memcpy( buf, m_data.c_str() + m_pos, size);
+		m_pos += size;
+		return size;
+	}
+
+	virtual int errorcode() const
+	{
+		return m_errno;
+	}
+
+private:
+	std::string m_data;
+	std::size_t m_pos;
+	std::size_t m_failpos;
+	std::size_t m_piece;
+	int m_errno;
+};
+
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static std::string scan( const Iterator& itr, bool zeroCopy)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Scanner scanner( itr);
+	scanner.setZeroCopy( zeroCopy);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Encode a UTF-8 document in the character set encoding of the input
+template <class CharSet>
+static std::string encode( const char* doc)
+{
+	CharSet charset;
+	std::string rt;
+	TextScanner<CStringIterator,charset::UTF8> ts( (CStringIterator( doc)));
+	for (; *ts; ++ts) charset.print( *ts, rt);
+	return rt;
+}
+
+/// \brief Iterate on the bytes of a document, reading only every 'step'th byte
+static unsigned int testBytes( const std::string& doc, std::size_t bufsize, std::size_t nofbufs, std::size_t step)
+{
+	PieceStream source( doc);
+	ReadAheadStream stream( &source, bufsize, nofbufs);
+	ReadAheadIterator itr( &stream);
+	std::size_t pos = 0;
+	for (; pos < doc.size(); pos += step)
+	{
+		if (itr.position() != pos || *itr != doc[ pos])
+		{
+			std::cerr << "iterating with " << nofbufs << " buffers of size " << bufsize << " and step " << step << " differs at byte " << pos << std::endl;
+			return 1;
+		}
+		for (std::size_t si=0; si<step; ++si) ++itr;
+	}
+	for (unsigned int ii=0; ii<3; ++ii)
+	{
+		if (*itr != 0)
+		{
+			std::cerr << "iterating with " << nofbufs << " buffers of size " << bufsize << " and step " << step << " got no end of data" << std::endl;
+			return 1;
+		}
+	}
+	return 0;
+}
+
+/// \brief Check that an error of the source is thrown by the iterator after the data read before
+static unsigned int testError( const std::string& doc, std::size_t bufsize, std::size_t nofbufs)
+{
+	std::size_t failpos = doc.size() / 2;
+	PieceStream source( doc, failpos);
+	ReadAheadStream stream( &source, bufsize, nofbufs);
+	ReadAheadIterator itr( &stream);
+	std::size_t pos = 0;
+	try
+	{
+		for (; pos <= doc.size(); ++pos,++itr)
+		{
+			if (*itr != doc[ pos]) break;
+		}
+	}
+	catch (const exception& err)
+	{
+		if (err.cause == throws_exception::FileReadError && pos == failpos) return 0;
+	}
+	std::cerr << "error of the source with " << nofbufs << " buffers of size " << bufsize << " not reported at byte " << failpos << " but at " << pos << std::endl;
+	return 1;
+}
+
+template <class InputCharSet, class OutputCharSet>
+static unsigned int test( const char* what)
+{
+	unsigned int errors = 0;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		std::string doc = encode<InputCharSet>( testDocuments[ di]);
+		for (unsigned int zi=0; zi<2; ++zi)
+		{
+			bool zeroCopy = (zi == 1);
+			std::string expected = scan<CStringIterator,InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size()), zeroCopy);
+			for (unsigned int bi=0; bufferSizes[ bi]; ++bi)
+			{
+				for (unsigned int ni=0; nofBuffers[ ni]; ++ni)
+				{
+					PieceStream source( doc);
+					ReadAheadStream stream( &source, bufferSizes[ bi], nofBuffers[ ni]);
+					std::string result = scan<ReadAheadIterator,InputCharSet,OutputCharSet>( ReadAheadIterator( &stream), zeroCopy);
+
+					PieceStream copiedSource( doc);
+					ReadAheadStream copiedStream( &copiedSource, bufferSizes[ bi], nofBuffers[ ni]);
+					std::string copiedResult = scan<IStreamIterator,InputCharSet,OutputCharSet>( IStreamIterator( &copiedStream, 64), zeroCopy);
+
+					if (result == expected && copiedResult == expected) continue;
+					std::cerr << what << " with " << nofBuffers[ ni] << " buffers of size " << bufferSizes[ bi] << (zeroCopy ? " in zero copy mode" : "")
+						<< (result == expected ? " read with an IStreamIterator" : "") << " differs:" << std::endl
+						<< (result == expected ? copiedResult : result) << "expected:" << std::endl << expected;
+					++errors;
+				}
+			}
+		}
+	}
+	return errors;
+}
+
+/// \brief Read a file through a file descriptor with the default buffers
+static unsigned int testFileDescriptor( const std::string& doc)
+{
+	{
+		std::ofstream out( testFile, std::ios::out | std::ios::binary | std::ios::trunc);
+		out.write( doc.c_str(), doc.size());
+	}
+	unsigned int errors = 0;
+#if defined(_WIN32)
+	int fd = ::_open( testFile, _O_RDONLY | _O_BINARY);
+#else
+	int fd = ::open( testFile, O_RDONLY);
+#endif
+	if (fd < 0)
+	{
+		std::cerr << "failed to open file " << testFile << std::endl;
+		return 1;
+	}
+	{
+		FdInputStream source( fd);
+		ReadAheadStream stream( &source);
+		std::string expected = scan<CStringIterator,charset::UTF8,charset::UTF8>( CStringIterator( doc.c_str(), doc.size()), true);
+		std::string result = scan<ReadAheadIterator,charset::UTF8,charset::UTF8>( ReadAheadIterator( &stream), true);
+		if (result != expected)
+		{
+			std::cerr << "reading file through a file descriptor differs:" << std::endl << result << "expected:" << std::endl << expected;
+			++errors;
+		}
+	}
+#if defined(_WIN32)
+	::_close( fd);
+#else
+	::close( fd);
+#endif
+	std::remove( testFile);
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	std::string doc = encode<charset::UCS4LE>( testDocuments[ 0]);
+	for (unsigned int bi=0; bufferSizes[ bi]; ++bi)
+	{
+		for (unsigned int ni=0; nofBuffers[ ni]; ++ni)
+		{
+			for (std::size_t step=1; step<=4; ++step)
+			{
+				errors += testBytes( doc, bufferSizes[ bi], nofBuffers[ ni], step);
+			}
+			errors += testError( doc, bufferSizes[ bi], nofBuffers[ ni]);
+		}
+	}
+	for (unsigned int ni=0; nofBuffers[ ni]; ++ni)
+	{
+		// ... destroy the stream with the reader waiting for a buffer given back
+		PieceStream source( doc);
+		ReadAheadStream stream( &source, 1, nofBuffers[ ni]);
+		ReadAheadIterator itr( &stream);
+		++itr;
+		if (*itr != doc[1]) ++errors;
+	}
+	errors += testFileDescriptor( std::string( testDocuments[ 0]) + std::string( 100000, ' '));
+	errors += test<charset::UTF8,charset::UTF8>( "UTF-8>UTF-8");
+	errors += test<charset::UTF8,charset::UTF16LE>( "UTF-8>UTF-16LE");
+	errors += test<charset::UTF16LE,charset::UTF16LE>( "UTF-16LE>UTF-16LE");
+	errors += test<charset::UTF16BE,charset::UTF8>( "UTF-16BE>UTF-8");
+	errors += test<charset::UCS2LE,charset::UTF8>( "UCS-2LE>UTF-8");
+	errors += test<charset::UCS4BE,charset::UTF8>( "UCS-4BE>UTF-8");
+	errors += test<charset::IsoLatin,charset::UTF8>( "ISO-8859-1>UTF-8");
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
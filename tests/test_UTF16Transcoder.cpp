@@ -0,0 +1,194 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+//build gcc
+//compile: g++ -c -o test_UTF16Transcoder.o -g -I../include/ -pedantic -Wall -O4 test_UTF16Transcoder.cpp
+//link: g++ -lc -o test_UTF16Transcoder test_UTF16Transcoder.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_UTF16Transcoder.obj" test_UTF16Transcoder.cpp
+//link: link.exe /out:.\test_UTF16Transcoder test_UTF16Transcoder.obj
+
+// Checks the conversion of runs of characters between UTF-16 and UTF-8 in bulk in the XMLScanner:
+// Documents with valid and invalid characters embedded at every position of a longer text (vectorized path)
+// have to be scanned from a memory block with the same result as character by character from an iterator
+// that does not iterate on a memory block. Checks also the round trip of the UTF16Transcoder conversions.
+
+using namespace textwolf;
+
+/// \brief Iterator on a null terminated string that is not known to iterate on a memory block (see traits::ContiguousSource)
+class CharIterator
+{
+public:
+	CharIterator() :m_ptr(0){}
+	explicit CharIterator( const char* ptr_) :m_ptr(ptr_){}
+	char operator*() const {return *m_ptr;}
+	CharIterator& operator++() {++m_ptr; return *this;}
+	int operator-( const CharIterator& o) const {return (int)(m_ptr - o.m_ptr);}
+private:
+	const char* m_ptr;
+};
+
+// UTF-8 test strings (invalid ones are converted character by character as before)
+static const char* utf8Strings[] =
+{
+	"ascii only",
+	"\xC3\xA4\xC3\xB6\xC3\xBC",			// 2 byte characters
+	"\xE2\x82\xAC \xEF\xBF\xBF",			// 3 byte characters
+	"\xF0\x90\x80\x80\xF4\x8F\xBF\xBF",		// 4 byte characters (surrogate pairs in UTF-16)
+	"\xDF\xBF\xE0\xA0\x80\xC2\x80",			// limits of the 2 and 3 byte ranges
+	"ab\xC0\xAF",					// overlong '/'
+	"x\xE0\x9F\xBF",				// overlong 3 byte
+	"abc\xED\xA0\x80",				// surrogate U+D800
+	"\xF4\x90\x80\x80",				// beyond U+10FFFF
+	"\xF8\x88\x80\x80\x80",				// 5 byte sequence
+	"\xC3\x41",					// lead followed by ASCII
+	"\xE2\x82 ",					// incomplete
+	"\xC3\xA4\xA4",					// continuation byte too many
+	0
+};
+
+// UTF-16 test strings as sequences of code units terminated by 0 (invalid ones are converted character by character as before)
+static const unsigned short utf16Strings[][8] =
+{
+	{'a','b','c',0},
+	{0xE4,0xF6,0xFC,0},				// 2 byte characters in UTF-8
+	{0x20AC,0x7FF,0x800,0xFFFF,0},			// 3 byte characters in UTF-8
+	{0xD800,0xDC00,0xDBFF,0xDFFF,0},		// surrogate pairs
+	{'x',0xD800,'y',0},				// lone high surrogate
+	{0xDC00,'z',0},					// lone low surrogate
+	{0xDC00,0xDC01,0},				// low surrogate followed by a low surrogate
+	{0xD800,0xD800,0xDC00,0},			// high surrogate followed by a high surrogate
+	{0xD83D,'<',0},					// high surrogate followed by a delimiter
+	{0}
+};
+
+template <class InputCharSet, class OutputCharSet, class Iterator>
+static std::string scan( const Iterator& itr)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Scanner scanner( itr);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Build a document with the text in its content and in an attribute value
+template <class CharSet>
+static std::string document( const std::string& text)
+{
+	CharSet charset;
+	std::string rt;
+	const char* markup[3] = {"<doc a='", "'>", "</doc>"};
+	for (unsigned int mi=0; mi<3; ++mi)
+	{
+		for (const char* cc = markup[ mi]; *cc; ++cc) charset.print( (UChar)(unsigned char)*cc, rt);
+		if (mi < 2) rt.append( text);
+	}
+	// ... terminating 0 for the null terminated sources
+	rt.append( 4, '\0');
+	return rt;
+}
+
+template <class InputCharSet, class OutputCharSet>
+static unsigned int testScan( const char* what, const std::string& text)
+{
+	std::string doc = document<InputCharSet>( text);
+	std::string expected = scan<InputCharSet,OutputCharSet>( CharIterator( doc.c_str()));
+	std::string bulk = scan<InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size() - 4));
+	std::string bulkz = scan<InputCharSet,OutputCharSet>( doc.c_str());
+	if (bulk == expected && bulkz == expected) return 0;
+	std::cerr << "bulk conversion " << what << " differs at text of size " << text.size() << ":" << std::endl
+		<< (bulk == expected ? bulkz : bulk) << "expected:" << std::endl << expected;
+	return 1;
+}
+
+template <int encoding>
+static std::string utf16String( const unsigned short* units)
+{
+	std::string rt;
+	for (; *units; ++units)
+	{
+		char unit[2];
+		unit[ encoding == charset::ByteOrder::LE ? 0 : 1] = (char)(unsigned char)(*units & 0xFF);
+		unit[ encoding == charset::ByteOrder::LE ? 1 : 0] = (char)(unsigned char)(*units >> 8);
+		rt.append( unit, 2);
+	}
+	return rt;
+}
+
+template <int encoding>
+static unsigned int testRoundTrip()
+{
+	typedef UTF16Transcoder<encoding> Transcoder;
+	unsigned int errors = 0;
+	std::string text;
+	for (unsigned int ii=0; ii<40; ++ii) text.append( ii % 5 ? "text " : "\xC3\xA4\xE2\x82\xAC\xF0\x90\x80\x80");
+
+	std::string utf16( 2*text.size(), '\0');
+	std::size_t utf16size;
+	std::size_t consumed = Transcoder::fromUTF8( text.c_str(), text.size(), const_cast<char*>( utf16.c_str()), utf16size);
+	std::string utf8( 3*utf16size/2, '\0');
+	std::size_t utf8size;
+	std::size_t consumed16 = Transcoder::toUTF8( utf16.c_str(), utf16size, const_cast<char*>( utf8.c_str()), utf8size);
+	if (consumed != text.size() || consumed16 != utf16size || utf8.substr( 0, utf8size) != text)
+	{
+		std::cerr << "round trip of UTF-8 to UTF-16 " << (encoding == charset::ByteOrder::LE ? "LE" : "BE") << " and back fails" << std::endl;
+		++errors;
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	for (unsigned int si=0; utf8Strings[ si]; ++si)
+	{
+		// ... embed the string at every position of a text long enough for the vectorized conversion
+		for (std::size_t pi=0; pi<40; ++pi)
+		{
+			std::string text( pi, 'a');
+			text.append( utf8Strings[ si]);
+			for (unsigned int ci=0; ci<4; ++ci) text.append( "xyz\xC3\xA4\xE2\x82\xAC\xF0\x90\x80\x80 and more text");
+			errors += testScan<charset::UTF8,charset::UTF16LE>( "UTF-8>UTF-16LE", text);
+			errors += testScan<charset::UTF8,charset::UTF16BE>( "UTF-8>UTF-16BE", text);
+		}
+	}
+	for (unsigned int si=0; utf16Strings[ si][0]; ++si)
+	{
+		for (std::size_t pi=0; pi<20; ++pi)
+		{
+			std::string le( 2*pi, '\0');
+			std::string be( 2*pi, '\0');
+			for (std::size_t ci=0; ci<pi; ++ci) le[ 2*ci] = be[ 2*ci+1] = 'a';
+			le.append( utf16String<charset::ByteOrder::LE>( utf16Strings[ si]));
+			be.append( utf16String<charset::ByteOrder::BE>( utf16Strings[ si]));
+			const unsigned short tail[] = {'x','y','z',0xE4,0x20AC,0xD800,0xDC00,0};
+			for (unsigned int ci=0; ci<4; ++ci)
+			{
+				le.append( utf16String<charset::ByteOrder::LE>( tail));
+				be.append( utf16String<charset::ByteOrder::BE>( tail));
+			}
+			errors += testScan<charset::UTF16LE,charset::UTF8>( "UTF-16LE>UTF-8", le);
+			errors += testScan<charset::UTF16BE,charset::UTF8>( "UTF-16BE>UTF-8", be);
+		}
+	}
+	errors += testRoundTrip<charset::ByteOrder::LE>();
+	errors += testRoundTrip<charset::ByteOrder::BE>();
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,221 @@
+#include "textwolf.hpp"
+#include "textwolf/istreamiterator.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <cstring>
+
+//build gcc
+//compile: g++ -c -o test_UTF8Validator.o -g -I../include/ -pedantic -Wall -O4 test_UTF8Validator.cpp
+//link: g++ -lc -o test_UTF8Validator test_UTF8Validator.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_UTF8Validator.obj" test_UTF8Validator.cpp
+//link: link.exe /out:.\test_UTF8Validator test_UTF8Validator.obj
+
+// Checks the UTF8Validator with valid and invalid sequences passed as a whole, byte by byte
+// and embedded at every position of a longer ASCII text (vectorized path) and the strict UTF-8
+// mode of the XMLScanner.
+
+using namespace textwolf;
+
+struct TestCase
+{
+	const char* input;
+	int errpos;		//< position of the first invalid sequence or -1 for valid input
+};
+
+static const TestCase testCases[] =
+{
+	{"", -1},
+	{"ascii only", -1},
+	{"\xC3\xA4\xC3\xB6\xC3\xBC", -1},		// 2 byte characters
+	{"\xE2\x82\xAC", -1},				// U+20AC
+	{"\xEF\xBF\xBF", -1},				// U+FFFF
+	{"\xF0\x90\x80\x80", -1},			// U+10000
+	{"\xF4\x8F\xBF\xBF", -1},			// U+10FFFF
+	{"\xED\x9F\xBF", -1},				// U+D7FF
+	{"a\x80", 1},					// continuation byte without lead
+	{"ab\xC0\xAF", 2},				// overlong '/'
+	{"\xC1\xBF", 0},				// overlong 2 byte
+	{"x\xE0\x9F\xBF", 1},				// overlong 3 byte
+	{"\xF0\x8F\xBF\xBF", 0},			// overlong 4 byte
+	{"abc\xED\xA0\x80", 3},				// surrogate U+D800
+	{"\xED\xBF\xBF", 0},				// surrogate U+DFFF
+	{"\xF4\x90\x80\x80", 0},			// U+110000
+	{"\xF5\x80\x80\x80", 0},			// lead byte beyond U+10FFFF
+	{"\xF8\x88\x80\x80\x80", 0},			// 5 byte sequence
+	{"\xFC\x84\x80\x80\x80\x80", 0},		// 6 byte sequence
+	{"\xFE", 0},
+	{"\xFF", 0},
+	{"\xC3", 0},					// incomplete at end
+	{"abc\xE2\x82", 3},				// incomplete at end
+	{"\xF0\x90\x80", 0},				// incomplete at end
+	{"\xC3\x41", 0},				// lead followed by ASCII
+	{"\xE2\x82\x41", 0},				// 3 byte lead followed by ASCII
+	{"\xC3\xA4\xA4", 2},				// continuation byte too many
+	{0, 0}
+};
+
+static unsigned int checkResult( const std::string& input, const char* what, bool valid, std::size_t errpos, int expected)
+{
+	if (valid ? (expected < 0) : (expected >= 0 && errpos == (std::size_t)expected)) return 0;
+	std::cerr << what << " of '";
+	for (std::size_t ii=0; ii<input.size(); ++ii)
+	{
+		if ((unsigned char)input[ii] < 128) std::cerr << input[ii];
+		else std::cerr << "\\x" << std::hex << (unsigned int)(unsigned char)input[ii] << std::dec;
+	}
+	std::cerr << "' returns " << (valid ? "valid" : "invalid");
+	if (!valid) std::cerr << " at " << errpos;
+	std::cerr << ", expected " << expected << std::endl;
+	return 1;
+}
+
+static unsigned int testValidator( const std::string& input, int expected)
+{
+	unsigned int errors = 0;
+	std::size_t errpos = 0;
+	bool valid = UTF8Validator::validate( input.c_str(), input.size(), &errpos);
+	errors += checkResult( input, "validation", valid, errpos, expected);
+
+	UTF8Validator validator;
+	for (std::size_t ii=0; ii<input.size(); ++ii)
+	{
+		validator.check( input.c_str() + ii, 1);
+	}
+	valid = validator.finish();
+	errors += checkResult( input, "bytewise validation", valid, validator.errorPosition(), expected);
+	if (validator.position() != input.size())
+	{
+		std::cerr << "bytewise validation counted " << validator.position() << " bytes instead of " << input.size() << std::endl;
+		++errors;
+	}
+	return errors;
+}
+
+typedef XMLScanner<CStringIterator,charset::UTF8,charset::UTF8,std::string> Scanner;
+typedef XMLScanner<char*,charset::UTF8,charset::UTF8,std::string> NullTerminatedScanner;
+typedef XMLScanner<SrcIterator,charset::UTF8,charset::UTF8,std::string> PushScanner;
+
+template <class ScannerType>
+static XMLScannerBase::ElementType scanAll( ScannerType& scanner, std::string& out)
+{
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		out.append( XMLScannerBase::getElementTypeName( type));
+		out.append( " ");
+		out.append( scanner.getItemPtr(), scanner.getItemSize());
+		out.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred || type == XMLScannerBase::NeedMoreInput) return type;
+	}
+}
+
+static unsigned int testScanner( const char* doc, int expected)
+{
+	unsigned int errors = 0;
+	std::string content( doc);
+
+	// ... the scanners iterate on the size of the document, because the decoder of an incomplete character at the end would read beyond the terminating 0
+	std::string lax;
+	Scanner laxScanner( (CStringIterator( content)));
+	scanAll( laxScanner, lax);
+
+	std::string strict;
+	Scanner scanner( (CStringIterator( content)));
+	scanner.setStrictUTF8();
+	XMLScannerBase::ElementType type = scanAll( scanner, strict);
+	if (expected < 0)
+	{
+		if (strict != lax)
+		{
+			std::cerr << "strict scanning of a valid document differs:" << std::endl << strict << "expected:" << std::endl << lax;
+			++errors;
+		}
+		// ... a null terminated source is validated up to the terminating 0
+		std::string nullterminated;
+		NullTerminatedScanner ntScanner( const_cast<char*>( doc));
+		ntScanner.setStrictUTF8();
+		scanAll( ntScanner, nullterminated);
+		if (nullterminated != lax)
+		{
+			std::cerr << "strict scanning of a valid null terminated document differs:" << std::endl << nullterminated << "expected:" << std::endl << lax;
+			++errors;
+		}
+	}
+	else
+	{
+		errors += checkResult( content, "strict scanning", type != XMLScannerBase::ErrorOccurred, scanner.getErrorPosition(), expected);
+		if (scanner.getError() != XMLScannerBase::ErrInvalidUTF8)
+		{
+			std::cerr << "strict scanning does not report ErrInvalidUTF8" << std::endl;
+			++errors;
+		}
+	}
+
+	// ... push mode with chunks of 3 bytes
+	PushScanner pushScanner;
+	pushScanner.setStrictUTF8();
+	std::string pushed;
+	std::size_t pos = 0;
+	do
+	{
+		std::size_t chunksize = (content.size() - pos > 3) ? 3 : (content.size() - pos);
+		pushScanner.putInput( content.c_str() + pos, chunksize, pos + chunksize == content.size());
+		pos += chunksize;
+		type = scanAll( pushScanner, pushed);
+	}
+	while (type == XMLScannerBase::NeedMoreInput);
+	errors += checkResult( content, "strict scanning in push mode", type != XMLScannerBase::ErrorOccurred, pushScanner.getErrorPosition(), expected);
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	for (unsigned int ti=0; testCases[ti].input; ++ti)
+	{
+		std::string input( testCases[ti].input);
+		errors += testValidator( input, testCases[ti].errpos);
+
+		// ... embed the sequence at every position of a text long enough for the vectorized checks
+		for (std::size_t pi=0; pi<40; ++pi)
+		{
+			std::string text( pi, 'a');
+			text.append( input);
+			int expected = testCases[ti].errpos < 0 ? -1 : (int)(testCases[ti].errpos + pi);
+			if (testCases[ti].errpos < 0 || input.size() > (std::size_t)testCases[ti].errpos + 1)
+			{
+				// ... not an incomplete sequence at the end: append more text and valid multibyte characters
+				for (unsigned int ci=0; ci<8; ++ci) text.append( "xyz\xC3\xA4\xE2\x82\xAC\xF0\x90\x80\x80");
+			}
+			errors += testValidator( text, expected);
+		}
+	}
+
+	errors += testScanner( "<doc a='\xC3\xA4'>\xE2\x82\xAC text \xF0\x90\x80\x80</doc>", -1);
+	errors += testScanner( "<doc>valid \xC3\xA4 and surrogate \xED\xA0\x80</doc>", 28);
+	errors += testScanner( "<doc>overlong \xC0\xBC</doc>", 14);
+	errors += testScanner( "<doc/>\xE2\x82", 6);
+
+	// ... strict mode is not available for a source iterator refilling its block
+	try
+	{
+		std::istringstream input( "<doc/>");
+		StdInputStream stream( input);
+		XMLScanner<IStreamIterator,charset::UTF8,charset::UTF8,std::string> scanner( (IStreamIterator( &stream)));
+		scanner.setStrictUTF8();
+		std::cerr << "strict mode not rejected for IStreamIterator" << std::endl;
+		++errors;
+	}
+	catch (const exception&)
+	{}
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,185 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+
+//build gcc
+//compile: g++ -c -o test_WideCharScanner.o -g -I../include/ -pedantic -Wall -O4 test_WideCharScanner.cpp
+//link: g++ -lc -o test_WideCharScanner test_WideCharScanner.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_WideCharScanner.obj" test_WideCharScanner.cpp
+//link: link.exe /out:.\test_WideCharScanner test_WideCharScanner.obj
+
+// Checks the processing of runs of characters of UTF-16, UCS-2 and UCS-4 input with the WideCharScanner in the XMLScanner:
+// Documents with the test characters embedded at every position of a longer text (vectorized path) have to be scanned
+// from a memory block with the same result as character by character from an iterator that does not iterate on a memory block.
+// Checks also the delimiter search against the classification of the code units one by one.
+
+using namespace textwolf;
+
+/// \brief Iterator on a null terminated string that is not known to iterate on a memory block (see traits::ContiguousSource)
+class CharIterator
+{
+public:
+	CharIterator() :m_ptr(0){}
+	explicit CharIterator( const char* ptr_) :m_ptr(ptr_){}
+	char operator*() const {return *m_ptr;}
+	CharIterator& operator++() {++m_ptr; return *this;}
+	int operator-( const CharIterator& o) const {return (int)(m_ptr - o.m_ptr);}
+private:
+	const char* m_ptr;
+};
+
+// Test strings as sequences of characters or code units terminated by 0
+static const UChar testStrings[][8] =
+{
+	{'a','b','c',0},
+	{0xE4,0x20AC,0xFFFF,0x100,0},
+	{0xD800,0xDC00,0xDBFF,0xDFFF,0},		// surrogate pairs in UTF-16
+	{'x',0xD800,'y',0},				// lone high surrogate
+	{0xDC00,'z',0},					// lone low surrogate
+	{0xD800,0xD800,0xDC00,0},			// high surrogate followed by a high surrogate
+	{0xD800,0xE000,0},				// high surrogate followed by a character beyond the low surrogates
+	{0xD83D,'<','/',0},				// high surrogate followed by a delimiter
+	{0x10000,0x10FFFF,0x7FFFFFFF,0},		// characters beyond the BMP in UCS-4
+	{0x180,0x8000,0x80000,0x8000000,0},		// characters with an ASCII byte in UCS-4
+	{0}
+};
+
+template <class InputCharSet, class OutputCharSet, class Iterator>
+static std::string scan( const Iterator& itr)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Scanner scanner( itr);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Encode characters as code units of 2 or 4 bytes, characters or code units that do not fit are truncated
+template <int CodeUnitSize, int byteorder>
+static void appendUnits( std::string& dest, const UChar* units)
+{
+	for (; *units; ++units)
+	{
+		for (int bi=0; bi<CodeUnitSize; ++bi)
+		{
+			int shift = (byteorder == charset::ByteOrder::LE) ? (8*bi) : (8*(CodeUnitSize-1-bi));
+			dest.push_back( (char)(unsigned char)((*units >> shift) & 0xFF));
+		}
+	}
+}
+
+/// \brief Build a document with the text in its content and in an attribute value
+template <int CodeUnitSize, int byteorder>
+static std::string document( const std::string& text)
+{
+	static const UChar markup[3][16] =
+	{
+		{'<','d','o','c',' ','a','=','\'',0},
+		{'\'','>',0},
+		{'<','/','d','o','c','>',0}
+	};
+	std::string rt;
+	for (unsigned int mi=0; mi<3; ++mi)
+	{
+		appendUnits<CodeUnitSize,byteorder>( rt, markup[ mi]);
+		if (mi < 2) rt.append( text);
+	}
+	// ... terminating 0 for the null terminated sources
+	rt.append( 4, '\0');
+	return rt;
+}
+
+template <class InputCharSet, class OutputCharSet, int CodeUnitSize, int byteorder>
+static unsigned int testScan( const char* what)
+{
+	unsigned int errors = 0;
+	for (unsigned int si=0; testStrings[ si][0]; ++si)
+	{
+		// ... embed the string at every position of a text long enough for the vectorized search
+		for (std::size_t pi=0; pi<40; ++pi)
+		{
+			static const UChar tail[] = {'x','y','z',0xE4,0x20AC,0xD800,0xDC00,' ','a','n','d',' ','m','o','r','e',0};
+			static const UChar lead[] = {'a',0};
+			std::string text;
+			for (std::size_t ci=0; ci<pi; ++ci) appendUnits<CodeUnitSize,byteorder>( text, lead);
+			appendUnits<CodeUnitSize,byteorder>( text, testStrings[ si]);
+			for (unsigned int ci=0; ci<4; ++ci) appendUnits<CodeUnitSize,byteorder>( text, tail);
+
+			std::string doc = document<CodeUnitSize,byteorder>( text);
+			std::string expected = scan<InputCharSet,OutputCharSet>( CharIterator( doc.c_str()));
+			std::string bulk = scan<InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size() - 4));
+			std::string bulkz = scan<InputCharSet,OutputCharSet>( doc.c_str());
+			if (bulk != expected || bulkz != expected)
+			{
+				std::cerr << "bulk processing " << what << " of test string " << si << " differs at position " << pi << ":" << std::endl
+					<< (bulk == expected ? bulkz : bulk) << "expected:" << std::endl << expected;
+				++errors;
+			}
+		}
+	}
+	return errors;
+}
+
+template <int CodeUnitSize, int byteorder>
+static unsigned int testFindDelimiter()
+{
+	typedef WideCharScanner<CodeUnitSize,byteorder> Scanner;
+	unsigned int errors = 0;
+	static const UChar units[] = {'a',0x80,0x141,0x3C00,0x10020,'<',0x7F,0x1000000,'&',0x263C,0};
+	std::string text;
+	appendUnits<CodeUnitSize,byteorder>( text, units);
+	while (text.size() < 96*CodeUnitSize) text.append( text);
+
+	ByteScanSet delims[2];
+	delims[0]( 0)('<')('&')('\r');
+	delims[1]( 0)('<')('&')('\r')(0x80);
+	for (unsigned int di=0; di<2; ++di)
+	{
+		for (std::size_t start=0; start+CodeUnitSize <= text.size(); start += CodeUnitSize)
+		{
+			const char* src = text.c_str() + start;
+			const char* end = text.c_str() + text.size();
+			const char* expected = src;
+			while (expected < end && !delims[ di][ Scanner::unitClass( expected)]) expected += CodeUnitSize;
+			if (Scanner::findDelimiter( delims[ di], src, end) != expected)
+			{
+				std::cerr << "delimiter search with code units of " << CodeUnitSize << " bytes fails at " << start << std::endl;
+				++errors;
+			}
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += testScan<charset::UTF16LE,charset::UTF16LE,2,charset::ByteOrder::LE>( "UTF-16LE>UTF-16LE");
+	errors += testScan<charset::UTF16BE,charset::UTF16LE,2,charset::ByteOrder::BE>( "UTF-16BE>UTF-16LE");
+	errors += testScan<charset::UTF16LE,charset::IsoLatin,2,charset::ByteOrder::LE>( "UTF-16LE>ISO-8859-1");
+	errors += testScan<charset::UCS2BE,charset::UTF8,2,charset::ByteOrder::BE>( "UCS-2BE>UTF-8");
+	errors += testScan<charset::UCS2LE,charset::UCS2LE,2,charset::ByteOrder::LE>( "UCS-2LE>UCS-2LE");
+	errors += testScan<charset::UCS4BE,charset::UTF8,4,charset::ByteOrder::BE>( "UCS-4BE>UTF-8");
+	errors += testScan<charset::UCS4LE,charset::UTF16BE,4,charset::ByteOrder::LE>( "UCS-4LE>UTF-16BE");
+	errors += testScan<charset::UCS4BE,charset::UCS4BE,4,charset::ByteOrder::BE>( "UCS-4BE>UCS-4BE");
+	errors += testFindDelimiter<2,charset::ByteOrder::LE>();
+	errors += testFindDelimiter<2,charset::ByteOrder::BE>();
+	errors += testFindDelimiter<4,charset::ByteOrder::LE>();
+	errors += testFindDelimiter<4,charset::ByteOrder::BE>();
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+
+//build gcc
+//compile: g++ -c -o test_Windows125xCodePages.o -g -I../include/ -pedantic -Wall -O4 test_Windows125xCodePages.cpp
+//link: g++ -lc -o test_Windows125xCodePages test_Windows125xCodePages.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_Windows125xCodePages.obj" test_Windows125xCodePages.cpp
+//link: link.exe /out:.\test_Windows125xCodePages test_Windows125xCodePages.obj
+
+// Checks the Windows code pages 1250..1258: every byte is printed as the byte it is read from and
+// some characters are decoded and printed as expected. Checks also that documents in single byte code pages
+// scanned from a memory block (runs decoded in bulk) give the same result as scanned character by character
+// from an iterator that does not iterate on a memory block.
+
+using namespace textwolf;
+
+/// \brief Iterator on a null terminated string that is not known to iterate on a memory block (see traits::ContiguousSource)
+class CharIterator
+{
+public:
+	CharIterator() :m_ptr(0){}
+	explicit CharIterator( const char* ptr_) :m_ptr(ptr_){}
+	char operator*() const {return *m_ptr;}
+	CharIterator& operator++() {++m_ptr; return *this;}
+	int operator-( const CharIterator& o) const {return (int)(m_ptr - o.m_ptr);}
+private:
+	const char* m_ptr;
+};
+
+struct CodeTest
+{
+	unsigned int codepage;
+	unsigned char byte;
+	UChar chr;
+};
+
+static const CodeTest codeTests[] =
+{
+	{1252, 0x80, 0x20AC},		// euro sign
+	{1252, 0x9F, 0x178},		// Y with diaeresis
+	{1252, 0xE4, 0xE4},
+	{1252, 0x81, 0x81},		// not assigned
+	{1250, 0xA3, 0x141},		// L with stroke
+	{1250, 0x8A, 0x160},		// S with caron
+	{1251, 0xC0, 0x410},		// cyrillic A
+	{1251, 0xA8, 0x401},		// cyrillic IO
+	{1253, 0xC1, 0x391},		// greek Alpha
+	{1254, 0xD0, 0x11E},		// G with breve
+	{1255, 0xE0, 0x5D0},		// hebrew Alef
+	{1256, 0xC7, 0x627},		// arabic Alef
+	{1257, 0xC0, 0x104},		// A with ogonek
+	{1258, 0xD2, 0x309},		// combining hook above
+	{0, 0, 0}
+};
+
+template <class InputCharSet, class OutputCharSet, class Iterator>
+static std::string scan( const Iterator& itr, const InputCharSet& input)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Scanner scanner( input, itr);
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " ");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Scan a document with all bytes in a single byte code page, the output is in the default code page of OutputCharSet
+template <class InputCharSet, class OutputCharSet>
+static unsigned int testScan( const char* what, const InputCharSet& input)
+{
+	// ... all bytes except markup and control characters in the content and in an attribute value
+	std::string text;
+	for (unsigned int ch=32; ch<256; ++ch)
+	{
+		if (ch != '<' && ch != '&' && ch != '\'' && ch != 127) text.push_back( (char)(unsigned char)ch);
+	}
+	std::string doc = std::string( "<doc a='") + text + "'>" + text + "&amp;" + text + "</doc>";
+	std::string expected = scan<InputCharSet,OutputCharSet>( CharIterator( doc.c_str()), input);
+	std::string bulk = scan<InputCharSet,OutputCharSet>( CStringIterator( doc.c_str(), doc.size()), input);
+	std::string bulkz = scan<InputCharSet,OutputCharSet>( doc.c_str(), input);
+	if (bulk == expected && bulkz == expected) return 0;
+	std::cerr << "bulk decoding " << what << " differs:" << std::endl
+		<< (bulk == expected ? bulkz : bulk) << "expected:" << std::endl << expected;
+	return 1;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	for (unsigned int cp=1250; cp<=1258; ++cp)
+	{
+		charset::Windows125x charset( cp);
+		for (unsigned int ch=1; ch<256; ++ch)
+		{
+			UChar uc = charset.ucharcode( (char)(unsigned char)ch);
+			std::string out;
+			charset.print( uc, out);
+			if (out.size() != 1 || (unsigned char)out[0] != ch)
+			{
+				std::cerr << "code page " << cp << ": character " << uc << " of byte " << ch << " printed as '" << out << "'" << std::endl;
+				++errors;
+			}
+		}
+	}
+	for (unsigned int ti=0; codeTests[ ti].codepage; ++ti)
+	{
+		charset::Windows125x charset( codeTests[ ti].codepage);
+		UChar uc = charset.ucharcode( (char)codeTests[ ti].byte);
+		if (uc != codeTests[ ti].chr)
+		{
+			std::cerr << "code page " << codeTests[ ti].codepage << ": byte " << (unsigned int)codeTests[ ti].byte << " decoded as " << uc << " instead of " << codeTests[ ti].chr << std::endl;
+			++errors;
+		}
+	}
+	std::string out;
+	charset::Windows125x( 1252).print( 0x141, out);
+	if (out != "&#x141;")
+	{
+		std::cerr << "character not in code page printed as '" << out << "'" << std::endl;
+		++errors;
+	}
+	try
+	{
+		charset::Windows125x charset( 1259);
+		std::cerr << "unknown code page not rejected" << std::endl;
+		++errors;
+	}
+	catch (const exception&)
+	{}
+
+	errors += testScan<charset::Windows125x,charset::UTF8>( "windows-1252>UTF-8", charset::Windows125x( 1252));
+	errors += testScan<charset::Windows125x,charset::UTF16LE>( "windows-1251>UTF-16LE", charset::Windows125x( 1251));
+	errors += testScan<charset::Windows125x,charset::IsoLatin>( "windows-1250>ISO-8859-1", charset::Windows125x( 1250));
+	errors += testScan<charset::Windows125x,charset::Windows125x>( "windows-1252>windows-1252", charset::Windows125x( 1252));
+	errors += testScan<charset::Windows125x,charset::Windows125x>( "windows-1250>windows-1252", charset::Windows125x( 1250));
+	errors += testScan<charset::IsoLatin,charset::UTF8>( "ISO-8859-1>UTF-8", charset::IsoLatin( 1));
+	errors += testScan<charset::IsoLatin,charset::Windows125x>( "ISO-8859-15>windows-1252", charset::IsoLatin( 9));
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,154 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+//build gcc
+//compile: g++ -c -o test_XMLBatchProcessor.o -g -I../include/ -pedantic -Wall -O4 test_XMLBatchProcessor.cpp
+//link: g++ -lc -lpthread -o test_XMLBatchProcessor test_XMLBatchProcessor.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_XMLBatchProcessor.obj" test_XMLBatchProcessor.cpp
+//link: link.exe /out:.\test_XMLBatchProcessor test_XMLBatchProcessor.obj
+
+// Checks that the XMLBatchProcessor selects the same elements as a XMLScanner
+// with a XMLPathSelect processing the documents one by one, for different numbers of threads.
+
+using namespace textwolf;
+
+typedef XMLPathSelectAutomaton<charset::UTF8> Automaton;
+
+static const char* testparts[] =
+{
+	"<TT c='6'>7</TT>",
+	"<TT i='56'>8</TT>",
+	"<TT i='9'><v>9</v></TT>",
+	"<TT><AA><BB>10</BB></AA></TT>",
+	"<TT><AA>&#65;Z&amp;&lt;&gt;&apos;&nbsp;&quot;Z</AA></TT>",
+	"<AA z='4' t='4'>12 12 12</AA>",
+	"<X><CC>15</CC></X><X><z><CC>15</CC></z></X>",
+	"<Y><mm u='8'>16</mm></Y><Y><z><zz e='6' u='8' z='4'>16</zz></z></Y>",
+	"<Y><mm q='2'>18</mm></Y><Y><z><zz e='2'>18</zz></z></Y>",
+	"<a>error <</a>",
+	0
+};
+
+static std::vector<std::string> buildDocuments( unsigned int nofDocuments)
+{
+	std::vector<std::string> rt;
+	unsigned int rnd = 11;
+	for (unsigned int di=0; di<nofDocuments; ++di)
+	{
+		std::string doc( "<?xml charset=utf-8?>\r\n<doc>");
+		rnd = rnd * 1103515245 + 12345;
+		unsigned int nofParts = (rnd >> 16) % 8;
+		for (unsigned int pi=0; pi<nofParts; ++pi)
+		{
+			rnd = rnd * 1103515245 + 12345;
+			doc.append( testparts[ (rnd >> 16) % 10]);
+		}
+		doc.append( "</doc>");
+		rt.push_back( doc);
+	}
+	return rt;
+}
+
+static std::string selectSequential( const Automaton& atm, const std::string& doc)
+{
+	std::ostringstream rt;
+	XMLScanner<char*,charset::UTF8,charset::UTF8,std::string> scanner( const_cast<char*>( doc.c_str()));
+	XMLPathSelect<charset::UTF8> selector( &atm);
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		std::string value( scanner.getItemPtr(), scanner.getItemSize());
+		if (type == XMLScannerBase::Exit) break;
+		if (type == XMLScannerBase::ErrorOccurred)
+		{
+			const char* msg;
+			scanner.getError( &msg);
+			rt << "error '" << msg << "'" << std::endl;
+			break;
+		}
+		XMLPathSelect<charset::UTF8>::iterator itr = selector.push( type, value), end = selector.end();
+		for (; itr != end; ++itr)
+		{
+			rt << *itr << " '" << value << "'" << std::endl;
+		}
+	}
+	return rt.str();
+}
+
+static std::vector<std::string> selectBatch( const Automaton& atm, const std::vector<std::string>& docs, unsigned int nofThreads)
+{
+	std::vector<std::string> rt( docs.size());
+	XMLBatchProcessor<charset::UTF8> processor( &atm, nofThreads);
+	for (unsigned int run=0; run<2; ++run)
+	{
+		// ... the second run reuses scanners and selectors of the first one
+		for (std::size_t di=0; di<docs.size(); ++di)
+		{
+			processor.push( di, docs[ di].c_str(), docs[ di].size());
+		}
+		processor.run();
+	}
+	for (unsigned int wi=0; wi<processor.nofWorkers(); ++wi)
+	{
+		const XMLBatchResults& results = processor.results( wi);
+		for (std::size_t ri=0; ri<results.size(); ++ri)
+		{
+			std::ostringstream line;
+			line << results.type( ri) << " '" << std::string( results.value( ri), results.valueSize( ri)) << "'" << std::endl;
+			rt[ results.docid( ri)].append( line.str());
+		}
+		for (std::size_t ei=0; ei<results.nofErrors(); ++ei)
+		{
+			rt[ results.errorDocid( ei)].append( "error '" + results.error( ei) + "'\n");
+		}
+	}
+	return rt;
+}
+
+int main( int, const char**)
+{
+	Automaton atm;
+	(*atm)["doc"]["TT"]("c") = 6;
+	(*atm)["doc"]["TT"]("c")() = 7;
+	(*atm)["doc"]["TT"]("i","56")() = 8;
+	(*atm)["doc"]["TT"]("i","9")--() = 9;
+	(*atm)["doc"]["TT"]["AA"]["BB"] = 10;
+	(*atm)["doc"]["TT"]["AA"] = 11;
+	(*atm)["doc"]["AA"]() = 12;
+	(*atm)--["CC"]() = 14;
+	(*atm)["doc"]["X"]--["CC"] = 15;
+	(*atm)["doc"]["Y"]--("u") = 16;
+	(*atm)["doc"]["Y"]--(0,"2")() = 18;
+
+	std::vector<std::string> docs = buildDocuments( 3000);
+	std::vector<std::string> expected;
+	for (std::size_t di=0; di<docs.size(); ++di)
+	{
+		expected.push_back( selectSequential( atm, docs[ di]));
+	}
+	static const unsigned int threads[] = {1, 2, 5, 16, 0};
+	unsigned int errors = 0;
+	for (unsigned int ti=0; threads[ ti]; ++ti)
+	{
+		std::vector<std::string> result = selectBatch( atm, docs, threads[ ti]);
+		for (std::size_t di=0; di<docs.size(); ++di)
+		{
+			if (result[ di] != expected[ di])
+			{
+				std::cerr << "results of document " << di << " processed with " << threads[ ti] << " threads differ:" << std::endl << result[ di] << "expected:" << std::endl << expected[ di];
+				++errors;
+			}
+		}
+	}
+	if (errors)
+	{
+		std::cerr << errors << " documents with errors" << std::endl;
+		return 1;
+	}
+	std::cout << "OK" << std::endl;
+	return 0;
+}
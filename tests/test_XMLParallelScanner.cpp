@@ -0,0 +1,106 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+//build gcc
+//compile: g++ -c -o test_XMLParallelScanner.o -g -I../include/ -pedantic -Wall -O4 test_XMLParallelScanner.cpp
+//link: g++ -lc -lpthread -o test_XMLParallelScanner test_XMLParallelScanner.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_XMLParallelScanner.obj" test_XMLParallelScanner.cpp
+//link: link.exe /out:.\test_XMLParallelScanner test_XMLParallelScanner.obj
+
+// Checks that the XMLParallelScanner returns the same elements as the XMLScanner
+// for different numbers of threads, on documents where the ranges scanned in parallel
+// start in tags, comments, CDATA sections and processing instructions.
+
+using namespace textwolf;
+
+static const char* testparts[] =
+{
+	"<p>Zwei Stra\xc3\x9f" "en, ein Weg: \xe2\x82\xac 12,50 &#x20AC; &#8364;\r\nzweite Zeile\rdritte Zeile</p>\n",
+	"<!-- a comment with <markup> and <!-- <more/> -->",
+	"<e a='x > y' b=\"z/>\" />",
+	"<![CDATA[ <not> a tag & <no/> entity ]]>",
+	"<n>don't \"quote\" me &lt;n&gt;</n>",
+	"<?pi <with> markup?>",
+	"<TT><AA><BB>10</BB></AA></TT>\r\n",
+	0
+};
+
+static std::string buildDocument( unsigned int nofParts, const char* trailer)
+{
+	std::string rt( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<doc lang=\"de\">");
+	unsigned int rnd = 7;
+	for (unsigned int ii=0; ii<nofParts; ++ii)
+	{
+		rnd = rnd * 1103515245 + 12345;
+		rt.append( testparts[ (rnd >> 16) % 7]);
+	}
+	rt.append( trailer);
+	return rt;
+}
+
+static std::string scan( XMLScannerBase::ElementType type, const char* content, std::size_t size)
+{
+	std::string rt( XMLScannerBase::getElementTypeName( type));
+	rt.append( " '");
+	rt.append( content, size);
+	rt.append( "'\n");
+	return rt;
+}
+
+static std::string scanSequential( const std::string& doc)
+{
+	std::string rt;
+	XMLScanner<char*,charset::UTF8,charset::UTF8,std::string> scanner( const_cast<char*>( doc.c_str()));
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		rt.append( scan( type, scanner.getItemPtr(), scanner.getItemSize()));
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) break;
+	}
+	return rt;
+}
+
+static std::string scanParallel( const std::string& doc, unsigned int nofThreads)
+{
+	std::string rt;
+	EventBuffer events;
+	XMLParallelScanner<charset::UTF8,charset::UTF8> scanner( doc.c_str(), doc.size(), nofThreads);
+	scanner.scan( events);
+	for (std::size_t ii=0; ii<events.size(); ++ii)
+	{
+		rt.append( scan( events.type( ii), events.content( ii), events.contentSize( ii)));
+	}
+	return rt;
+}
+
+int main( int, const char**)
+{
+	static const char* trailers[] = {"</doc>", "<a>error <</a></doc>", "<a>unterminated &amp entity</a></doc>", 0};
+	static const unsigned int threads[] = {1, 2, 3, 7, 16, 0};
+	unsigned int errors = 0;
+
+	for (unsigned int di=0; trailers[di]; ++di)
+	{
+		std::string doc = buildDocument( 2000, trailers[di]);
+		std::string expected = scanSequential( doc);
+		for (unsigned int ti=0; threads[ti]; ++ti)
+		{
+			std::string result = scanParallel( doc, threads[ti]);
+			if (result != expected)
+			{
+				std::cerr << "elements of document " << di << " scanned with " << threads[ti] << " threads differ" << std::endl;
+				++errors;
+			}
+		}
+	}
+	if (errors)
+	{
+		std::cerr << errors << " scans with errors" << std::endl;
+		return 1;
+	}
+	std::cout << "OK" << std::endl;
+	return 0;
+}
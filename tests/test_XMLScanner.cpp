@@ -44,6 +44,7 @@ int main( int, const char**)
 				case MyXMLScanner::CloseTagIm: typestr = "close tag"; break;
 				case MyXMLScanner::Content: typestr = "content"; break;
 				case MyXMLScanner::Exit: typestr = "end of document"; break;
+				case MyXMLScanner::NeedMoreInput: continue;
 			}
 			std::cout << "Element (" << itr->name() << ")" << typestr << ": " << itr->content() << std::endl;
 		}
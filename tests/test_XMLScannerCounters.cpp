@@ -0,0 +1,106 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+//build gcc
+//compile: g++ -c -o test_XMLScannerCounters.o -g -I../include/ -pedantic -Wall -O4 test_XMLScannerCounters.cpp
+//link: g++ -lc -o test_XMLScannerCounters test_XMLScannerCounters.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_XMLScannerCounters.obj" test_XMLScannerCounters.cpp
+//link: link.exe /out:.\test_XMLScannerCounters test_XMLScannerCounters.obj
+
+// Checks the counters of the XMLScannerCounters instrumentation policy of the XMLScanner
+// and that the elements scanned are the same as without instrumentation.
+
+using namespace textwolf;
+
+static const char* testdoc =
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<doc lang=\"de\">"
+	"<!-- comment -->"
+	"<p>&#65;&#x42;&amp;&lt;&gt; &amp no entity</p>"
+	"<e a='x' b=\"y\"/>"
+	"<![CDATA[ <not> a tag ]]>"
+	"</doc>";
+
+typedef XMLScanner<char*,charset::UTF8,charset::UTF8,std::string> Scanner;
+typedef XMLScanner<char*,charset::UTF8,charset::UTF8,std::string,XMLScannerCounters> InstrumentedScanner;
+
+template <class ScannerType>
+static std::string scan( ScannerType& scanner, unsigned short mask)
+{
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem( mask);
+		rt.append( XMLScannerBase::getElementTypeName( type));
+		rt.append( " '");
+		rt.append( scanner.getItemPtr(), scanner.getItemSize());
+		rt.append( "'\n");
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) break;
+	}
+	return rt;
+}
+
+static unsigned int check( const char* what, std::size_t value, std::size_t expected)
+{
+	if (value == expected) return 0;
+	std::cerr << what << " is " << value << ", expected " << expected << std::endl;
+	return 1;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	const unsigned short masks[2] = {0xFFFF, 0xFFFF ^ (1 << XMLScannerBase::Content)};
+	for (unsigned int mi=0; mi<2; ++mi)
+	{
+		Scanner reference( const_cast<char*>( testdoc));
+		std::string expected = scan( reference, masks[ mi]);
+
+		InstrumentedScanner scanner( const_cast<char*>( testdoc));
+		std::string result = scan( scanner, masks[ mi]);
+		if (result != expected)
+		{
+			std::cerr << "elements with mask " << masks[ mi] << " differ:" << std::endl << result << "expected:" << std::endl << expected;
+			++errors;
+		}
+		XMLScannerCounters counters = scanner.getInstrumentation();
+		std::size_t bytes = 0, transitions = 0;
+		for (int fi=0; fi<XMLScannerCounters::NofStates; ++fi)
+		{
+			bytes += counters.bytes( (XMLScannerBase::STMState)fi);
+			for (int ti=0; ti<XMLScannerCounters::NofStates; ++ti)
+			{
+				transitions += counters.transitions( (XMLScannerBase::STMState)fi, (XMLScannerBase::STMState)ti);
+			}
+		}
+		// ... the terminating 0 is consumed as end of text
+		errors += check( "bytes consumed", bytes, std::strlen( testdoc) + 1);
+		errors += check( "transitions to EXIT", counters.transitions( XMLScannerBase::CONTENT, XMLScannerBase::EXIT), 1);
+		errors += check( "transitions to CDATA", counters.transitions( XMLScannerBase::CDATA3, XMLScannerBase::CONTENT), 1);
+		if (mi == 0)
+		{
+			errors += check( "decimal entities", counters.entities( XMLScannerCounters::DecimalEntity), 1);
+			errors += check( "hexadecimal entities", counters.entities( XMLScannerCounters::HexEntity), 1);
+			errors += check( "named entities", counters.entities( XMLScannerCounters::NamedEntity), 3);
+			errors += check( "invalid entities", counters.entities( XMLScannerCounters::InvalidEntity), 1);
+			errors += check( "tokens skipped", counters.tokensSkipped(), 0);
+			errors += check( "maximum output size", counters.maxOutputSize(), std::strlen( "AB&<> &amp no entity"));
+		}
+		else
+		{
+			errors += check( "tokens skipped", counters.tokensSkipped(), 1);
+		}
+		errors += check( "tokens parsed or skipped", counters.tokensParsed() + counters.tokensSkipped(), 16);
+		errors += check( "transitions", transitions, 86);
+	}
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,211 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <cstring>
+#include <vector>
+
+//build gcc
+//compile: g++ -c -o test_XMLScannerNextItems.o -g -I../include/ -pedantic -Wall -O4 test_XMLScannerNextItems.cpp
+//link: g++ -lc -o test_XMLScannerNextItems test_XMLScannerNextItems.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_XMLScannerNextItems.obj" test_XMLScannerNextItems.cpp
+//link: link.exe /out:.\test_XMLScannerNextItems test_XMLScannerNextItems.obj
+
+// Checks that the batches of XMLScanner::nextItems contain the same elements as the calls of nextItem,
+// that a batch contains at most the number of elements requested, that it ends with Exit, ErrorOccurred and (in push mode) NeedMoreInput
+// and that the offsets of the element values in the arena of the EventBuffer are consecutive.
+
+using namespace textwolf;
+
+static const char* testdoc =
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+	"<doc lang=\"de\">"
+	"<!-- comment -->"
+	"<p>&#65;&#x42;&amp;&lt;&gt; text</p>"
+	"<e a='x' b=\"y\"/>"
+	"<![CDATA[ <not> a tag ]]>"
+	"</doc>";
+
+typedef XMLScanner<char*,charset::UTF8,charset::UTF8,std::string> Scanner;
+typedef XMLScanner<SrcIterator,charset::UTF8,charset::UTF8,std::string> PushScanner;
+
+static void appendItem( std::string& rt, XMLScannerBase::ElementType type, const char* content, std::size_t size)
+{
+	rt.append( XMLScannerBase::getElementTypeName( type));
+	rt.append( " '");
+	rt.append( content, size);
+	rt.append( "'\n");
+}
+
+template <class ScannerType>
+static std::string scanItems( ScannerType& scanner, unsigned short mask)
+{
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem( mask);
+		appendItem( rt, type, scanner.getItemPtr(), scanner.getItemSize());
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) break;
+	}
+	return rt;
+}
+
+static unsigned int checkBatch( const char* what, const EventBuffer& buf, std::size_t nofItems, std::size_t max)
+{
+	unsigned int errors = 0;
+	if (nofItems != buf.size())
+	{
+		std::cerr << what << ": returned " << nofItems << " elements, the batch has " << buf.size() << std::endl;
+		++errors;
+	}
+	if (buf.size() > max || buf.empty())
+	{
+		std::cerr << what << ": batch of " << buf.size() << " elements with limit " << max << std::endl;
+		++errors;
+	}
+	std::size_t offset = 0;
+	for (std::size_t ii=0; ii<buf.size(); ++ii)
+	{
+		if (buf[ ii].offset != offset || buf.content( ii) != buf.arena().data() + offset)
+		{
+			std::cerr << what << ": element " << ii << " at offset " << buf[ ii].offset << ", expected " << offset << std::endl;
+			++errors;
+		}
+		offset += buf.contentSize( ii);
+		XMLScannerBase::ElementType type = buf.type( ii);
+		bool last = (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred || type == XMLScannerBase::NeedMoreInput);
+		if (last && ii+1 != buf.size())
+		{
+			std::cerr << what << ": batch continues after " << XMLScannerBase::getElementTypeName( type) << std::endl;
+			++errors;
+		}
+		if (!last && ii+1 == buf.size() && buf.size() != max)
+		{
+			std::cerr << what << ": batch of " << buf.size() << " elements ends with " << XMLScannerBase::getElementTypeName( type) << std::endl;
+			++errors;
+		}
+	}
+	if (offset != buf.arena().size())
+	{
+		std::cerr << what << ": arena of " << buf.arena().size() << " bytes, elements cover " << offset << std::endl;
+		++errors;
+	}
+	return errors;
+}
+
+static void appendBatch( std::string& rt, const EventBuffer& buf)
+{
+	for (std::size_t ii=0; ii<buf.size(); ++ii)
+	{
+		appendItem( rt, buf.type( ii), buf.content( ii), buf.contentSize( ii));
+	}
+}
+
+static unsigned int testBatches( const char* what, const std::string& doc, const std::string& expected, std::size_t max, unsigned short mask, bool strict)
+{
+	unsigned int errors = 0;
+	std::vector<char> content( doc.c_str(), doc.c_str() + doc.size() + 1);
+	Scanner scanner( &content[0]);
+	scanner.setStrictUTF8( strict);
+	EventBuffer buf;
+	std::string result;
+	while (buf.lastType() != XMLScannerBase::Exit && buf.lastType() != XMLScannerBase::ErrorOccurred)
+	{
+		std::size_t nofItems = scanner.nextItems( buf, max, mask);
+		errors += checkBatch( what, buf, nofItems, max);
+		if (buf.empty()) break;
+		appendBatch( result, buf);
+	}
+	if (result != expected)
+	{
+		std::cerr << what << " in batches of " << max << (strict?" validated":"") << " with mask " << mask << " differ:" << std::endl << result << "expected:" << std::endl << expected;
+		++errors;
+	}
+	return errors;
+}
+
+static unsigned int testPushMode( const std::string& doc, const std::string& expected)
+{
+	unsigned int errors = 0;
+	for (std::size_t splitpos=1; splitpos<doc.size(); ++splitpos)
+	{
+		std::string chunk1( doc.c_str(), splitpos);
+		std::string chunk2( doc.c_str() + splitpos);
+		PushScanner scanner;
+		scanner.putInput( chunk1.c_str(), chunk1.size(), false);
+		EventBuffer buf;
+		std::string result;
+		bool complete = false;
+		std::size_t nofNeedMoreInput = 0;
+		while (buf.lastType() != XMLScannerBase::Exit && buf.lastType() != XMLScannerBase::ErrorOccurred)
+		{
+			std::size_t nofItems = scanner.nextItems( buf, 1000);
+			errors += checkBatch( "push mode", buf, nofItems, 1000);
+			if (buf.empty()) break;
+			for (std::size_t ii=0; ii<buf.size(); ++ii)
+			{
+				if (buf.type( ii) != XMLScannerBase::NeedMoreInput)
+				{
+					appendItem( result, buf.type( ii), buf.content( ii), buf.contentSize( ii));
+				}
+			}
+			if (buf.lastType() == XMLScannerBase::NeedMoreInput)
+			{
+				++nofNeedMoreInput;
+				if (complete) break;
+				if (scanner.nextItems( buf, 0) != 0 || !buf.empty())
+				{
+					std::cerr << "push mode split at " << splitpos << ": batch with limit 0 is not empty" << std::endl;
+					++errors;
+				}
+				scanner.putInput( chunk2.c_str(), chunk2.size(), true);
+				complete = true;
+			}
+		}
+		if (nofNeedMoreInput != 1)
+		{
+			std::cerr << "push mode split at " << splitpos << ": " << nofNeedMoreInput << " batches end with NeedMoreInput, expected 1" << std::endl;
+			++errors;
+		}
+		if (result != expected)
+		{
+			std::cerr << "push mode split at " << splitpos << " differs:" << std::endl << result << "expected:" << std::endl << expected;
+			++errors;
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	const unsigned short masks[2] = {0xFFFF, 0xFFFF ^ (1 << XMLScannerBase::Content)};
+	const std::size_t limits[5] = {1, 2, 3, 7, 1000};
+	const char* docs[2] = {testdoc, "<doc><a b></a></doc>"};
+	for (unsigned int di=0; di<2; ++di)
+	{
+		for (unsigned int mi=0; mi<2; ++mi)
+		{
+			std::vector<char> content( docs[ di], docs[ di] + std::strlen( docs[ di]) + 1);
+			Scanner reference( &content[0]);
+			std::string expected = scanItems( reference, masks[ mi]);
+			for (unsigned int li=0; li<5; ++li)
+			{
+				errors += testBatches( di?"document with error":"document", docs[ di], expected, limits[ li], masks[ mi], false);
+				errors += testBatches( di?"document with error":"document", docs[ di], expected, limits[ li], masks[ mi], true);
+			}
+		}
+	}
+	{
+		std::vector<char> content( testdoc, testdoc + std::strlen( testdoc) + 1);
+		Scanner reference( &content[0]);
+		errors += testPushMode( testdoc, scanItems( reference, 0xFFFF));
+	}
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cout << "OK" << std::endl;
+	return 0;
+}
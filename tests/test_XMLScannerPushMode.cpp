@@ -0,0 +1,211 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <vector>
+#include <cstring>
+
+//build gcc
+//compile: g++ -c -o test_XMLScannerPushMode.o -g -I../include/ -pedantic -Wall -O4 test_XMLScannerPushMode.cpp
+//link: g++ -lc -o test_XMLScannerPushMode test_XMLScannerPushMode.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_XMLScannerPushMode.obj" test_XMLScannerPushMode.cpp
+//link: link.exe /out:.\test_XMLScannerPushMode test_XMLScannerPushMode.obj
+
+// Checks that the XMLScanner in push mode (putInput) returns the same elements as the scan of the whole document in one buffer,
+// when the document is split into two chunks at every byte offset and into three chunks with a chunk of one byte at every byte offset.
+// The splits cut through multibyte characters, the code units of UTF-16 and UCS-4, end of lines (CR LF), entities, tags and comments.
+// Checks that a copy of the scanner continues scanning like the scanner copied after every element, also when the scanner copied is destroyed.
+
+using namespace textwolf;
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml version='1.0' encoding='UTF-8'?>\r\n<!-- \xC3\xA4 comment -->\r\n<d\xC3\xA4 a='x&amp;y&#x20AC;' b=\"\xE2\x82\xAC\xF0\x90\x80\x80\">\xC3\xA4&lt;&#65;&gt;\r\n\r<![CDATA[<\xE2\x82\xAC>]]><e/><f g='&quot;&apos;'/>\xF0\x90\x80\x80</d\xC3\xA4>",
+	"<doc>&amp;&#x10000;&#1234;&unknown;</doc>",
+	"<doc a=>error</doc>",
+	"<doc>incomplete \xE2\x82\xAC",
+	0
+};
+
+static void appendItem( std::string& rt, XMLScannerBase::ElementType type, const char* ptr, std::size_t size)
+{
+	rt.append( XMLScannerBase::getElementTypeName( type));
+	rt.append( " ");
+	rt.append( ptr, size);
+	rt.append( "\n");
+}
+
+template <class InputCharSet, class OutputCharSet>
+static std::string scanWhole( const std::string& doc)
+{
+	typedef XMLScanner<CStringIterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	Scanner scanner( CStringIterator( doc.c_str(), doc.size()));
+	std::string rt;
+	for (;;)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem();
+		appendItem( rt, type, scanner.getItemPtr(), scanner.getItemSize());
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+	}
+}
+
+/// \brief Scan a document in push mode, fed in chunks ending at the offsets passed
+/// \remark Every chunk is copied to a buffer of exactly its size plus the padding required, so that reading beyond it is detected by memory checkers
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static std::string scanPushed( const std::string& doc, const std::vector<std::size_t>& splits, bool zeroCopy)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	std::size_t paddingsize = traits::ChunkSource<Iterator>::PaddingSize;
+	std::vector<char> chunk;
+	Scanner scanner;
+	scanner.setZeroCopy( zeroCopy);
+	std::string rt;
+	std::size_t pos = 0;
+	std::size_t ci = 0;
+	for (;;)
+	{
+		std::size_t end = (ci < splits.size()) ? splits[ ci] : doc.size();
+		bool eof = (ci >= splits.size());
+		chunk.assign( doc.c_str() + pos, doc.c_str() + end);
+		chunk.resize( chunk.size() + paddingsize + 1, 0);
+		scanner.putInput( &chunk[0], end - pos, eof);
+		XMLScannerBase::ElementType type;
+		for (;;)
+		{
+			type = scanner.nextItem();
+			if (type == XMLScannerBase::NeedMoreInput) break;
+			appendItem( rt, type, scanner.getItemPtr(), scanner.getItemSize());
+			if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred) return rt;
+		}
+		if (eof)
+		{
+			rt.append( "input exhausted\n");
+			return rt;
+		}
+		// ... the scanner does not refer to the chunk anymore (items returned are copied to rt), so it can be freed
+		std::vector<char>().swap( chunk);
+		pos = end;
+		++ci;
+	}
+}
+
+/// \brief Scan a document in push mode, fed in two chunks split at the offset passed, continuing after every element with a copy of the scanner
+/// \remark The scanner copied is destroyed, so that a copy referring to its buffer for a character completed across the two chunks is detected by memory checkers
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static std::string scanPushedCopied( const std::string& doc, std::size_t splitpos, bool zeroCopy)
+{
+	typedef XMLScanner<Iterator,InputCharSet,OutputCharSet,std::string> Scanner;
+	std::size_t paddingsize = traits::ChunkSource<Iterator>::PaddingSize;
+	std::vector<char> chunk1( doc.c_str(), doc.c_str() + splitpos);
+	std::vector<char> chunk2( doc.c_str() + splitpos, doc.c_str() + doc.size());
+	chunk1.resize( chunk1.size() + paddingsize + 1, 0);
+	chunk2.resize( chunk2.size() + paddingsize + 1, 0);
+	Scanner* scanner = new Scanner();
+	scanner->setZeroCopy( zeroCopy);
+	scanner->putInput( &chunk1[0], splitpos, false);
+	std::string rt;
+	bool complete = false;
+	XMLScannerBase::ElementType type;
+	do
+	{
+		type = scanner->nextItem();
+		if (type == XMLScannerBase::NeedMoreInput)
+		{
+			if (complete) break;
+			scanner->putInput( &chunk2[0], doc.size() - splitpos, true);
+			complete = true;
+		}
+		else
+		{
+			appendItem( rt, type, scanner->getItemPtr(), scanner->getItemSize());
+		}
+		Scanner* copy = new Scanner( *scanner);
+		delete scanner;
+		scanner = copy;
+	}
+	while (type != XMLScannerBase::Exit && type != XMLScannerBase::ErrorOccurred);
+	delete scanner;
+	return rt;
+}
+
+/// \brief Encode a UTF-8 document in the character set encoding of the input
+template <class CharSet>
+static std::string encode( const char* doc)
+{
+	CharSet charset;
+	std::string rt;
+	TextScanner<CStringIterator,charset::UTF8> ts( (CStringIterator( doc)));
+	for (; *ts; ++ts) charset.print( *ts, rt);
+	return rt;
+}
+
+template <class Iterator, class InputCharSet, class OutputCharSet>
+static unsigned int testSplits( const char* what, const std::string& doc, const std::string& expected, bool zeroCopy)
+{
+	unsigned int errors = 0;
+	for (std::size_t splitpos=0; splitpos<=doc.size(); ++splitpos)
+	{
+		for (unsigned int nofsplits=1; nofsplits<=2; ++nofsplits)
+		{
+			std::vector<std::size_t> splits;
+			splits.push_back( splitpos);
+			if (nofsplits == 2)
+			{
+				if (splitpos == doc.size()) continue;
+				splits.push_back( splitpos+1);
+			}
+			std::string result = scanPushed<Iterator,InputCharSet,OutputCharSet>( doc, splits, zeroCopy);
+			if (result != expected)
+			{
+				std::cerr << what << (zeroCopy?" in zero copy mode":"") << " split at " << splitpos;
+				if (nofsplits == 2) std::cerr << " and " << (splitpos+1);
+				std::cerr << " differs:" << std::endl << result << "expected:" << std::endl << expected;
+				++errors;
+			}
+		}
+		std::string result = scanPushedCopied<Iterator,InputCharSet,OutputCharSet>( doc, splitpos, zeroCopy);
+		if (result != expected)
+		{
+			std::cerr << what << (zeroCopy?" in zero copy mode":"") << " split at " << splitpos << " with copies of the scanner differs:" << std::endl << result << "expected:" << std::endl << expected;
+			++errors;
+		}
+	}
+	return errors;
+}
+
+template <class InputCharSet, class OutputCharSet>
+static unsigned int test( const char* what)
+{
+	unsigned int errors = 0;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		std::string doc = encode<InputCharSet>( testDocuments[ di]);
+		std::string expected = scanWhole<InputCharSet,OutputCharSet>( doc);
+		for (unsigned int zi=0; zi<2; ++zi)
+		{
+			errors += testSplits<SrcIterator,InputCharSet,OutputCharSet>( what, doc, expected, zi==1);
+			errors += testSplits<PaddedSrcIterator,InputCharSet,OutputCharSet>( what, doc, expected, zi==1);
+		}
+	}
+	return errors;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	errors += test<charset::UTF8,charset::UTF8>( "UTF-8>UTF-8");
+	errors += test<charset::UTF8,charset::UTF16LE>( "UTF-8>UTF-16LE");
+	errors += test<charset::UTF16LE,charset::UTF8>( "UTF-16LE>UTF-8");
+	errors += test<charset::UTF16BE,charset::UTF16BE>( "UTF-16BE>UTF-16BE");
+	errors += test<charset::UCS4LE,charset::UTF8>( "UCS-4LE>UTF-8");
+	errors += test<charset::IsoLatin,charset::UTF8>( "ISO-8859-1>UTF-8");
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
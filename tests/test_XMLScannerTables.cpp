@@ -0,0 +1,154 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <stdio.h>
+
+//build gcc
+//compile: g++ -c -o test_XMLScannerTables.o -g -I../include/ -pedantic -Wall -O4 test_XMLScannerTables.cpp
+//link: g++ -lc -o test_XMLScannerTables test_XMLScannerTables.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_XMLScannerTables.obj" test_XMLScannerTables.cpp
+//link: link.exe /out:.\test_XMLScannerTables test_XMLScannerTables.obj
+
+// Checks the constant tables of the XML scanner (XMLScannerTables, ControlCharTable)
+// against the state machine and the character maps they are derived from.
+// On a mismatch the expected transition table or token run delimiter table is printed to stdout.
+
+using namespace textwolf;
+
+typedef XMLScannerTables<> Tables;
+
+static unsigned char expectedTransition( ScannerStatemachine::Element* sd, unsigned int ch)
+{
+	if (ch >= NofControlCharacter) return 0;
+	if (sd->next[ ch] != -1) return (unsigned char)sd->next[ ch];
+	if (sd->fallbackState != -1) return (unsigned char)(Tables::FallbackTransition + sd->fallbackState);
+	if (sd->missError != -1) return (unsigned char)(Tables::ErrorTransition + sd->missError);
+	if (ch == EndOfText) return (unsigned char)(Tables::ErrorTransition + XMLScannerBase::ErrUnexpectedEndOfText);
+	return (unsigned char)(Tables::ErrorTransition + XMLScannerBase::ErrInternal);
+}
+
+static void printTransitionTable( XMLScannerBase::Statemachine& stm)
+{
+	for (int ss=0; ss<Tables::NofStates; ++ss)
+	{
+		printf( "\t\t{");
+		for (unsigned int ch=0; ch<Tables::RowSize; ++ch)
+		{
+			printf( "%s%u", ch?",":"", (unsigned int)expectedTransition( stm.get( ss), ch));
+		}
+		printf( "}%s\t// %s\n", (ss+1<Tables::NofStates)?",":"", XMLScannerBase::getStateString( (XMLScannerBase::STMState)ss));
+	}
+}
+
+static bool equalRunSet( const ByteScanTable& aa, const ByteScanTable& bb)
+{
+	for (unsigned int ii=0; ii<8; ++ii) if (aa.map[ ii] != bb.map[ ii]) return false;
+	for (unsigned int ii=0; ii<ByteScanTable::MaxNofVectorChars; ++ii) if (aa.chr[ ii] != bb.chr[ ii]) return false;
+	return aa.nofchr == bb.nofchr && aa.low == bb.low && aa.high == bb.high && aa.vectorize == bb.vectorize;
+}
+
+static void printTokenRunTable()
+{
+	for (unsigned int aa=0; aa<XMLScannerBase::NofSTMActions; ++aa)
+	{
+		XMLScannerBase::TokenRunSet set( Tables::tokenChar[ aa]);
+		printf( "\t{{");
+		for (unsigned int ii=0; ii<8; ++ii) printf( "%s0x%08X", ii?",":"", set.map[ ii]);
+		printf( "},{");
+		for (unsigned int ii=0; ii<ByteScanTable::MaxNofVectorChars; ++ii) printf( "%s%u", ii?",":"", (unsigned int)set.chr[ ii]);
+		printf( "},%u,%u,%u,%u}%s\t// %s\n", set.nofchr, (unsigned int)set.low, (unsigned int)set.high, (unsigned int)set.vectorize,
+			(aa+1<XMLScannerBase::NofSTMActions)?",":"", XMLScannerBase::getActionString( (XMLScannerBase::STMAction)aa));
+	}
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	XMLScannerBase::Statemachine stm;
+
+	for (int ss=0; ss<Tables::NofStates; ++ss)
+	{
+		ScannerStatemachine::Element* sd = stm.get( ss);
+		for (unsigned int ch=0; ch<Tables::RowSize; ++ch)
+		{
+			if (Tables::transition[ ss][ ch] != expectedTransition( sd, ch))
+			{
+				std::cerr << "transition of state " << XMLScannerBase::getStateString( (XMLScannerBase::STMState)ss) << " on " << ch << " differs" << std::endl;
+				++errors;
+			}
+		}
+		const Tables::StateDef& st = Tables::state[ ss];
+		int returnState = (sd->action.op != -1 && sd->nofnext == 0)?((sd->fallbackState != -1)?sd->fallbackState:ss):Tables::NoReturn;
+		if (st.actionOp != sd->action.op || (sd->action.op != -1 && st.actionArg != sd->action.arg) || st.returnState != returnState)
+		{
+			std::cerr << "action of state " << XMLScannerBase::getStateString( (XMLScannerBase::STMState)ss) << " differs" << std::endl;
+			++errors;
+		}
+	}
+	if (errors)
+	{
+		printTransitionTable( stm);
+	}
+
+	XMLScannerBase::IsWordCharMap wordC;
+	XMLScannerBase::IsContentCharMap contentC;
+	XMLScannerBase::IsTagCharMap tagC;
+	XMLScannerBase::IsSQStringCharMap sqC;
+	XMLScannerBase::IsDQStringCharMap dqC;
+	const XMLScannerBase::IsTokenCharMap* tokenDefs[ XMLScannerBase::NofSTMActions] = {0,&wordC,&contentC,&tagC,&sqC,&dqC,0,0,0};
+	for (unsigned int aa=0; aa<XMLScannerBase::NofSTMActions; ++aa)
+	{
+		for (unsigned int ch=0; ch<NofControlCharacter; ++ch)
+		{
+			bool expected = tokenDefs[ aa]?(*tokenDefs[ aa])[ (unsigned char)ch]:false;
+			if (Tables::tokenChar[ aa][ ch] != expected)
+			{
+				std::cerr << "token character set of action " << XMLScannerBase::getActionString( (XMLScannerBase::STMAction)aa) << " differs" << std::endl;
+				++errors;
+			}
+		}
+	}
+
+	bool tokenRunErrors = false;
+	for (unsigned int aa=0; aa<XMLScannerBase::NofSTMActions; ++aa)
+	{
+		if (!equalRunSet( Tables::tokenRun[ aa], XMLScannerBase::TokenRunSet( Tables::tokenChar[ aa])))
+		{
+			std::cerr << "token run delimiter set of action " << XMLScannerBase::getActionString( (XMLScannerBase::STMAction)aa) << " differs" << std::endl;
+			tokenRunErrors = true;
+			++errors;
+		}
+	}
+	if (tokenRunErrors)
+	{
+		printTokenRunTable();
+	}
+
+	TextScanner<char*,charset::UTF8>::ControlCharMap controlCharMap;
+	for (unsigned int ii=0; ii<256; ++ii)
+	{
+		if (ControlCharTable<>::ar[ ii] != controlCharMap[ (unsigned char)ii])
+		{
+			std::cerr << "control character table differs at " << ii << std::endl;
+			++errors;
+		}
+	}
+
+	for (unsigned int ii=0; ii<256; ++ii)
+	{
+		unsigned int expected = (ii >= '0' && ii <= '9')?(ii - '0'):(ii >= 'A' && ii <= 'F')?(ii - 'A' + 10):(ii >= 'a' && ii <= 'f')?(ii - 'a' + 10):0xFF;
+		if (Tables::hexDigit[ ii] != expected)
+		{
+			std::cerr << "hexadecimal digit table differs at " << ii << std::endl;
+			++errors;
+		}
+	}
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}
@@ -0,0 +1,205 @@
+#include "textwolf.hpp"
+#include <iostream>
+#include <string>
+#include <cstring>
+
+//build gcc
+//compile: g++ -c -o test_XMLStructuralScanner.o -g -I../include/ -pedantic -Wall -O4 test_XMLStructuralScanner.cpp
+//link: g++ -lc -o test_XMLStructuralScanner test_XMLStructuralScanner.o
+//build windows
+//compile: cl.exe /wd4996 /Ob2 /O2 /EHsc /MT /W4 /nologo /I..\include /D "WIN32" /D "_WINDOWS" /Fo"test_XMLStructuralScanner.obj" test_XMLStructuralScanner.cpp
+//link: link.exe /out:.\test_XMLStructuralScanner test_XMLStructuralScanner.obj
+
+// Checks that the XMLStructuralScanner returns the same elements as the XMLScanner on the documents of the other tests,
+// on documents with the parts scanned by the XMLScanner instead of along the index (header, comments with quotes and markup,
+// CDATA, processing instructions, DTD declarations, entities, carriage returns, errors, incomplete and invalid UTF-8)
+// and on long documents built of these parts crossing the windows of the index, also with elements masked out.
+// Checks that documents without such parts are scanned along the index.
+
+using namespace textwolf;
+
+// Test documents in UTF-8
+static const char* testDocuments[] =
+{
+	"<?xml charset=isolatin-1?>\r\n<note id=1 t=2 g=\"zu\"><stag value='500'/> \n<to>Frog</to>\n<from>Bird</from><body>Hello world!</body>\n</note>",
+	"<?xml version='1.0' encoding='UTF-8'?>\r\n<!-- \xC3\xA4 comment -->\r\n<d\xC3\xA4 a='x&amp;y&#x20AC;' b=\"\xE2\x82\xAC\xF0\x90\x80\x80\">\xC3\xA4&lt;&#65;&gt;\r\n\r<![CDATA[<\xE2\x82\xAC>]]><e/><f g='&quot;&apos;'/>\xF0\x90\x80\x80</d\xC3\xA4>",
+	"<doc>&amp;&#x10000;&#1234;&unknown;</doc>",
+	"<doc a=>error</doc>",
+	"<doc>incomplete \xE2\x82\xAC",
+	"<?xml version='1.0'?>\n<!-- comment -->\r\n<doc a='x&amp;y' b=\"\xC3\xA4\xE2\x82\xAC\">text \xC3\xA4\r\nline&#x20AC;&lt;<![CDATA[<raw>]]><e/>\xF0\x90\x80\x80 tail</doc>",
+	"<doc><item id='1'>first</item><item id='2'>second\r\rthird</item><empty/></doc>",
+	"<doc a=\"\xE2\x82\xAC\xE2\x82\xAC\xE2\x82\xAC\">&#65;&quot;&unknown;</doc>",
+	"<doc>incomplete \xE2\x82",
+	"<a>error <</a>",
+	"<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<!DOCTYPE doc SYSTEM \"doc.dtd\">\n<doc lang=\"de\" title='M\xc3\xbcller &amp; S\xc3\xb6hne'><!-- it's a comment with <markup> and 'quotes' --><n>don't \"quote\" me</n></doc>",
+	"<doc><!-- \"unbalanced --><a b='1'>x</a><?pi 'unbalanced?><c d=\"2\"/></doc>",
+	"<doc><a/ ><b / ><c x='1'/></doc>",
+	"<doc\r\n a='1'\r\n\tb=\"2\"\r\n>\r\n<e\tf = 'g' />line\r\nnext</doc>",
+	"<doc><a b='x' c>d</a></doc>",
+	"<doc><a b='<'/></doc>",
+	"<doc><a b='x'c='y'/></doc>",
+	"<><doc></doc >",
+	"<doc><a b='unterminated",
+	"<doc><a>unterminated",
+	"<doc>text</doc>trailing text",
+	"<doc>\xC3<a/>\xE2\x82<b/></doc>",
+	"<doc a='\xC3'/>",
+	"<doc>\x80\xBF lone continuation bytes</doc>",
+	"<doc a='1'><![CDATA[ ' \" ]]><b c='2'>x</b></doc>",
+	"<doc>&#x3C;a&#62;</doc>",
+	"<doc>a</doc>x&amp;y",
+	"<doc>a</doc>x\r\ny",
+	"",
+	0
+};
+
+// Parts of long documents, the first ones need no XMLScanner
+static const char* testParts[] =
+{
+	"<item id='1' name=\"first\">first item</item>\n",
+	"<p class=\"long\">Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore et dolore magna aliqua.</p>\n",
+	"<e a='x > y' b=\"z/>\" c='\"' d=\"'\"/>",
+	"<w>Zwei Stra\xc3\x9f" "en, ein Weg: \xe2\x82\xac 12,50 \xF0\x90\x80\x80</w>",
+	"<!-- a comment with <markup> and it's 'quotes' -->",
+	"<![CDATA[ <not> a tag & <no/> entity ' ]]>",
+	"<n>don't \"quote\" me &lt;n&gt;</n>",
+	"<?pi <with> 'markup?>",
+	"<TT><AA><BB>10</BB></AA></TT>\r\n",
+	"<a/ >",
+	0
+};
+enum {NofPlainParts=4,NofParts=10};
+
+static std::string buildDocument( unsigned int nofParts, unsigned int nofPartKinds, unsigned int seed, const char* trailer)
+{
+	std::string rt( "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n<doc lang=\"de\">");
+	unsigned int rnd = seed;
+	for (unsigned int ii=0; ii<nofParts; ++ii)
+	{
+		rnd = rnd * 1103515245 + 12345;
+		rt.append( testParts[ (rnd >> 16) % nofPartKinds]);
+	}
+	rt.append( trailer);
+	return rt;
+}
+
+static void appendItem( std::string& rt, XMLScannerBase::ElementType type, const char* ptr, std::size_t size, unsigned short mask)
+{
+	rt.append( XMLScannerBase::getElementTypeName( type));
+	// ... the value of an error is what the scanner parsed before, it is not defined
+	if ((mask & (1 << type)) != 0 && type != XMLScannerBase::ErrorOccurred)
+	{
+		rt.append( " ");
+		rt.append( ptr, size);
+	}
+	rt.append( "\n");
+}
+
+static std::string scanReference( const std::string& doc, unsigned short mask)
+{
+	XMLScanner<SrcIterator,charset::UTF8,charset::UTF8,std::string> scanner( SrcIterator( doc.c_str(), doc.size()));
+	std::string rt;
+	for (unsigned int ii=0; ii<3*doc.size()+8; ++ii)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem( mask);
+		appendItem( rt, type, scanner.getItemPtr(), scanner.getItemSize(), mask);
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred)
+		{
+			const char* err = 0;
+			if (type == XMLScannerBase::ErrorOccurred) scanner.getError( &err);
+			if (err) rt.append( err);
+			break;
+		}
+	}
+	return rt;
+}
+
+static std::string scanStructural( const std::string& doc, unsigned short mask, std::size_t& nofItems, std::size_t& nofScannerItems)
+{
+	XMLStructuralScanner<std::string> scanner( doc.c_str(), doc.size());
+	std::string rt;
+	nofItems = 0;
+	for (unsigned int ii=0; ii<3*doc.size()+8; ++ii)
+	{
+		XMLScannerBase::ElementType type = scanner.nextItem( mask);
+		appendItem( rt, type, scanner.getItemPtr(), scanner.getItemSize(), mask);
+		++nofItems;
+		if (type == XMLScannerBase::Exit || type == XMLScannerBase::ErrorOccurred)
+		{
+			const char* err = 0;
+			if (type == XMLScannerBase::ErrorOccurred) scanner.getError( &err);
+			if (err) rt.append( err);
+			break;
+		}
+	}
+	nofScannerItems = scanner.nofScannerItems();
+	return rt;
+}
+
+static unsigned int test( const char* what, const std::string& doc)
+{
+	static const unsigned short masks[] = {0xFFFF, (unsigned short)~((1<<XMLScannerBase::Content)|(1<<XMLScannerBase::TagAttribValue)), (unsigned short)((1<<XMLScannerBase::OpenTag)|(1<<XMLScannerBase::CloseTag))};
+	unsigned int errors = 0;
+	for (unsigned int mi=0; mi<sizeof(masks)/sizeof(masks[0]); ++mi)
+	{
+		std::size_t nofItems;
+		std::size_t nofScannerItems;
+		std::string expected = scanReference( doc, masks[ mi]);
+		std::string result = scanStructural( doc, masks[ mi], nofItems, nofScannerItems);
+		if (result != expected)
+		{
+			std::cerr << "elements of " << what << " with mask " << std::hex << masks[ mi] << std::dec << " differ:" << std::endl << result << "expected:" << std::endl << expected << std::endl;
+			++errors;
+		}
+	}
+	return errors;
+}
+
+/// \brief Check that a document without parts needing the XMLScanner is scanned along the index
+static unsigned int testIndexed( const char* what, const std::string& doc)
+{
+	std::size_t nofItems;
+	std::size_t nofScannerItems;
+	scanStructural( doc, 0xFFFF, nofItems, nofScannerItems);
+	// ... the XMLScanner scans the header and the first tag only
+	if (nofScannerItems > 8)
+	{
+		std::cerr << what << ": " << nofScannerItems << " of " << nofItems << " elements not scanned along the index" << std::endl;
+		return 1;
+	}
+	return 0;
+}
+
+int main( int, const char**)
+{
+	unsigned int errors = 0;
+	for (unsigned int di=0; testDocuments[ di]; ++di)
+	{
+		std::string what = std::string( "document ") + (char)('A' + di);
+		errors += test( what.c_str(), testDocuments[ di]);
+	}
+	// ... a null byte in the document is the end of text for the XMLScanner
+	errors += test( "document with null byte in content", std::string( "<doc>a\0b</doc>", 14));
+	errors += test( "document with null byte in tag", std::string( "<doc a\0='1'>b</doc>", 19));
+
+	static const char* trailers[] = {"</doc>", "</doc", "<doc a='", "", "<a>\xC3<b/>", 0};
+	for (unsigned int ti=0; trailers[ ti]; ++ti)
+	{
+		for (unsigned int seed=1; seed<=3; ++seed)
+		{
+			std::string what = std::string( "long document with trailer '") + trailers[ ti] + "'";
+			errors += test( what.c_str(), buildDocument( 3000, NofParts, seed, trailers[ ti]));
+			errors += test( (what + " and plain parts").c_str(), buildDocument( 3000, NofPlainParts, seed, trailers[ ti]));
+		}
+	}
+	errors += testIndexed( "long document with plain parts", buildDocument( 5000, NofPlainParts, 1, "</doc>"));
+	errors += testIndexed( "document with plain parts", testDocuments[ 6]);
+
+	if (errors)
+	{
+		std::cerr << errors << " errors" << std::endl;
+		return 1;
+	}
+	std::cerr << "OK" << std::endl;
+	return 0;
+}